@@ -187,12 +187,11 @@ I*w^2 = J
 
 #include <boost/units/cmath.hpp>
 #include <boost/units/io.hpp>
+#include <boost/units/measurement.hpp>
 #include <boost/units/systems/si.hpp>
 #include <boost/units/systems/si/codata/physico-chemical_constants.hpp>
 #include <boost/units/systems/si/io.hpp>
 
-#include "measurement.hpp"
-
 namespace boost {
 
 namespace units {
@@ -0,0 +1,276 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_ATOMIC_QUANTITY_HPP
+#define BOOST_UNITS_ATOMIC_QUANTITY_HPP
+
+///
+/// \file
+/// \brief Quantities that can be updated concurrently.
+/// \details @c atomic_quantity wraps a @c std::atomic of the value type
+///   and checks units as @c quantity does.  @c sharded_atomic_quantity
+///   spreads additions over several cache lines for counters updated by
+///   many threads at once.  Both require the C++11 @c <atomic> header.
+///
+
+#include <boost/config.hpp>
+
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+
+#include <atomic>
+#include <cstddef>
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/units/operators.hpp>
+#include <boost/units/quantity.hpp>
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+/// Integers have native atomic addition.
+template<class Y, bool IsFloat = boost::is_floating_point<Y>::value>
+struct atomic_arithmetic
+{
+    static Y fetch_add(std::atomic<Y>& a, const Y& x, std::memory_order order) { return a.fetch_add(x, order); }
+    static Y fetch_sub(std::atomic<Y>& a, const Y& x, std::memory_order order) { return a.fetch_sub(x, order); }
+};
+
+/// Floating point values are added with a compare-and-swap loop.
+template<class Y>
+struct atomic_arithmetic<Y, true>
+{
+    static Y fetch_add(std::atomic<Y>& a, const Y& x, std::memory_order order)
+    {
+        Y expected = a.load(std::memory_order_relaxed);
+        while(!a.compare_exchange_weak(expected, expected + x, order, std::memory_order_relaxed)) { }
+        return expected;
+    }
+
+    static Y fetch_sub(std::atomic<Y>& a, const Y& x, std::memory_order order)
+    {
+        Y expected = a.load(std::memory_order_relaxed);
+        while(!a.compare_exchange_weak(expected, expected - x, order, std::memory_order_relaxed)) { }
+        return expected;
+    }
+};
+
+} // namespace detail
+
+/// \brief A quantity of @c Unit that can be read and updated atomically.
+/// \details Like @c std::atomic it can be neither copied nor assigned
+/// from another @c atomic_quantity.  Adding or subtracting a quantity
+/// of another unit is a compile-time error, as for @c quantity.
+template<class Unit, class Y = double>
+class atomic_quantity
+{
+    public:
+        typedef quantity<Unit, Y>   value_type;
+        typedef Unit                unit_type;
+
+        /// zero
+        atomic_quantity() BOOST_NOEXCEPT : val_(Y()) { }
+        atomic_quantity(const value_type& q) BOOST_NOEXCEPT : val_(q.value()) { }
+
+        atomic_quantity(const atomic_quantity&) = delete;
+        atomic_quantity& operator=(const atomic_quantity&) = delete;
+
+        bool is_lock_free() const BOOST_NOEXCEPT { return val_.is_lock_free(); }
+
+        value_type load(std::memory_order order = std::memory_order_seq_cst) const BOOST_NOEXCEPT
+        {
+            return value_type::from_value(val_.load(order));
+        }
+
+        void store(const value_type& q, std::memory_order order = std::memory_order_seq_cst) BOOST_NOEXCEPT
+        {
+            val_.store(q.value(), order);
+        }
+
+        operator value_type() const BOOST_NOEXCEPT { return load(); }
+
+        atomic_quantity& operator=(const value_type& q) BOOST_NOEXCEPT
+        {
+            store(q);
+            return *this;
+        }
+
+        /// Replaces the quantity, returning the previous one.
+        value_type exchange(const value_type& q, std::memory_order order = std::memory_order_seq_cst) BOOST_NOEXCEPT
+        {
+            return value_type::from_value(val_.exchange(q.value(), order));
+        }
+
+        bool compare_exchange_weak(value_type& expected, const value_type& desired,
+                                   std::memory_order order = std::memory_order_seq_cst) BOOST_NOEXCEPT
+        {
+            Y e = expected.value();
+            const bool result = val_.compare_exchange_weak(e, desired.value(), order);
+            expected = value_type::from_value(e);
+            return result;
+        }
+
+        bool compare_exchange_strong(value_type& expected, const value_type& desired,
+                                     std::memory_order order = std::memory_order_seq_cst) BOOST_NOEXCEPT
+        {
+            Y e = expected.value();
+            const bool result = val_.compare_exchange_strong(e, desired.value(), order);
+            expected = value_type::from_value(e);
+            return result;
+        }
+
+        /// Adds @c q, returning the previous quantity.
+        template<class Unit2, class YY>
+        value_type fetch_add(const quantity<Unit2, YY>& q, std::memory_order order = std::memory_order_seq_cst) BOOST_NOEXCEPT
+        {
+            BOOST_STATIC_ASSERT((boost::is_same<typename add_typeof_helper<Unit, Unit2>::type, Unit>::value));
+            return value_type::from_value(detail::atomic_arithmetic<Y>::fetch_add(val_, static_cast<Y>(q.value()), order));
+        }
+
+        /// Subtracts @c q, returning the previous quantity.
+        template<class Unit2, class YY>
+        value_type fetch_sub(const quantity<Unit2, YY>& q, std::memory_order order = std::memory_order_seq_cst) BOOST_NOEXCEPT
+        {
+            BOOST_STATIC_ASSERT((boost::is_same<typename subtract_typeof_helper<Unit, Unit2>::type, Unit>::value));
+            return value_type::from_value(detail::atomic_arithmetic<Y>::fetch_sub(val_, static_cast<Y>(q.value()), order));
+        }
+
+        /// Adds @c q, returning the new quantity.
+        template<class Unit2, class YY>
+        value_type operator+=(const quantity<Unit2, YY>& q) BOOST_NOEXCEPT
+        {
+            return value_type::from_value(fetch_add(q).value() + static_cast<Y>(q.value()));
+        }
+
+        /// Subtracts @c q, returning the new quantity.
+        template<class Unit2, class YY>
+        value_type operator-=(const quantity<Unit2, YY>& q) BOOST_NOEXCEPT
+        {
+            return value_type::from_value(fetch_sub(q).value() - static_cast<Y>(q.value()));
+        }
+
+    private:
+        std::atomic<Y>  val_;
+};
+
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+
+namespace detail {
+
+/// The size of the cache line that shards are padded to.
+const std::size_t atomic_shard_alignment = 64;
+
+/// A number assigned to each thread in the order they first ask.
+inline unsigned atomic_shard_thread_index()
+{
+    static std::atomic<unsigned> next(0);
+    thread_local const unsigned index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+} // namespace detail
+
+/// \brief A counter of @c Unit that many threads add to concurrently.
+/// \details Each thread adds to one of @c Shards atomics, each on its
+/// own cache line, so threads rarely contend.  @c load adds up the
+/// shards; while other threads are adding, it reflects each of their
+/// additions either completely or not at all, but is not a snapshot of
+/// a single instant.
+template<class Unit, class Y = double, std::size_t Shards = 16>
+class sharded_atomic_quantity
+{
+    public:
+        typedef quantity<Unit, Y>   value_type;
+        typedef Unit                unit_type;
+
+        BOOST_STATIC_CONSTANT(std::size_t, shards = Shards);
+
+        /// zero
+        sharded_atomic_quantity() BOOST_NOEXCEPT
+        {
+            for(std::size_t i = 0; i < Shards; ++i)
+                shards_[i].value.store(Y(), std::memory_order_relaxed);
+        }
+
+        sharded_atomic_quantity(const sharded_atomic_quantity&) = delete;
+        sharded_atomic_quantity& operator=(const sharded_atomic_quantity&) = delete;
+
+        /// Adds @c q to the shard of the calling thread.
+        template<class Unit2, class YY>
+        void add(const quantity<Unit2, YY>& q, std::memory_order order = std::memory_order_relaxed) BOOST_NOEXCEPT
+        {
+            BOOST_STATIC_ASSERT((boost::is_same<typename add_typeof_helper<Unit, Unit2>::type, Unit>::value));
+            detail::atomic_arithmetic<Y>::fetch_add(shard().value, static_cast<Y>(q.value()), order);
+        }
+
+        /// Subtracts @c q from the shard of the calling thread.
+        template<class Unit2, class YY>
+        void subtract(const quantity<Unit2, YY>& q, std::memory_order order = std::memory_order_relaxed) BOOST_NOEXCEPT
+        {
+            BOOST_STATIC_ASSERT((boost::is_same<typename subtract_typeof_helper<Unit, Unit2>::type, Unit>::value));
+            detail::atomic_arithmetic<Y>::fetch_sub(shard().value, static_cast<Y>(q.value()), order);
+        }
+
+        template<class Unit2, class YY>
+        sharded_atomic_quantity& operator+=(const quantity<Unit2, YY>& q) BOOST_NOEXCEPT
+        {
+            add(q);
+            return *this;
+        }
+
+        template<class Unit2, class YY>
+        sharded_atomic_quantity& operator-=(const quantity<Unit2, YY>& q) BOOST_NOEXCEPT
+        {
+            subtract(q);
+            return *this;
+        }
+
+        /// the sum of the shards
+        value_type load(std::memory_order order = std::memory_order_seq_cst) const BOOST_NOEXCEPT
+        {
+            Y result = Y();
+            for(std::size_t i = 0; i < Shards; ++i)
+                result += shards_[i].value.load(order);
+            return value_type::from_value(result);
+        }
+
+        operator value_type() const BOOST_NOEXCEPT { return load(); }
+
+        /// Sets every shard to zero, returning the previous sum.
+        value_type reset(std::memory_order order = std::memory_order_seq_cst) BOOST_NOEXCEPT
+        {
+            Y result = Y();
+            for(std::size_t i = 0; i < Shards; ++i)
+                result += shards_[i].value.exchange(Y(), order);
+            return value_type::from_value(result);
+        }
+
+    private:
+        struct alignas(detail::atomic_shard_alignment) shard_type
+        {
+            std::atomic<Y> value;
+        };
+
+        shard_type& shard() BOOST_NOEXCEPT { return shards_[detail::atomic_shard_thread_index() % Shards]; }
+
+        shard_type shards_[Shards];
+};
+
+#endif // BOOST_NO_CXX11_THREAD_LOCAL
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_NO_CXX11_HDR_ATOMIC
+
+#endif // BOOST_UNITS_ATOMIC_QUANTITY_HPP
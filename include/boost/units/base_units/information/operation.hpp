@@ -0,0 +1,39 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and 
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_BASE_UNITS_INFORMATION_OPERATION_HPP_INCLUDED
+#define BOOST_UNITS_BASE_UNITS_INFORMATION_OPERATION_HPP_INCLUDED
+
+#include <string>
+
+#include <boost/units/config.hpp>
+#include <boost/units/base_unit.hpp>
+#include <boost/units/physical_dimensions/operation.hpp>
+
+namespace boost {
+namespace units {
+namespace information {
+
+struct operation_base_unit : public base_unit<operation_base_unit, operation_dimension, -710>
+{
+    static std::string name()   { return("operation"); }
+    static std::string symbol() { return("op"); }
+};
+
+} // namespace information
+} // namespace units
+} // namespace boost
+
+#if BOOST_UNITS_HAS_BOOST_TYPEOF
+
+#include BOOST_TYPEOF_INCREMENT_REGISTRATION_GROUP()
+
+BOOST_TYPEOF_REGISTER_TYPE(boost::units::information::operation_base_unit)
+
+#endif
+
+#endif // BOOST_UNITS_BASE_UNITS_INFORMATION_OPERATION_HPP_INCLUDED
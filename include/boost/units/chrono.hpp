@@ -0,0 +1,267 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_CHRONO_HPP
+#define BOOST_UNITS_CHRONO_HPP
+
+///
+/// \file
+/// \brief Conversions between quantities of time and @c std::chrono
+///   durations.
+/// \details A unit of time that differs from the second only by factors
+///   of @c scale corresponds to a @c std::ratio, its length in seconds,
+///   and a @c std::chrono::duration with that period.  @c to_duration and
+///   @c to_quantity convert between the two with the factor reduced at
+///   compile time; integral values are converted as @c rescale converts
+///   them, without passing through floating point, and are not changed
+///   at all when the periods agree.  Requires the C++11 @c <chrono> and
+///   @c <ratio> headers.
+///
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_CHRONO) && !defined(BOOST_NO_CXX11_HDR_RATIO)
+
+#include <chrono>
+#include <ratio>
+#include <type_traits>
+
+#include <boost/cstdint.hpp>
+#include <boost/integer_traits.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/units/make_scaled_unit.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/rescale.hpp>
+#include <boost/units/scale.hpp>
+#include <boost/units/static_rational.hpp>
+#include <boost/units/systems/si/time.hpp>
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+/// The exponent of @c N if it is a power of ten.
+template<boost::intmax_t N, bool Divisible = (N > 1 && N % 10 == 0)>
+struct chrono_decimal_exponent
+{
+    BOOST_STATIC_CONSTANT(long, value = 1 + (chrono_decimal_exponent<N / 10>::value));
+    BOOST_STATIC_CONSTANT(bool, is_power = (chrono_decimal_exponent<N / 10>::is_power));
+};
+
+template<boost::intmax_t N>
+struct chrono_decimal_exponent<N, false>
+{
+    BOOST_STATIC_CONSTANT(long, value = 0);
+    BOOST_STATIC_CONSTANT(bool, is_power = (N == 1));
+};
+
+/// @c Unit scaled by <tt>Base^Exponent</tt>, or @c Unit itself if the
+/// factor is one.
+template<class Unit, boost::intmax_t Base, long Exponent, bool Trivial = (Base == 1 || Exponent == 0)>
+struct chrono_scaled_unit
+{
+    BOOST_STATIC_ASSERT_MSG(Base <= boost::integer_traits<long>::const_max, "the period does not fit in a scale");
+    typedef typename make_scaled_unit<Unit, scale<static_cast<long>(Base), static_rational<Exponent> > >::type type;
+};
+
+template<class Unit, boost::intmax_t Base, long Exponent>
+struct chrono_scaled_unit<Unit, Base, Exponent, true>
+{
+    typedef Unit type;
+};
+
+template<class Period,
+         bool Decimal = (chrono_decimal_exponent<Period::num>::is_power && chrono_decimal_exponent<Period::den>::is_power)>
+struct chrono_unit_impl
+{
+    typedef typename chrono_scaled_unit<si::time, 10,
+        chrono_decimal_exponent<Period::num>::value - chrono_decimal_exponent<Period::den>::value>::type type;
+};
+
+template<class Period>
+struct chrono_unit_impl<Period, false>
+{
+    typedef typename chrono_scaled_unit<
+        typename chrono_scaled_unit<si::time, Period::num, 1>::type,
+        Period::den, -1
+    >::type type;
+};
+
+template<class Ratio, class Rounding, class Overflow, class Y, bool Integral = boost::is_integral<Y>::value>
+struct chrono_convert
+{
+    static Y value(const Y& x) { return rescale_value<Ratio::num, Ratio::den, Rounding, Overflow>(x); }
+};
+
+/// Floating point values are multiplied by the factor as
+/// @c std::chrono::duration_cast would; the policies do not apply.
+template<class Ratio, class Rounding, class Overflow, class Y>
+struct chrono_convert<Ratio, Rounding, Overflow, Y, false>
+{
+    static Y value(const Y& x)
+    {
+        if(Ratio::num == 1 && Ratio::den == 1) return x;
+        if(Ratio::den == 1) return x * static_cast<Y>(Ratio::num);
+        if(Ratio::num == 1) return x / static_cast<Y>(Ratio::den);
+        return x * static_cast<Y>(Ratio::num) / static_cast<Y>(Ratio::den);
+    }
+};
+
+/// These are empty unless their argument is a quantity or a duration,
+/// which keeps the overloads of @c to_duration and @c to_quantity apart.
+template<class Quantity>
+struct chrono_duration_of { };
+
+template<class Duration>
+struct chrono_quantity_of { };
+
+template<class Unit, class Duration>
+struct chrono_quantity_in { };
+
+template<class Unit, class Rep, class Period>
+struct chrono_quantity_in<Unit, std::chrono::duration<Rep, Period> >
+{
+    typedef quantity<Unit, Rep> type;
+};
+
+} // namespace detail
+
+/// The length of @c Unit in seconds, as a @c std::ratio.  @c Unit must
+/// be a unit of time that differs from the second only by factors of
+/// @c scale with integral exponents.
+template<class Unit>
+struct chrono_period
+{
+    typedef detail::rescale_fraction<Unit, si::time> fraction;
+    typedef std::ratio<fraction::numerator, fraction::denominator> type;
+};
+
+/// The unit of time whose length in seconds is the @c std::ratio
+/// @c Period: @c si::time scaled by a power of ten, such as
+/// milliseconds, when @c Period is one, and otherwise scaled by its
+/// numerator and denominator.
+template<class Period>
+struct chrono_unit
+{
+    typedef typename detail::chrono_unit_impl<typename Period::type>::type type;
+};
+
+namespace detail {
+
+/// The factor is applied in the common type of the value and the count,
+/// so that a floating point value is not truncated to an integral count
+/// before it is scaled.
+template<class Duration, class Rounding, class Overflow, class Unit, class Y>
+inline Duration chrono_to_duration(const quantity<Unit, Y>& q)
+{
+    typedef typename Duration::rep rep;
+    typedef typename std::common_type<Y, rep>::type common_type;
+    typedef std::ratio_divide<typename chrono_period<Unit>::type, typename Duration::period> ratio;
+    return Duration(static_cast<rep>(chrono_convert<ratio, Rounding, Overflow, common_type>::value(static_cast<common_type>(q.value()))));
+}
+
+template<class Unit, class Rounding, class Overflow, class Rep, class Period>
+inline quantity<Unit, Rep> chrono_to_quantity(const std::chrono::duration<Rep, Period>& d)
+{
+    typedef std::ratio_divide<Period, typename chrono_period<Unit>::type> ratio;
+    return quantity<Unit, Rep>::from_value(chrono_convert<ratio, Rounding, Overflow, Rep>::value(d.count()));
+}
+
+template<class Unit, class Y>
+struct chrono_duration_of<quantity<Unit, Y> >
+{
+    typedef std::chrono::duration<Y, typename chrono_period<Unit>::type> type;
+};
+
+template<class Rep, class Period>
+struct chrono_quantity_of<std::chrono::duration<Rep, Period> >
+{
+    typedef quantity<typename chrono_unit<Period>::type, Rep> type;
+};
+
+} // namespace detail
+
+/// \brief Converts @c q to the @c std::chrono::duration @c Duration.
+/// \details Integral counts are multiplied and divided by integer
+/// constants, rounding as @c Rounding says and checking the
+/// multiplication as @c Overflow says, as for @c rescale.  A floating
+/// point value is scaled first and then truncated to an integral count,
+/// as @c std::chrono::duration_cast does.
+template<class Duration, class Rounding, class Overflow, class Unit, class Y>
+inline Duration to_duration(const quantity<Unit, Y>& q)
+{
+    return detail::chrono_to_duration<Duration, Rounding, Overflow>(q);
+}
+
+/// Converts @c q to @c Duration, rounding as @c Rounding says and without
+/// checking for overflow.
+template<class Duration, class Rounding, class Unit, class Y>
+inline Duration to_duration(const quantity<Unit, Y>& q)
+{
+    return detail::chrono_to_duration<Duration, Rounding, unchecked_overflow>(q);
+}
+
+/// Converts @c q to @c Duration, discarding any remainder as
+/// @c std::chrono::duration_cast does.
+template<class Duration, class Unit, class Y>
+inline Duration to_duration(const quantity<Unit, Y>& q)
+{
+    return detail::chrono_to_duration<Duration, round_toward_zero, unchecked_overflow>(q);
+}
+
+/// The @c std::chrono::duration with the period of the unit of @c q and
+/// the same count.
+template<class Quantity>
+inline typename detail::chrono_duration_of<Quantity>::type to_duration(const Quantity& q)
+{
+    return typename detail::chrono_duration_of<Quantity>::type(q.value());
+}
+
+/// \brief Converts @c d to a quantity of @c Unit.
+/// \details Integral counts are multiplied and divided by integer
+/// constants, rounding as @c Rounding says and checking the
+/// multiplication as @c Overflow says, as for @c rescale.
+template<class Unit, class Rounding, class Overflow, class Rep, class Period>
+inline quantity<Unit, Rep> to_quantity(const std::chrono::duration<Rep, Period>& d)
+{
+    return detail::chrono_to_quantity<Unit, Rounding, Overflow>(d);
+}
+
+/// Converts @c d to a quantity of @c Unit, rounding as @c Rounding says
+/// and without checking for overflow.
+template<class Unit, class Rounding, class Duration>
+inline typename detail::chrono_quantity_in<Unit, Duration>::type to_quantity(const Duration& d)
+{
+    return detail::chrono_to_quantity<Unit, Rounding, unchecked_overflow>(d);
+}
+
+/// Converts @c d to a quantity of @c Unit, discarding any remainder.
+template<class Unit, class Duration>
+inline typename detail::chrono_quantity_in<Unit, Duration>::type to_quantity(const Duration& d)
+{
+    return detail::chrono_to_quantity<Unit, round_toward_zero, unchecked_overflow>(d);
+}
+
+/// The quantity of the unit of time matching the period of @c d, with
+/// the same value as its count.
+template<class Duration>
+inline typename detail::chrono_quantity_of<Duration>::type to_quantity(const Duration& d)
+{
+    return detail::chrono_quantity_of<Duration>::type::from_value(d.count());
+}
+
+} // namespace units
+
+} // namespace boost
+
+#endif // !BOOST_NO_CXX11_HDR_CHRONO && !BOOST_NO_CXX11_HDR_RATIO
+
+#endif // BOOST_UNITS_CHRONO_HPP
@@ -231,8 +231,7 @@ fdim BOOST_PREVENT_MACRO_SUBSTITUTION (const quantity<Unit,Y>& q1,
     return quantity_type::from_value(fdim BOOST_PREVENT_MACRO_SUBSTITUTION (q1.value(),q2.value()));
 }
 
-#if 0
-
+/// fused multiply-add, q1*q2+q3, where q3 must have the units of q1*q2
 template<class Unit1,class Unit2,class Unit3,class Y>
 inline 
 BOOST_CONSTEXPR
@@ -244,7 +243,11 @@ fma BOOST_PREVENT_MACRO_SUBSTITUTION (const quantity<Unit1,Y>& q1,
                                       const quantity<Unit2,Y>& q2,
                                       const quantity<Unit3,Y>& q3)
 {
+#ifdef BOOST_UNITS_HAS_STD_FMA
+    using std::fma;
+#else
     using namespace detail;
+#endif
 
     typedef quantity<Unit1,Y>   type1;
     typedef quantity<Unit2,Y>   type2;
@@ -256,8 +259,6 @@ fma BOOST_PREVENT_MACRO_SUBSTITUTION (const quantity<Unit1,Y>& q1,
     return quantity_type::from_value(fma BOOST_PREVENT_MACRO_SUBSTITUTION (q1.value(),q2.value(),q3.value()));
 }
 
-#endif
-
 template<class Unit,class Y>
 inline 
 BOOST_CONSTEXPR
@@ -0,0 +1,300 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_CMATH_ARRAY_HPP
+#define BOOST_UNITS_CMATH_ARRAY_HPP
+
+///
+/// \file
+/// \brief Overloads of functions in \<cmath\> for arrays of quantities.
+/// \details Each function applies the overload of cmath.hpp with the
+///   same name to every element of [first, last) and writes the results
+///   to @c out, returning the end of the output.  The output must have
+///   the unit and value type the scalar function returns.  @c sqrt and
+///   @c hypot also take @c quantity_span arguments and then work on the
+///   raw values; for @c double spans @c sqrt uses AVX or SSE2 and
+///   @c hypot uses SSE2 where the compiler targets them, unless
+///   @c BOOST_UNITS_NO_SIMD is defined, and neither sets @c errno.
+///   Everything else, including @c atan2 and the pointer overloads of
+///   @c sqrt and @c hypot, is a scalar loop.
+///
+
+#include <cstddef>
+#include <limits>
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/config/no_tr1/cmath.hpp>
+#include <boost/math/special_functions/hypot.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_const.hpp>
+
+#include <boost/units/cmath.hpp>
+#include <boost/units/operators.hpp>
+#include <boost/units/pow.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/quantity_array.hpp>
+#include <boost/units/static_rational.hpp>
+
+#ifndef BOOST_UNITS_NO_SIMD
+    #if defined(__AVX__)
+        /// INTERNAL ONLY
+        #define BOOST_UNITS_HAS_AVX
+    #endif
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        /// INTERNAL ONLY
+        #define BOOST_UNITS_HAS_SSE2
+    #endif
+#endif
+
+#if defined(BOOST_UNITS_HAS_AVX)
+#include <immintrin.h>
+#elif defined(BOOST_UNITS_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+template<class Y, class R>
+inline void array_sqrt(const Y* in, R* out, std::size_t n)
+{
+    using std::sqrt;
+    for(std::size_t i = 0; i < n; ++i)
+        out[i] = sqrt(in[i]);
+}
+
+template<class Y>
+inline void array_hypot(const Y* in1, const Y* in2, Y* out, std::size_t n)
+{
+    using boost::math::hypot;
+    for(std::size_t i = 0; i < n; ++i)
+        out[i] = hypot BOOST_PREVENT_MACRO_SUBSTITUTION (in1[i], in2[i]);
+}
+
+#ifdef BOOST_UNITS_HAS_SSE2
+
+inline void array_sqrt(const double* in, double* out, std::size_t n)
+{
+    std::size_t i = 0;
+#ifdef BOOST_UNITS_HAS_AVX
+    for(; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_loadu_pd(in + i)));
+#endif
+    for(; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out + i, _mm_sqrt_pd(_mm_loadu_pd(in + i)));
+    for(; i < n; ++i)
+        out[i] = std::sqrt(in[i]);
+}
+
+/// hypot(x, y) = m sqrt(1 + (s / m)^2) with m the larger and s the
+/// smaller magnitude, which neither overflows nor underflows.  Pairs
+/// with an infinity or a NaN are left to the scalar function.
+inline void array_hypot(const double* in1, const double* in2, double* out, std::size_t n)
+{
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d infinity = _mm_set1_pd(std::numeric_limits<double>::infinity());
+    std::size_t i = 0;
+    for(; i + 2 <= n; i += 2)
+    {
+        const __m128d x = _mm_loadu_pd(in1 + i);
+        const __m128d y = _mm_loadu_pd(in2 + i);
+        const __m128d a = _mm_andnot_pd(sign, x);
+        const __m128d b = _mm_andnot_pd(sign, y);
+        const __m128d m = _mm_max_pd(a, b);
+        const __m128d special = _mm_or_pd(_mm_cmpunord_pd(a, b), _mm_cmpeq_pd(m, infinity));
+        if(_mm_movemask_pd(special) == 0)
+        {
+            const __m128d s = _mm_min_pd(a, b);
+            const __m128d r = _mm_div_pd(s, m);
+            const __m128d h = _mm_mul_pd(m, _mm_sqrt_pd(_mm_add_pd(one, _mm_mul_pd(r, r))));
+            _mm_storeu_pd(out + i, _mm_and_pd(h, _mm_cmpneq_pd(m, zero)));
+        }
+        else
+        {
+            // from the loaded values, since out may be one of the inputs
+            double xs[2], ys[2];
+            _mm_storeu_pd(xs, x);
+            _mm_storeu_pd(ys, y);
+            out[i] = boost::math::hypot(xs[0], ys[0]);
+            out[i + 1] = boost::math::hypot(xs[1], ys[1]);
+        }
+    }
+    for(; i < n; ++i)
+        out[i] = boost::math::hypot(in1[i], in2[i]);
+}
+
+#endif // BOOST_UNITS_HAS_SSE2
+
+} // namespace detail
+
+/// @c abs of each quantity in [first, last)
+template<class Unit, class Y>
+inline quantity<Unit, Y>*
+abs(const quantity<Unit, Y>* first, const quantity<Unit, Y>* last, quantity<Unit, Y>* out)
+{
+    for(; first != last; ++first, ++out)
+        *out = units::abs BOOST_PREVENT_MACRO_SUBSTITUTION (*first);
+    return out;
+}
+
+/// @c fabs of each quantity in [first, last)
+template<class Unit, class Y>
+inline quantity<Unit, Y>*
+fabs(const quantity<Unit, Y>* first, const quantity<Unit, Y>* last, quantity<Unit, Y>* out)
+{
+    for(; first != last; ++first, ++out)
+        *out = units::fabs BOOST_PREVENT_MACRO_SUBSTITUTION (*first);
+    return out;
+}
+
+/// @c floor of each quantity in [first, last)
+template<class Unit, class Y>
+inline quantity<Unit, Y>*
+floor(const quantity<Unit, Y>* first, const quantity<Unit, Y>* last, quantity<Unit, Y>* out)
+{
+    for(; first != last; ++first, ++out)
+        *out = units::floor BOOST_PREVENT_MACRO_SUBSTITUTION (*first);
+    return out;
+}
+
+/// @c ceil of each quantity in [first, last)
+template<class Unit, class Y>
+inline quantity<Unit, Y>*
+ceil(const quantity<Unit, Y>* first, const quantity<Unit, Y>* last, quantity<Unit, Y>* out)
+{
+    for(; first != last; ++first, ++out)
+        *out = units::ceil BOOST_PREVENT_MACRO_SUBSTITUTION (*first);
+    return out;
+}
+
+/// @c sqrt of each quantity in [first, last)
+template<class Unit, class Y>
+inline typename root_typeof_helper<quantity<Unit, Y>, static_rational<2> >::type*
+sqrt(const quantity<Unit, Y>* first,
+     const quantity<Unit, Y>* last,
+     typename root_typeof_helper<quantity<Unit, Y>, static_rational<2> >::type* out)
+{
+    for(; first != last; ++first, ++out)
+        *out = units::sqrt BOOST_PREVENT_MACRO_SUBSTITUTION (*first);
+    return out;
+}
+
+/// @c sqrt of each quantity of @c in, written to @c out, which must
+/// have the same size and the unit and value type @c sqrt returns.
+/// @c out may be @c in itself but must not otherwise overlap it.
+template<class Unit, class Y, class ResultUnit, class R>
+inline void sqrt(const quantity_span<Unit, Y>& in, const quantity_span<ResultUnit, R>& out)
+{
+    typedef typename remove_const<Y>::type value_type;
+    BOOST_STATIC_ASSERT_MSG((is_same<
+        quantity<ResultUnit, R>,
+        typename root_typeof_helper<quantity<Unit, value_type>, static_rational<2> >::type
+    >::value), "the output must hold the quantities sqrt returns");
+    BOOST_ASSERT(out.size() == in.size());
+    detail::array_sqrt(in.data(), out.data(), in.size());
+}
+
+/// @c hypot of each pair of quantities in [first1, last1) and the
+/// array starting at @c first2
+template<class Unit, class Y>
+inline quantity<Unit, Y>*
+hypot(const quantity<Unit, Y>* first1,
+      const quantity<Unit, Y>* last1,
+      const quantity<Unit, Y>* first2,
+      quantity<Unit, Y>* out)
+{
+    for(; first1 != last1; ++first1, ++first2, ++out)
+        *out = units::hypot BOOST_PREVENT_MACRO_SUBSTITUTION (*first1, *first2);
+    return out;
+}
+
+/// @c hypot of each pair of quantities of @c in1 and @c in2, written to
+/// @c out.  The spans must have the same size.  @c out may be one of
+/// the inputs but must not otherwise overlap them.
+template<class Unit, class Y1, class Y2, class Y>
+inline void hypot(const quantity_span<Unit, Y1>& in1, const quantity_span<Unit, Y2>& in2, const quantity_span<Unit, Y>& out)
+{
+    BOOST_STATIC_ASSERT_MSG((is_same<typename remove_const<Y1>::type, Y>::value &&
+                             is_same<typename remove_const<Y2>::type, Y>::value),
+        "the inputs and the output must have the same value type");
+    BOOST_ASSERT(in2.size() == in1.size() && out.size() == in1.size());
+    detail::array_hypot(in1.data(), in2.data(), out.data(), in1.size());
+}
+
+/// @c atan2 of each pair of quantities in [first1, last1) and the
+/// array starting at @c first2, as angles in the same system
+template<class Y, class Dimension, class System>
+inline quantity<unit<plane_angle_dimension, homogeneous_system<System> >, Y>*
+atan2(const quantity<unit<Dimension, homogeneous_system<System> >, Y>* first1,
+      const quantity<unit<Dimension, homogeneous_system<System> >, Y>* last1,
+      const quantity<unit<Dimension, homogeneous_system<System> >, Y>* first2,
+      quantity<unit<plane_angle_dimension, homogeneous_system<System> >, Y>* out)
+{
+    for(; first1 != last1; ++first1, ++first2, ++out)
+        *out = units::atan2(*first1, *first2);
+    return out;
+}
+
+/// @c atan2 of each pair of quantities in [first1, last1) and the
+/// array starting at @c first2, as angles in radians
+template<class Y, class Dimension, class System>
+inline quantity<angle::radian_base_unit::unit_type, Y>*
+atan2(const quantity<unit<Dimension, heterogeneous_system<System> >, Y>* first1,
+      const quantity<unit<Dimension, heterogeneous_system<System> >, Y>* last1,
+      const quantity<unit<Dimension, heterogeneous_system<System> >, Y>* first2,
+      quantity<angle::radian_base_unit::unit_type, Y>* out)
+{
+    for(; first1 != last1; ++first1, ++first2, ++out)
+        *out = units::atan2(*first1, *first2);
+    return out;
+}
+
+/// @c fma of each triple of quantities in [first1, last1) and the
+/// arrays starting at @c first2 and @c first3
+template<class Unit1, class Unit2, class Unit3, class Y>
+inline typename add_typeof_helper<
+    typename multiply_typeof_helper<quantity<Unit1, Y>, quantity<Unit2, Y> >::type,
+    quantity<Unit3, Y>
+>::type*
+fma(const quantity<Unit1, Y>* first1,
+    const quantity<Unit1, Y>* last1,
+    const quantity<Unit2, Y>* first2,
+    const quantity<Unit3, Y>* first3,
+    typename add_typeof_helper<
+        typename multiply_typeof_helper<quantity<Unit1, Y>, quantity<Unit2, Y> >::type,
+        quantity<Unit3, Y>
+    >::type* out)
+{
+    for(; first1 != last1; ++first1, ++first2, ++first3, ++out)
+        *out = units::fma BOOST_PREVENT_MACRO_SUBSTITUTION (*first1, *first2, *first3);
+    return out;
+}
+
+/// @c pow<Rat> of each quantity in [first, last)
+template<class Rat, class Unit, class Y>
+inline typename power_typeof_helper<quantity<Unit, Y>, Rat>::type*
+pow(const quantity<Unit, Y>* first,
+    const quantity<Unit, Y>* last,
+    typename power_typeof_helper<quantity<Unit, Y>, Rat>::type* out)
+{
+    for(; first != last; ++first, ++out)
+        *out = units::pow<Rat>(*first);
+    return out;
+}
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_CMATH_ARRAY_HPP
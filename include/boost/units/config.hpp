@@ -45,6 +45,26 @@
     #endif
 #endif
 
+#ifndef BOOST_UNITS_HAS_VARIADIC_LIST
+    #ifndef BOOST_NO_CXX11_VARIADIC_TEMPLATES
+        ///INTERNAL ONLY
+        #define BOOST_UNITS_HAS_VARIADIC_LIST   1
+    #else
+        ///INTERNAL ONLY
+        #define BOOST_UNITS_HAS_VARIADIC_LIST   0
+    #endif
+#endif
+
+#ifndef BOOST_UNITS_HAS_THREADS
+    #ifndef BOOST_NO_CXX11_HDR_THREAD
+        ///INTERNAL ONLY
+        #define BOOST_UNITS_HAS_THREADS         1
+    #else
+        ///INTERNAL ONLY
+        #define BOOST_UNITS_HAS_THREADS         0
+    #endif
+#endif
+
 // uncomment this to test without typeof support at all
 //#undef BOOST_UNITS_HAS_TYPEOF
 //#define BOOST_UNITS_HAS_TYPEOF          0
@@ -88,6 +108,16 @@
 /// compiler is able to handle the library.
 #define BOOST_UNITS_NO_COMPILER_CHECK
 
+/// Set to 0 to sort dimension and system lists with the C++03
+/// cons-list algorithms even when variadic templates are available.
+#define BOOST_UNITS_HAS_VARIADIC_LIST
+
+/// Set to 0 to run the reductions of reduce.hpp on the calling
+/// thread only, even when std::thread is available.  Where
+/// BOOST_NO_CXX11_THREADSAFE_STATICS is defined, it also decides
+/// whether the lazily built unit strings are guarded by a std::mutex.
+#define BOOST_UNITS_HAS_THREADS
+
 /// Enable checking to verify that a homogeneous system
 /// is actually capable of representing all the dimensions
 /// that it is used with.  Off by default.
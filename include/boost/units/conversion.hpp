@@ -171,12 +171,12 @@ BOOST_UNITS_DEFAULT_CONVERSION(namespace_::name_ ## _base_unit, unit)
 template<class FromUnit,class ToUnit>
 inline
 BOOST_CONSTEXPR
-typename one_to_double_type<
-    typename detail::conversion_factor_helper<FromUnit, ToUnit>::type
+typename detail::folded_conversion_factor<
+    detail::conversion_factor_helper<FromUnit, ToUnit>
 >::type
 conversion_factor(const FromUnit&,const ToUnit&)
 {
-    return(one_to_double(detail::conversion_factor_helper<FromUnit, ToUnit>::value()));
+    return(detail::folded_conversion_factor<detail::conversion_factor_helper<FromUnit, ToUnit> >::value());
 }
 
 } // namespace units
@@ -0,0 +1,115 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_CONVERT_HPP
+#define BOOST_UNITS_CONVERT_HPP
+
+///
+/// \file
+/// \brief Unit conversion of contiguous ranges of quantities.
+/// \details The conversion factor (and, for @c absolute units, the
+///   offset) is computed once per call rather than once per element,
+///   leaving a plain multiply-add loop over the raw values that the
+///   compiler is free to vectorize.
+///
+
+#include <cstddef>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_const.hpp>
+
+#include <boost/units/absolute.hpp>
+#include <boost/units/conversion.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/quantity_array.hpp>
+#include <boost/units/units_fwd.hpp>
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+/// linear conversion: only a factor is needed.
+template<class Unit1, class Unit2>
+struct span_conversion
+{
+    typedef typename one_to_double_type<
+        typename conversion_factor_helper<Unit1, Unit2>::type
+    >::type factor_type;
+
+    template<class Y1, class Y2>
+    static void apply(const Y1* in, Y2* out, std::size_t n)
+    {
+        const factor_type factor = conversion_factor(Unit1(), Unit2());
+        for(std::size_t i = 0; i < n; ++i)
+            out[i] = static_cast<Y2>(in[i] * factor);
+    }
+};
+
+/// identical units: the loop is a plain copy.
+template<class Unit>
+struct span_conversion<Unit, Unit>
+{
+    template<class Y1, class Y2>
+    static void apply(const Y1* in, Y2* out, std::size_t n)
+    {
+        for(std::size_t i = 0; i < n; ++i)
+            out[i] = static_cast<Y2>(in[i]);
+    }
+};
+
+/// affine conversion between absolute units: a factor and an offset,
+/// both taken from the same definitions used by @c conversion_helper.
+template<class Unit1, class Unit2>
+struct span_conversion<absolute<Unit1>, absolute<Unit2> >
+{
+    template<class Y1, class Y2>
+    static void apply(const Y1* in, Y2* out, std::size_t n)
+    {
+        typedef quantity<absolute<Unit1>, Y1> from_type;
+        typedef quantity<absolute<Unit2>, Y2> to_type;
+        typedef typename span_conversion<Unit1, Unit2>::factor_type factor_type;
+        const factor_type factor = conversion_factor(Unit1(), Unit2());
+        const Y2 offset = conversion_helper<from_type, to_type>::convert(from_type::from_value(Y1())).value();
+        for(std::size_t i = 0; i < n; ++i)
+            out[i] = static_cast<Y2>(in[i] * factor + offset);
+    }
+};
+
+template<class Unit>
+struct span_conversion<absolute<Unit>, absolute<Unit> > : span_conversion<Unit, Unit> { };
+
+} // namespace detail
+
+/// Convert every element of @c from into the units of @c to.
+/// The spans must have the same size and may alias exactly
+/// (in-place conversion) when the value types match.  Each element
+/// is converted as <tt>quantity<Unit2,Y2>(q)</tt> would be, but the
+/// conversion factor is computed only once.
+template<class Unit1, class Y1, class Unit2, class Y2>
+inline void convert(const quantity_span<Unit1, Y1>& from, const quantity_span<Unit2, Y2>& to)
+{
+    BOOST_STATIC_ASSERT_MSG(!boost::is_const<Y2>::value, "the destination of convert must be mutable");
+    BOOST_ASSERT(from.size() == to.size());
+    detail::span_conversion<Unit1, Unit2>::apply(from.data(), to.data(), from.size());
+}
+
+/// Convert a whole @c quantity_array, resizing the destination as needed.
+template<class Unit1, class Y1, class Alloc1, class Unit2, class Y2, class Alloc2>
+inline void convert(const quantity_array<Unit1, Y1, Alloc1>& from, quantity_array<Unit2, Y2, Alloc2>& to)
+{
+    to.resize(from.size());
+    units::convert(from.span(), to.span());
+}
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_CONVERT_HPP
@@ -14,6 +14,12 @@
 #include <boost/config.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 
+#if !defined(BOOST_UNITS_HAS_STD_FMA) && \
+    ((defined(__cplusplus) && __cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1800))
+    ///INTERNAL ONLY
+    #define BOOST_UNITS_HAS_STD_FMA
+#endif
+
 namespace boost {
 namespace units {
 namespace detail {
@@ -68,20 +74,13 @@ inline Y fdim BOOST_PREVENT_MACRO_SUBSTITUTION(const Y& v1,const Y& v2)
     else return(Y(0));
 }
 
-#if 0
-
-template<class T>
-struct fma_issue_warning {
-    enum { value = false };
-};
+#ifndef BOOST_UNITS_HAS_STD_FMA
 
 template<class Y>
 inline Y fma(const Y& v1,const Y& v2,const Y& v3)
 {
     //this implementation does *not* meet the
     //requirement of infinite intermediate precision
-    BOOST_STATIC_WARNING((fma_issue_warning<Y>::value));
-
     return v1 * v2 + v3;
 }
 
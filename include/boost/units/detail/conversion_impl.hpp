@@ -423,7 +423,7 @@ struct conversion_factor_helper<unit<D, heterogeneous_system<S1> >, unit<D, hete
         from_base_units
     >::type all_base_units;
     /// INTERNAL ONLY
-    typedef typename detail::make_homogeneous_system<all_base_units>::type system;
+    typedef typename detail::make_canonical_homogeneous_system<all_base_units>::type system;
     typedef typename detail::conversion_impl<S1::type::size::value>::template apply<
         typename S1::type,
         system
@@ -443,6 +443,59 @@ struct conversion_factor_helper<unit<D, heterogeneous_system<S1> >, unit<D, hete
     }
 };
 
+#ifndef BOOST_NO_CXX11_CONSTEXPR
+
+/// INTERNAL ONLY
+template<int>
+struct constant_expression_probe { };
+
+/// true when the factor computed by Helper is a constant expression,
+/// i.e. every converter in the chain is @c constexpr and its value
+/// type is a literal type.
+template<class Helper>
+struct is_constant_conversion_factor
+{
+    template<class H>
+    static char check(constant_expression_probe<(static_cast<void>(one_to_double(H::value())), 0)>*);
+    template<class H>
+    static char (&check(...))[2];
+    BOOST_STATIC_CONSTEXPR bool value = (sizeof(check<Helper>(0)) == 1);
+};
+
+#endif
+
+/// Evaluates the factor computed by Helper.  Where possible the whole
+/// chain of converters and scales is folded by the compiler into one
+/// static constant, so even an unoptimized build loads a literal
+/// instead of calling through every step of the chain.
+template<class Helper,
+#ifndef BOOST_NO_CXX11_CONSTEXPR
+    bool Constant = is_constant_conversion_factor<Helper>::value
+#else
+    bool Constant = false
+#endif
+>
+struct folded_conversion_factor
+{
+    typedef typename one_to_double_type<typename Helper::type>::type type;
+    static BOOST_CONSTEXPR type value() { return(one_to_double(Helper::value())); }
+};
+
+#ifndef BOOST_NO_CXX11_CONSTEXPR
+
+template<class Helper>
+struct folded_conversion_factor<Helper, true>
+{
+    typedef typename one_to_double_type<typename Helper::type>::type type;
+    static constexpr type constant = one_to_double(Helper::value());
+    static constexpr type value() { return(constant); }
+};
+
+template<class Helper>
+constexpr typename folded_conversion_factor<Helper, true>::type folded_conversion_factor<Helper, true>::constant;
+
+#endif
+
 } // namespace detail
 
 } // namespace units
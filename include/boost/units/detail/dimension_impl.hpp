@@ -18,6 +18,7 @@
 #include <boost/mpl/next.hpp>
 #include <boost/mpl/size.hpp>
 #include <boost/mpl/less.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 #include <boost/units/config.hpp>
 #include <boost/units/dimensionless_type.hpp>
@@ -26,6 +27,7 @@
 #include <boost/units/detail/dimension_list.hpp>
 #include <boost/units/detail/push_front_if.hpp>
 #include <boost/units/detail/push_front_or_add.hpp>
+#include <boost/units/detail/variadic_list.hpp>
 
 /// \file 
 /// \brief Core class and metaprogramming utilities for compile-time dimensional analysis.
@@ -36,6 +38,8 @@ namespace units {
 
 namespace detail {
 
+#if !BOOST_UNITS_HAS_VARIADIC_LIST
+
 template<int N>
 struct insertion_sort_dims_insert;
 
@@ -134,6 +138,86 @@ struct sort_dims<list<T, Next> >
     typedef typename insertion_sort_dims_impl<list<T, Next>::size::value>::template apply<list<T, Next> >::type type;
 };
 
+#else
+
+/// Appends a dimension to a pack, unless it is the empty result of
+/// combining several dimensions with the same tag.
+template<class Pack, class D, bool Combined>
+struct append_dim;
+
+template<class... Out, class D, bool Combined>
+struct append_dim<type_pack<Out...>, D, Combined> :
+    mpl::if_c<
+        Combined && is_empty_dim<D>::value,
+        type_pack<Out...>,
+        type_pack<Out..., D>
+    >::type { };
+
+/// Adds together neighbouring dimensions of a sorted pack that have
+/// the same tag, as @c push_front_or_add does for the cons lists.
+template<class In, class Out = type_pack<>, bool Combined = false>
+struct combine_dims;
+
+template<bool same_tag>
+struct combine_dims_step;
+
+template<>
+struct combine_dims_step<true>
+{
+    template<class T0, class T1, class Rest, class Out, bool Combined>
+    struct apply;
+
+    template<class T0, class T1, class... T, class Out, bool Combined>
+    struct apply<T0, T1, type_pack<T...>, Out, Combined> :
+        combine_dims<type_pack<typename mpl::plus<T0, T1>::type, T...>, Out, true> { };
+};
+
+template<>
+struct combine_dims_step<false>
+{
+    template<class T0, class T1, class Rest, class Out, bool Combined>
+    struct apply;
+
+    template<class T0, class T1, class... T, class Out, bool Combined>
+    struct apply<T0, T1, type_pack<T...>, Out, Combined> :
+        combine_dims<type_pack<T1, T...>, typename append_dim<Out, T0, Combined>::type, false> { };
+};
+
+template<class Out, bool Combined>
+struct combine_dims<type_pack<>, Out, Combined> : Out { };
+
+template<class T0, class Out, bool Combined>
+struct combine_dims<type_pack<T0>, Out, Combined> :
+    append_dim<Out, T0, Combined> { };
+
+template<class T0, class T1, class... T, class Out, bool Combined>
+struct combine_dims<type_pack<T0, T1, T...>, Out, Combined> :
+    combine_dims_step<
+        boost::is_same<typename T0::tag_type, typename T1::tag_type>::value
+    >::template apply<T0, T1, type_pack<T...>, Out, Combined> { };
+
+template<class Pack>
+struct sort_dims_pack
+{
+    typedef typename pack_to_list<
+        typename combine_dims<typename sort_pack<Pack>::type>::type
+    >::type type;
+};
+
+template<class T>
+struct sort_dims :
+    sort_dims_pack<
+        typename mpl_to_pack_impl<mpl::size<T>::value>::template apply<
+            typename mpl::begin<T>::type
+        >::type
+    > { };
+
+template<class T, class Next>
+struct sort_dims<list<T, Next> > :
+    sort_dims_pack<typename list_to_pack<list<T, Next> >::type> { };
+
+#endif
+
 /// sorted sequences can be merged in linear time
 template<bool less, bool greater>
 struct merge_dimensions_func;
@@ -271,6 +355,8 @@ struct merge_dimensions_impl<0, 0>
     };
 };
 
+#if !BOOST_UNITS_HAS_VARIADIC_LIST
+
 template<int N>
 struct static_inverse_impl
 {
@@ -338,6 +424,54 @@ struct static_root_impl<0> {
     };
 };
 
+#else
+
+// The exponents are transformed by a single pack expansion.
+
+template<class Pack>
+struct static_inverse_pack;
+
+template<class... D>
+struct static_inverse_pack<type_pack<D...> > :
+    pack_to_list<type_pack<typename mpl::negate<D>::type...> > { };
+
+template<class Pack, class Ex>
+struct static_power_pack;
+
+template<class... D, class Ex>
+struct static_power_pack<type_pack<D...>, Ex> :
+    pack_to_list<type_pack<typename mpl::times<D, Ex>::type...> > { };
+
+template<class Pack, class Ex>
+struct static_root_pack;
+
+template<class... D, class Ex>
+struct static_root_pack<type_pack<D...>, Ex> :
+    pack_to_list<type_pack<typename mpl::divides<D, Ex>::type...> > { };
+
+template<int N>
+struct static_inverse_impl
+{
+    template<typename Begin>
+    struct apply : static_inverse_pack<typename list_to_pack<Begin>::type> { };
+};
+
+template<int N>
+struct static_power_impl
+{
+    template<typename Begin, typename Ex>
+    struct apply : static_power_pack<typename list_to_pack<Begin>::type, Ex> { };
+};
+
+template<int N>
+struct static_root_impl
+{
+    template<class Begin, class Ex>
+    struct apply : static_root_pack<typename list_to_pack<Begin>::type, Ex> { };
+};
+
+#endif
+
 } // namespace detail
 
 } // namespace units
@@ -17,6 +17,8 @@
 #include <boost/units/static_rational.hpp>
 #include <boost/units/homogeneous_system.hpp>
 #include <boost/units/detail/linear_algebra.hpp>
+#include <boost/units/detail/push_front_if.hpp>
+#include <boost/units/detail/sort.hpp>
 
 namespace boost {
 
@@ -281,6 +283,46 @@ struct make_homogeneous_system {
     > type;
 };
 
+template<class T, class L>
+struct is_front_of : mpl::false_ {};
+
+template<class T, class Next>
+struct is_front_of<T, list<T, Next> > : mpl::true_ {};
+
+/// removes repeated items from a sorted list.
+template<int N>
+struct unique_sorted_impl {
+    template<class Begin>
+    struct apply {
+        typedef typename unique_sorted_impl<N-1>::template apply<typename Begin::next>::type next;
+        typedef typename push_front_if<!is_front_of<typename Begin::item, next>::value>::template apply<
+            next,
+            typename Begin::item
+        >::type type;
+    };
+};
+
+template<>
+struct unique_sorted_impl<0> {
+    template<class Begin>
+    struct apply {
+        typedef dimensionless_type type;
+    };
+};
+
+/// The homogeneous system used to convert between heterogeneous
+/// systems depends only on the set of base units involved.  Sorting
+/// and deduplicating the list first maps every ordering and repetition
+/// of the same base units to one key, so all the conversions drawing on
+/// them share a single make_homogeneous_system (and linear algebra
+/// solve), and the conversions of each side to that system.
+template<class Units>
+struct make_canonical_homogeneous_system {
+    typedef typename insertion_sort<Units>::type sorted;
+    typedef typename unique_sorted_impl<sorted::size::value>::template apply<sorted>::type key;
+    typedef typename make_homogeneous_system<key>::type type;
+};
+
 template<int N>
 struct extract_base_units {
     template<class Begin, class T>
@@ -46,7 +46,7 @@ struct push_front_or_add_impl<true>
         typedef typename push_front_if<!is_empty_dim<item>::value>::template apply<
             typename Sequence::next,
             item
-        > type;
+        >::type type;
     };
 };
 
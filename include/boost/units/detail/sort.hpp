@@ -18,8 +18,10 @@
 #include <boost/mpl/push_front.hpp>
 #include <boost/mpl/less.hpp>
 
+#include <boost/units/config.hpp>
 #include <boost/units/dimensionless_type.hpp>
 #include <boost/units/detail/dimension_list.hpp>
+#include <boost/units/detail/variadic_list.hpp>
 
 namespace boost {
 
@@ -27,6 +29,20 @@ namespace units {
 
 namespace detail {
 
+#if BOOST_UNITS_HAS_VARIADIC_LIST
+
+/// Sorts a list by @c mpl::less.  The name is kept for the callers;
+/// with variadic templates the list is flattened and merge sorted.
+template<class T>
+struct insertion_sort
+{
+    typedef typename pack_to_list<
+        typename sort_pack<typename list_to_pack<T>::type>::type
+    >::type type;
+};
+
+#else
+
 template<int N>
 struct insertion_sort_insert;
 
@@ -100,6 +116,8 @@ struct insertion_sort
     typedef typename insertion_sort_impl<T::size::value>::template apply<T>::type type;
 };
 
+#endif
+
 } // namespace detail
 
 } // namespace units
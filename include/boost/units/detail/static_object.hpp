@@ -0,0 +1,92 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_DETAIL_STATIC_OBJECT_HPP
+#define BOOST_UNITS_DETAIL_STATIC_OBJECT_HPP
+
+#include <boost/config.hpp>
+#include <boost/units/config.hpp>
+
+#if defined(BOOST_NO_CXX11_THREADSAFE_STATICS) && BOOST_UNITS_HAS_THREADS
+#include <mutex>
+#endif
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+/// A default constructed @c T, built on first use and never freed.
+/// Where function-local statics are not initialized thread-safely,
+/// the object is published through a pointer under a @c std::mutex
+/// instead.  It is built outside the lock, since building it may use
+/// other static objects; a thread that loses the race deletes its copy.
+template<class T>
+struct static_object
+{
+    static const T& get()
+    {
+#ifndef BOOST_NO_CXX11_THREADSAFE_STATICS
+        static const T instance;
+        return instance;
+#else
+        const T* result = load();
+        if(result == 0)
+        {
+            T* built = new T();
+            {
+#if BOOST_UNITS_HAS_THREADS
+                std::lock_guard<std::mutex> lock(mutex_);
+#endif
+                if(instance_ == 0)
+                {
+                    instance_ = built;
+                    built = 0;
+                }
+                result = instance_;
+            }
+            delete built;
+        }
+        return *result;
+#endif
+    }
+
+#ifdef BOOST_NO_CXX11_THREADSAFE_STATICS
+    private:
+        static const T* load()
+        {
+#if BOOST_UNITS_HAS_THREADS
+            std::lock_guard<std::mutex> lock(mutex_);
+#endif
+            return instance_;
+        }
+
+        // both constant initialized; the object is never freed
+        static T* instance_;
+#if BOOST_UNITS_HAS_THREADS
+        static std::mutex mutex_;
+#endif
+#endif
+};
+
+#ifdef BOOST_NO_CXX11_THREADSAFE_STATICS
+template<class T>
+T* static_object<T>::instance_ = 0;
+#if BOOST_UNITS_HAS_THREADS
+template<class T>
+std::mutex static_object<T>::mutex_;
+#endif
+#endif
+
+} // namespace detail
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_DETAIL_STATIC_OBJECT_HPP
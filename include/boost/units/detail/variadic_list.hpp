@@ -0,0 +1,194 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_DETAIL_VARIADIC_LIST_HPP
+#define BOOST_UNITS_DETAIL_VARIADIC_LIST_HPP
+
+#include <boost/units/config.hpp>
+
+#if BOOST_UNITS_HAS_VARIADIC_LIST
+
+#include <boost/mpl/deref.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/less.hpp>
+#include <boost/mpl/next.hpp>
+
+#include <boost/units/dimensionless_type.hpp>
+#include <boost/units/detail/dimension_list.hpp>
+
+/// \file
+/// \brief Flat parameter packs used to process @c list under C++11.
+/// \details @c list remains the representation of dimensions and systems,
+///   since it is part of the type of every unit.  The algorithms that
+///   used to recurse once per item (and insert once per pair of items)
+///   flatten the list into a @c type_pack, work on the pack, and rebuild
+///   the list, four items per step.
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+/// INTERNAL ONLY
+template<class... T>
+struct type_pack
+{
+    typedef type_pack type;
+};
+
+/// Flattens a cons list (anything with item, next and size, such as
+/// @c list) into a @c type_pack.
+template<long N, bool Chunk = (N >= 4)>
+struct list_to_pack_impl;
+
+template<long N>
+struct list_to_pack_impl<N, true>
+{
+    template<class L, class... T>
+    struct apply :
+        list_to_pack_impl<N - 4>::template apply<
+            typename L::next::next::next::next,
+            T...,
+            typename L::item,
+            typename L::next::item,
+            typename L::next::next::item,
+            typename L::next::next::next::item
+        > { };
+};
+
+template<long N>
+struct list_to_pack_impl<N, false>
+{
+    template<class L, class... T>
+    struct apply :
+        list_to_pack_impl<N - 1>::template apply<typename L::next, T..., typename L::item> { };
+};
+
+template<>
+struct list_to_pack_impl<0, false>
+{
+    template<class L, class... T>
+    struct apply : type_pack<T...> { };
+};
+
+template<class L>
+struct list_to_pack :
+    list_to_pack_impl<L::size::value>::template apply<L> { };
+
+/// Flattens N elements of an MPL sequence starting at the iterator Begin.
+template<long N>
+struct mpl_to_pack_impl
+{
+    template<class Begin, class... T>
+    struct apply :
+        mpl_to_pack_impl<N - 1>::template apply<
+            typename mpl::next<Begin>::type,
+            T...,
+            typename mpl::deref<Begin>::type
+        > { };
+};
+
+template<>
+struct mpl_to_pack_impl<0>
+{
+    template<class Begin, class... T>
+    struct apply : type_pack<T...> { };
+};
+
+/// Rebuilds a @c list from a @c type_pack.
+template<class Pack>
+struct pack_to_list;
+
+template<>
+struct pack_to_list<type_pack<> >
+{
+    typedef dimensionless_type type;
+};
+
+template<class T0, class... T>
+struct pack_to_list<type_pack<T0, T...> >
+{
+    typedef list<T0, typename pack_to_list<type_pack<T...> >::type> type;
+};
+
+template<class T0, class T1, class T2, class T3, class... T>
+struct pack_to_list<type_pack<T0, T1, T2, T3, T...> >
+{
+    typedef list<T0, list<T1, list<T2, list<T3,
+        typename pack_to_list<type_pack<T...> >::type> > > > type;
+};
+
+/// Merges two sorted packs.  On ties the element of the first pack
+/// comes first, so the merge is stable.
+template<class A, class B, class Out = type_pack<> >
+struct merge_packs;
+
+template<class... Out>
+struct merge_packs<type_pack<>, type_pack<>, type_pack<Out...> > :
+    type_pack<Out...> { };
+
+template<class A0, class... A, class... Out>
+struct merge_packs<type_pack<A0, A...>, type_pack<>, type_pack<Out...> > :
+    type_pack<Out..., A0, A...> { };
+
+template<class B0, class... B, class... Out>
+struct merge_packs<type_pack<>, type_pack<B0, B...>, type_pack<Out...> > :
+    type_pack<Out..., B0, B...> { };
+
+template<class A0, class... A, class B0, class... B, class... Out>
+struct merge_packs<type_pack<A0, A...>, type_pack<B0, B...>, type_pack<Out...> > :
+    mpl::if_c<
+        mpl::less<B0, A0>::value,
+        merge_packs<type_pack<A0, A...>, type_pack<B...>, type_pack<Out..., B0> >,
+        merge_packs<type_pack<A...>, type_pack<B0, B...>, type_pack<Out..., A0> >
+    >::type { };
+
+/// One pass of a bottom-up merge sort: merges neighbouring runs.
+template<class Runs, class Out = type_pack<> >
+struct merge_pass;
+
+template<class... Out>
+struct merge_pass<type_pack<>, type_pack<Out...> > :
+    type_pack<Out...> { };
+
+template<class R0, class... Out>
+struct merge_pass<type_pack<R0>, type_pack<Out...> > :
+    type_pack<Out..., R0> { };
+
+template<class R0, class R1, class... R, class... Out>
+struct merge_pass<type_pack<R0, R1, R...>, type_pack<Out...> > :
+    merge_pass<type_pack<R...>, type_pack<Out..., typename merge_packs<R0, R1>::type> > { };
+
+template<class Runs>
+struct merge_runs :
+    merge_runs<typename merge_pass<Runs>::type> { };
+
+template<class R>
+struct merge_runs<type_pack<R> > : R { };
+
+template<>
+struct merge_runs<type_pack<> > : type_pack<> { };
+
+/// Stable sort of a @c type_pack by @c mpl::less, with O(N log N)
+/// comparisons instead of the O(N^2) of an insertion sort.
+template<class Pack>
+struct sort_pack;
+
+template<class... T>
+struct sort_pack<type_pack<T...> > :
+    merge_runs<type_pack<type_pack<T>...> > { };
+
+} // namespace detail
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_HAS_VARIADIC_LIST
+
+#endif // BOOST_UNITS_DETAIL_VARIADIC_LIST_HPP
@@ -19,13 +19,38 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <string>
 #include <iosfwd>
 #include <ios>
+#include <limits>
 #include <sstream>
 
 #include <boost/assert.hpp>
+#include <boost/config.hpp>
 #include <boost/core/nvp.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+#include <boost/type_traits/is_signed.hpp>
+
+#ifndef BOOST_NO_CXX11_HDR_SYSTEM_ERROR
+#include <system_error>
+#endif
+
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW) && !defined(BOOST_NO_CXX17_INLINE_VARIABLES)
+#include <string_view>
+#endif
+
+#if !defined(BOOST_UNITS_HAS_STD_TO_CHARS) && defined(__cplusplus) && __cplusplus >= 201703L
+    #include <charconv>
+    #if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        ///INTERNAL ONLY
+        #define BOOST_UNITS_HAS_STD_TO_CHARS
+    #endif
+#endif
 
 #include <boost/units/units_fwd.hpp>
 #include <boost/units/heterogeneous_system.hpp>
@@ -34,6 +59,7 @@
 #include <boost/units/scale.hpp>
 #include <boost/units/static_rational.hpp>
 #include <boost/units/unit.hpp>
+#include <boost/units/detail/static_object.hpp>
 #include <boost/units/detail/utility.hpp>
 
 namespace boost {
@@ -655,8 +681,9 @@ inline void do_print(std::basic_ostream<Char, Traits>& os, const char* s)
 #ifdef BOOST_UNITS_DOXYGEN
 
 /// ADL customization point for automatic prefixing.
-/// Returns a non-negative value.  Implemented as std::abs
-/// for built-in types.
+/// Returns a non-negative value.  Implemented as the magnitude
+/// of the value converted to double for built-in types,
+/// including unsigned ones.
 template<class T>
 double autoprefix_norm(const T& arg);
 
@@ -669,7 +696,9 @@ template<class T>
 struct autoprefix_norm_impl<T, true>
 {
     typedef double type;
-    static BOOST_CONSTEXPR double call(const T& arg) { return std::abs(arg); }
+    // not std::abs, which is ambiguous for unsigned types
+    static BOOST_CONSTEXPR double call(const T& arg) { return magnitude(static_cast<double>(arg)); }
+    static BOOST_CONSTEXPR double magnitude(double x) { return x < 0.0 ? -x : x; }
 };
 
 template<class T>
@@ -790,6 +819,68 @@ print_default_t<Os, Quantity> print_default(Os& os, const Quantity& q)
     return result;
 }
 
+/// One string for each format_mode.
+struct format_strings
+{
+    std::string values[4];
+};
+
+/// The strings that @c Derived::build() returns, built on first use
+/// and then reused.
+template<class Derived>
+struct cached_strings
+{
+    static const std::string& get(format_mode mode)
+    {
+        return static_object<instance>::get().values[mode];
+    }
+
+    private:
+        struct instance : format_strings
+        {
+            instance() : format_strings(Derived::build()) { }
+        };
+};
+
+/// The strings of a unit in each format_mode.  They depend only on
+/// the type, so they are built on first use and then reused.
+template<class Unit>
+struct unit_strings : cached_strings<unit_strings<Unit> >
+{
+    static format_strings build()
+    {
+        format_strings result = { {
+            symbol_string(Unit()),
+            name_string(Unit()),
+            to_string_impl(Unit(), format_raw_symbol_impl()),
+            typename_string(Unit())
+        } };
+        return result;
+    }
+};
+
+/// The strings of a prefix in each format_mode.
+template<class Prefix>
+struct prefix_strings : cached_strings<prefix_strings<Prefix> >
+{
+    static format_strings build()
+    {
+        format_strings result = { {
+            Prefix::symbol(),
+            Prefix::name(),
+            Prefix::symbol(),
+            units::simplify_typename(Prefix()) + ' '
+        } };
+        return result;
+    }
+};
+
+template<class Char, class Traits, class Prefix>
+void print_prefix(std::basic_ostream<Char, Traits>& os, const Prefix&)
+{
+    do_print(os, prefix_strings<Prefix>::get(units::get_format(os)));
+}
+
 template<class Os>
 struct print_scale_t {
     typedef void result_type;
@@ -798,12 +889,7 @@ struct print_scale_t {
     {
         *prefixed = true;
         *os << t / Prefix::value() << ' ';
-        switch(units::get_format(*os)) {
-            case name_fmt: do_print(*os, Prefix::name()); break;
-            case raw_fmt:
-            case symbol_fmt: do_print(*os, Prefix::symbol()); break;
-            case typename_fmt: do_print(*os, units::simplify_typename(Prefix())); *os << ' '; break;
-        }
+        print_prefix(*os, Prefix());
     }
     template<long N, class T>
     void operator()(scale<N, static_rational<0> >, const T& t) const
@@ -857,18 +943,39 @@ maybe_parenthesize(const unit<Dimension, heterogeneous_system<heterogeneous_syst
     return f(unit<Dimension, heterogeneous_system<heterogeneous_system_impl<list<heterogeneous_system_dim<Unit, static_rational<1> >, dimensionless_type>, Dimension, dimensionless_type> > >());
 }
 
-template<class Prefixes, class CharT, class Traits, class Unit, class T, class F>
-void do_print_prefixed_impl(std::basic_ostream<CharT, Traits>& os, const quantity<Unit, T>& q, F default_)
+/// The strings of a unit following a prefix in each format_mode.
+template<class Unit>
+struct prefixed_unit_strings : cached_strings<prefixed_unit_strings<Unit> >
+{
+    static format_strings build()
+    {
+        format_strings result = { {
+            maybe_parenthesize(Unit(), format_symbol_impl()),
+            maybe_parenthesize(Unit(), format_name_impl()),
+            maybe_parenthesize(Unit(), format_raw_symbol_impl()),
+            simplify_typename(Unit())
+        } };
+        return result;
+    }
+};
+
+template<class Char, class Traits, class Unit>
+void print_prefixed_unit(std::basic_ostream<Char, Traits>& os, const Unit&)
+{
+    do_print(os, prefixed_unit_strings<Unit>::get(units::get_format(os)));
+}
+
+// The functions below print through any Os that provides operator<<
+// for values, strings and units, print_prefix and print_prefixed_unit:
+// either a std::basic_ostream or a chars_sink.
+
+template<class Prefixes, class Os, class Unit, class T, class F>
+void do_print_prefixed_impl(Os& os, const quantity<Unit, T>& q, F default_)
 {
     bool prefixed;
     if(detail::find_matching_scale<Prefixes>(q.value(), autoprefix_norm(q.value()), detail::print_scale(os, prefixed))) {
         if(prefixed) {
-            switch(units::get_format(os)) {
-                case symbol_fmt: do_print(os, maybe_parenthesize(Unit(), format_symbol_impl())); break;
-                case raw_fmt: do_print(os, maybe_parenthesize(Unit(), format_raw_symbol_impl())); break;
-                case name_fmt: do_print(os, maybe_parenthesize(Unit(), format_name_impl())); break;
-                case typename_fmt: do_print(os, simplify_typename(Unit())); break;
-            }
+            print_prefixed_unit(os, Unit());
         } else {
             os << Unit();
         }
@@ -880,12 +987,12 @@ void do_print_prefixed_impl(std::basic_ostream<CharT, Traits>& os, const quantit
 // Handle units like si::kilograms that have a scale embedded in the
 // base unit.  This overload is disabled if the scaled base unit has
 // a user-defined string representation.
-template<class Prefixes, class CharT, class Traits, class Dimension, class BaseUnit, class BaseScale, class Scale, class T>
+template<class Prefixes, class Os, class Dimension, class BaseUnit, class BaseScale, class Scale, class T>
 typename base_unit_info<
-    scaled_base_unit<BaseUnit, Scale>
+    scaled_base_unit<BaseUnit, BaseScale>
 >::base_unit_info_primary_template
 do_print_prefixed(
-    std::basic_ostream<CharT, Traits>& os,
+    Os& os,
     const quantity<
         unit<
             Dimension,
@@ -925,9 +1032,9 @@ do_print_prefixed(
     detail::do_print_prefixed_impl<Prefixes>(os, unscaled, detail::print_default(os, q));
 }
 
-template<class Prefixes, class CharT, class Traits, class Dimension, class L, class Scale, class T>
+template<class Prefixes, class Os, class Dimension, class L, class Scale, class T>
 void do_print_prefixed(
-    std::basic_ostream<CharT, Traits>& os,
+    Os& os,
     const quantity<
         unit<
             Dimension,
@@ -958,26 +1065,26 @@ void do_print_prefixed(
     detail::do_print_prefixed_impl<Prefixes>(os, unscaled, detail::print_default(os, q));
 }
 
-template<class Prefixes, class CharT, class Traits, class Dimension, class System, class T>
-void do_print_prefixed(std::basic_ostream<CharT, Traits>& os, const quantity<unit<Dimension, System>, T>& q)
+template<class Prefixes, class Os, class Dimension, class System, class T>
+void do_print_prefixed(Os& os, const quantity<unit<Dimension, System>, T>& q)
 {
     detail::do_print_prefixed<Prefixes>(os, quantity<unit<Dimension, typename make_heterogeneous_system<Dimension, System>::type>, T>(q));
 }
 
-template<class Prefixes, class CharT, class Traits, class Unit, class T>
-void do_print_prefixed(std::basic_ostream<CharT, Traits>& os, const quantity<Unit, T>& q)
+template<class Prefixes, class Os, class Unit, class T>
+void do_print_prefixed(Os& os, const quantity<Unit, T>& q)
 {
     detail::print_default(os, q)();
 }
 
-template<class Prefixes, class CharT, class Traits, class Unit, class T>
-void maybe_print_prefixed(std::basic_ostream<CharT, Traits>& os, const quantity<Unit, T>& q, mpl::true_)
+template<class Prefixes, class Os, class Unit, class T>
+void maybe_print_prefixed(Os& os, const quantity<Unit, T>& q, mpl::true_)
 {
     detail::do_print_prefixed<Prefixes>(os, q);
 }
 
-template<class Prefixes, class CharT, class Traits, class Unit, class T>
-void maybe_print_prefixed(std::basic_ostream<CharT, Traits>& os, const quantity<Unit, T>& q, mpl::false_)
+template<class Prefixes, class Os, class Unit, class T>
+void maybe_print_prefixed(Os& os, const quantity<Unit, T>& q, mpl::false_)
 {
     detail::print_default(os, q)();
 }
@@ -1008,6 +1115,45 @@ name_string(const unit<Dimension, System>&)
     return detail::to_string_impl(unit<Dimension,System>(), detail::format_name_impl());
 }
 
+/// The string of @c Unit in the format @c mode, as printed by
+/// @c operator<<.  It is built once per unit type and format, so the
+/// reference stays valid for the rest of the program.
+template<class Unit>
+inline const std::string& unit_string(format_mode mode = symbol_fmt)
+{
+    return detail::unit_strings<Unit>::get(mode);
+}
+
+/// The symbol of @c Unit, e.g. "N" or "m s^-1".
+template<class Unit>
+inline const std::string& unit_symbol()
+{
+    return detail::unit_strings<Unit>::get(symbol_fmt);
+}
+
+/// The name of @c Unit, e.g. "newton" or "meter second^-1".
+template<class Unit>
+inline const std::string& unit_name()
+{
+    return detail::unit_strings<Unit>::get(name_fmt);
+}
+
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW) && !defined(BOOST_NO_CXX17_INLINE_VARIABLES)
+
+/// The symbol of @c Unit as a @c std::string_view.  It is initialized
+/// dynamically, before @c main but in no particular order relative to
+/// other translation units, so it must not be read during static
+/// initialization; use @c unit_symbol<Unit>() there instead.
+template<class Unit>
+inline const std::string_view unit_symbol_v = unit_symbol<Unit>();
+
+/// The name of @c Unit as a @c std::string_view.  Like
+/// @c unit_symbol_v, it must not be read during static initialization.
+template<class Unit>
+inline const std::string_view unit_name_v = unit_name<Unit>();
+
+#endif
+
 /// Print a @c unit as a list of base units and their exponents.
 ///
 ///     for @c symbol_format outputs e.g. "m s^-1" or "J".
@@ -1015,29 +1161,9 @@ name_string(const unit<Dimension, System>&)
 ///     for @c raw_format  outputs e.g. "m s^-1" or "meter kilogram^2 second^-2".
 ///     for @c typename_format  outputs the typename itself (currently demangled only on GCC).
 template<class Char, class Traits, class Dimension, class System>
-inline std::basic_ostream<Char, Traits>& operator<<(std::basic_ostream<Char, Traits>& os, const unit<Dimension, System>& u)
+inline std::basic_ostream<Char, Traits>& operator<<(std::basic_ostream<Char, Traits>& os, const unit<Dimension, System>&)
 {
-    if (units::get_format(os) == typename_fmt)
-    {
-        detail::do_print(os, typename_string(u));
-    }
-    else if (units::get_format(os) == raw_fmt)
-    {
-        detail::do_print(os, detail::to_string_impl(u, detail::format_raw_symbol_impl()));
-    }
-    else if (units::get_format(os) == symbol_fmt)
-    {
-        detail::do_print(os, symbol_string(u));
-    }
-    else if (units::get_format(os) == name_fmt)
-    {
-        detail::do_print(os, name_string(u));
-    }
-    else
-    {
-        BOOST_ASSERT_MSG(false, "The format mode must be one of: typename_format, raw_format, name_format, symbol_format");
-    }
-
+    detail::do_print(os, unit_string<unit<Dimension, System> >(units::get_format(os)));
     return(os);
 }
 
@@ -1069,6 +1195,172 @@ inline std::basic_ostream<Char, Traits>& operator<<(std::basic_ostream<Char, Tra
     return(os);
 }
 
+#ifndef BOOST_NO_CXX11_HDR_SYSTEM_ERROR
+
+#ifdef BOOST_UNITS_HAS_STD_TO_CHARS
+
+/// The result of @c to_chars: one past the last character written, and
+/// @c std::errc::value_too_large if the output did not fit.
+typedef std::to_chars_result to_chars_result;
+
+#else
+
+/// The result of @c to_chars: one past the last character written, and
+/// @c std::errc::value_too_large if the output did not fit.
+struct to_chars_result
+{
+    char* ptr;
+    std::errc ec;
+};
+
+#endif
+
+namespace detail {
+
+/// Writes to a caller-supplied range of characters instead of a stream.
+/// Once something does not fit, nothing more is written.
+class chars_sink
+{
+    public:
+        chars_sink(char* first, char* last, format_mode mode) :
+            first_(first), last_(last), mode_(mode), overflow_(false)
+        { }
+
+        chars_sink& operator<<(char c)
+        {
+            write(&c, 1);
+            return *this;
+        }
+
+        chars_sink& operator<<(const std::string& str)
+        {
+            write(str.data(), str.size());
+            return *this;
+        }
+
+        template<class T>
+        chars_sink& operator<<(const T& t)
+        {
+            BOOST_STATIC_ASSERT_MSG(boost::is_arithmetic<T>::value, "to_chars requires an arithmetic value type");
+            write_value(t, boost::is_floating_point<T>());
+            return *this;
+        }
+
+        template<class Dimension, class System>
+        chars_sink& operator<<(const unit<Dimension, System>&)
+        {
+            return *this << unit_strings<unit<Dimension, System> >::get(mode_);
+        }
+
+        format_mode mode() const { return mode_; }
+
+        to_chars_result result() const
+        {
+            to_chars_result r = { first_, overflow_ ? std::errc::value_too_large : std::errc() };
+            return r;
+        }
+
+    private:
+        void write(const char* str, std::size_t n)
+        {
+            if(overflow_ || n > static_cast<std::size_t>(last_ - first_)) {
+                overflow_ = true;
+                return;
+            }
+            std::memcpy(first_, str, n);
+            first_ += n;
+        }
+
+#ifdef BOOST_UNITS_HAS_STD_TO_CHARS
+
+        template<class T, class IsFloat>
+        void write_value(const T& t, IsFloat)
+        {
+            if(overflow_) return;
+            const std::to_chars_result r = std::to_chars(first_, last_, t);
+            if(r.ec == std::errc()) first_ = r.ptr;
+            else overflow_ = true;
+        }
+
+#else
+
+        // without std::to_chars, use the fewest digits that round trip
+        template<class T>
+        void write_value(const T& t, boost::true_type)
+        {
+            char buffer[64];
+            int n = 0;
+            for(int precision = std::numeric_limits<T>::digits10; precision <= std::numeric_limits<T>::max_digits10; ++precision)
+            {
+                n = std::snprintf(buffer, sizeof(buffer), "%.*Lg", precision, static_cast<long double>(t));
+                if(static_cast<T>(std::strtold(buffer, 0)) == t) break;
+            }
+            write(buffer, static_cast<std::size_t>(n));
+        }
+
+        template<class T>
+        void write_value(const T& t, boost::false_type)
+        {
+            char buffer[32];
+            const int n = boost::is_signed<T>::value ?
+                std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(t)) :
+                std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(t));
+            write(buffer, static_cast<std::size_t>(n));
+        }
+
+#endif
+
+        char*       first_;
+        char*       last_;
+        format_mode mode_;
+        bool        overflow_;
+};
+
+template<class Prefix>
+inline void print_prefix(chars_sink& os, const Prefix&)
+{
+    os << prefix_strings<Prefix>::get(os.mode());
+}
+
+template<class Unit>
+inline void print_prefixed_unit(chars_sink& os, const Unit&)
+{
+    os << prefixed_unit_strings<Unit>::get(os.mode());
+}
+
+} // namespace detail
+
+/// \brief Format a @c quantity into <tt>[first, last)</tt>.
+/// \details Writes the same unit strings as @c operator<< with the
+/// given format and autoprefix, without allocating: the strings of
+/// each unit and prefix are computed once and then reused.  The value
+/// is written by @c std::to_chars in its shortest round-trip form,
+/// rather than with the precision of a stream.  No terminating null
+/// is written.  The value type must be arithmetic.
+template<class Unit, class T>
+inline to_chars_result to_chars(char* first, char* last, const quantity<Unit, T>& q,
+                                format_mode mode = symbol_fmt,
+                                autoprefix_mode prefix = autoprefix_none)
+{
+    detail::chars_sink os(first, last, mode);
+    if (prefix == autoprefix_engineering)
+    {
+        detail::maybe_print_prefixed<detail::engineering_prefixes>(os, q, detail::test_norm(autoprefix_norm(q.value())));
+    }
+    else if (prefix == autoprefix_binary)
+    {
+        detail::maybe_print_prefixed<detail::binary_prefixes>(os, q, detail::test_norm(autoprefix_norm(q.value())));
+    }
+    else
+    {
+        BOOST_ASSERT_MSG(prefix == autoprefix_none, "Autoprefixing must be one of: autoprefix_none, autoprefix_engineering, autoprefix_binary");
+        os << q.value() << ' ' << Unit();
+    }
+    return os.result();
+}
+
+#endif // BOOST_NO_CXX11_HDR_SYSTEM_ERROR
+
 } // namespace units
 
 } // namespace boost
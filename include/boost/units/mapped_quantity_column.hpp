@@ -0,0 +1,276 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_MAPPED_QUANTITY_COLUMN_HPP
+#define BOOST_UNITS_MAPPED_QUANTITY_COLUMN_HPP
+
+///
+/// \file
+/// \brief Read-only views of quantity columns in memory or mapped files.
+/// \details A @c mapped_quantity_column presents the values of a
+///   column written by @c write_quantity_column as a random-access range
+///   of quantities without copying them.  If the column holds @c Y in
+///   @c Unit the quantities are read in place, otherwise each value is
+///   converted as it is accessed.
+///
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/predef/other/endian.h>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/units/quantity.hpp>
+#include <boost/units/quantity_array.hpp>
+#include <boost/units/quantity_column.hpp>
+
+#if defined(BOOST_HAS_UNISTD_H)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+/// Defined if @c mapped_quantity_column can map files.
+#define BOOST_UNITS_HAS_MAPPED_FILE
+#endif
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+#ifdef BOOST_UNITS_HAS_MAPPED_FILE
+
+/// A whole file mapped read-only into memory.
+class mapped_file_region : boost::noncopyable
+{
+    public:
+        explicit mapped_file_region(const char* path) : data_(0), size_(0)
+        {
+            const int fd = ::open(path, O_RDONLY);
+            if(fd < 0)
+                throw std::runtime_error("boost::units::mapped_quantity_column: cannot open file");
+            struct stat st;
+            if(::fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                throw std::runtime_error("boost::units::mapped_quantity_column: cannot read file size");
+            }
+            size_ = static_cast<std::size_t>(st.st_size);
+            if(size_ != 0)
+            {
+                void* p = ::mmap(0, size_, PROT_READ, MAP_SHARED, fd, 0);
+                if(p == MAP_FAILED)
+                {
+                    ::close(fd);
+                    throw std::runtime_error("boost::units::mapped_quantity_column: cannot map file");
+                }
+                data_ = static_cast<const char*>(p);
+            }
+            ::close(fd);
+        }
+
+        ~mapped_file_region()
+        {
+            if(data_ != 0)
+                ::munmap(const_cast<char*>(data_), size_);
+        }
+
+        const char* data() const { return data_; }
+        std::size_t size() const { return size_; }
+
+    private:
+        const char* data_;
+        std::size_t size_;
+};
+
+#endif
+
+/// How the values of a column are turned into @c Y.
+template<class Y>
+struct column_access
+{
+    std::size_t                             stride;
+    double                                  factor;
+    typename column_converter<Y>::type      convert;
+    bool                                    in_place;
+
+    Y load(const char* p) const
+    {
+        Y result;
+        if(in_place)
+        {
+            std::memcpy(&result, p, sizeof(Y));
+            return result;
+        }
+#if BOOST_ENDIAN_LITTLE_BYTE
+        convert(p, 1, factor, &result);
+#else
+        char value[8];
+        std::memcpy(value, p, stride);
+        swap_to_little_endian(value, 1, stride);
+        convert(value, 1, factor, &result);
+#endif
+        return result;
+    }
+};
+
+} // namespace detail
+
+/// A random-access iterator over a @c mapped_quantity_column.  It
+/// dereferences to a quantity by value.
+template<class Unit, class Y>
+class mapped_quantity_iterator :
+    public boost::iterator_facade<mapped_quantity_iterator<Unit, Y>,
+                                  quantity<Unit, Y>,
+                                  boost::random_access_traversal_tag,
+                                  quantity<Unit, Y> >
+{
+    public:
+        mapped_quantity_iterator() : pos_(0), access_() { }
+        mapped_quantity_iterator(const char* pos, const detail::column_access<Y>& access) : pos_(pos), access_(access) { }
+
+    private:
+        friend class boost::iterator_core_access;
+
+        quantity<Unit, Y> dereference() const { return quantity<Unit, Y>::from_value(access_.load(pos_)); }
+        bool equal(const mapped_quantity_iterator& other) const { return pos_ == other.pos_; }
+        void increment() { pos_ += access_.stride; }
+        void decrement() { pos_ -= access_.stride; }
+        void advance(std::ptrdiff_t n) { pos_ += n * static_cast<std::ptrdiff_t>(access_.stride); }
+        std::ptrdiff_t distance_to(const mapped_quantity_iterator& other) const
+        {
+            return (other.pos_ - pos_) / static_cast<std::ptrdiff_t>(access_.stride);
+        }
+
+        const char*                 pos_;
+        detail::column_access<Y>    access_;
+};
+
+/// \brief A read-only view of a quantity column as quantities of @c Unit
+/// with values of type @c Y.
+/// \details The column may have any unit with the dimension of @c Unit
+/// and any value type, otherwise the constructors throw
+/// @c std::domain_error.  If it holds @c Y in @c Unit, @c in_place() is
+/// true and @c data() points at the values, otherwise each value is
+/// converted when it is accessed.  Copies share the underlying memory.
+template<class Unit, class Y>
+class mapped_quantity_column
+{
+    public:
+        typedef quantity<Unit, Y>                       value_type;
+        typedef value_type                              reference;
+        typedef value_type                              const_reference;
+        typedef mapped_quantity_iterator<Unit, Y>       iterator;
+        typedef iterator                                const_iterator;
+        typedef std::size_t                             size_type;
+        typedef std::ptrdiff_t                          difference_type;
+
+        /// A view of the column in the @c size bytes at @c data, which
+        /// must outlive it.
+        mapped_quantity_column(const void* data, std::size_t size) { attach(static_cast<const char*>(data), size); }
+
+#ifdef BOOST_UNITS_HAS_MAPPED_FILE
+        /// Maps the column in the file at @c path.  Throws
+        /// @c std::runtime_error if it cannot be mapped.
+        explicit mapped_quantity_column(const char* path) : file_(new detail::mapped_file_region(path))
+        {
+            attach(file_->data(), file_->size());
+        }
+
+        explicit mapped_quantity_column(const std::string& path) : file_(new detail::mapped_file_region(path.c_str()))
+        {
+            attach(file_->data(), file_->size());
+        }
+#endif
+
+        const quantity_column_header& header() const { return header_; }
+
+        /// whether the values are stored as @c Y in @c Unit and suitably
+        /// aligned, so that @c data() can be used
+        bool in_place() const { return access_.in_place; }
+
+        /// The raw values in @c Unit.  Throws @c std::logic_error unless
+        /// @c in_place().
+        const Y* data() const
+        {
+            if(!access_.in_place)
+                throw std::logic_error("boost::units::mapped_quantity_column::data: the values must be converted");
+            return reinterpret_cast<const Y*>(values_);
+        }
+
+        /// The values as a span of quantities.  Throws
+        /// @c std::logic_error unless @c in_place().
+        quantity_span<Unit, const Y> span() const
+        {
+            return quantity_span<Unit, const Y>(data(), size_);
+        }
+
+        size_type size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        const_iterator begin() const { return const_iterator(values_, access_); }
+        const_iterator end() const { return const_iterator(values_ + size_ * access_.stride, access_); }
+
+        value_type operator[](size_type i) const
+        {
+            return value_type::from_value(access_.load(values_ + i * access_.stride));
+        }
+
+        /// Throws @c std::out_of_range if @c i is not less than @c size().
+        value_type at(size_type i) const
+        {
+            if(i >= size_)
+                throw std::out_of_range("boost::units::mapped_quantity_column::at: index out of range");
+            return (*this)[i];
+        }
+
+    private:
+        void attach(const char* data, std::size_t size)
+        {
+            if(size < quantity_column_header::size)
+                throw std::runtime_error("boost::units::mapped_quantity_column: truncated header");
+            header_ = quantity_column_header::decode(data);
+            const quantity_column_header target = make_quantity_column_header<Unit, Y>(header_.count());
+            if(header_.dimension() != target.dimension())
+                throw std::domain_error("boost::units::mapped_quantity_column: the column has a different dimension");
+            if(header_.count() > (size - quantity_column_header::size) / header_.value_size())
+                throw std::runtime_error("boost::units::mapped_quantity_column: truncated values");
+
+            values_ = data + quantity_column_header::size;
+            size_ = static_cast<size_type>(header_.count());
+            access_.stride = header_.value_size();
+            access_.factor = header_.scale() / target.scale();
+            access_.convert = detail::column_converter<Y>::select(header_);
+            access_.in_place =
+                BOOST_ENDIAN_LITTLE_BYTE &&
+                header_.value_kind() == target.value_kind() &&
+                header_.value_size() == target.value_size() &&
+                access_.factor == 1.0 &&
+                reinterpret_cast<std::size_t>(values_) % sizeof(Y) == 0;
+        }
+
+#ifdef BOOST_UNITS_HAS_MAPPED_FILE
+        boost::shared_ptr<detail::mapped_file_region>   file_;
+#endif
+        quantity_column_header                          header_;
+        const char*                                     values_;
+        size_type                                       size_;
+        detail::column_access<Y>                        access_;
+};
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_MAPPED_QUANTITY_COLUMN_HPP
@@ -0,0 +1,656 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Copyright (C) 2003-2008 Matthias Christian Schabel
+// Copyright (C) 2008 Steven Watanabe
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_MEASUREMENT_HPP
+#define BOOST_UNITS_MEASUREMENT_HPP
+
+///
+/// \file
+/// \brief A value with an uncertainty, for use as the value type of a
+///   quantity.
+/// \details @c measurement<Y> holds a value and its standard uncertainty
+///   and propagates the uncertainty to first order through arithmetic,
+///   rational powers and the functions of \<cmath\>, so that
+///   <tt>quantity<Unit, measurement<double> ></tt> carries an uncertainty
+///   through any computation with quantities.  The operators treat their
+///   operands as independent; @c correlated_sum, @c correlated_difference,
+///   @c correlated_product and @c correlated_quotient take the correlation
+///   coefficient of the operands.  @c measurement_array stores many
+///   quantities of measurements as separate arrays of values and of
+///   uncertainties, and @c add, @c subtract, @c multiply and @c divide
+///   propagate whole arrays, with the units of their results deduced at
+///   compile time, in loops that can be vectorized.
+///
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include <boost/config.hpp>
+#include <boost/config/no_tr1/cmath.hpp>
+#include <boost/assert.hpp>
+#include <boost/math/constants/constants.hpp>
+
+#include <boost/units/cmath_array.hpp>
+#include <boost/units/config.hpp>
+#include <boost/units/operators.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/static_rational.hpp>
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+/// The variance of a function of two measurements, given the product of
+/// each partial derivative and the uncertainty of its argument, and the
+/// correlation of the arguments.  Rounding can make the variance of
+/// perfectly correlated values slightly negative, so it is clamped.
+template<class Y>
+inline Y measurement_variance(const Y& da, const Y& db, const Y& correlation)
+{
+    const Y variance = da * da + db * db + Y(2) * correlation * da * db;
+    return variance < Y() ? Y() : variance;
+}
+
+template<class Y>
+inline Y measurement_uncertainty(const Y& da, const Y& db, const Y& correlation)
+{
+    using std::sqrt;
+    return sqrt(measurement_variance(da, db, correlation));
+}
+
+template<class Y>
+inline Y measurement_abs(const Y& x)
+{
+    return x < Y() ? -x : x;
+}
+
+/// The partial derivatives of each operation, already multiplied by the
+/// uncertainties, and the value of the operation.
+struct measurement_plus
+{
+    template<class Y>
+    static Y variance(const Y&, const Y& ua, const Y&, const Y& ub, const Y& correlation)
+    { return measurement_variance(ua, ub, correlation); }
+    template<class Y>
+    static Y value(const Y& a, const Y& b) { return a + b; }
+};
+
+struct measurement_minus
+{
+    template<class Y>
+    static Y variance(const Y&, const Y& ua, const Y&, const Y& ub, const Y& correlation)
+    { return measurement_variance(ua, Y(-ub), correlation); }
+    template<class Y>
+    static Y value(const Y& a, const Y& b) { return a - b; }
+};
+
+struct measurement_multiplies
+{
+    template<class Y>
+    static Y variance(const Y& a, const Y& ua, const Y& b, const Y& ub, const Y& correlation)
+    { return measurement_variance(Y(b * ua), Y(a * ub), correlation); }
+    template<class Y>
+    static Y value(const Y& a, const Y& b) { return a * b; }
+};
+
+struct measurement_divides
+{
+    template<class Y>
+    static Y variance(const Y& a, const Y& ua, const Y& b, const Y& ub, const Y& correlation)
+    { return measurement_variance(Y(ua / b), Y(-a * ub / (b * b)), correlation); }
+    template<class Y>
+    static Y value(const Y& a, const Y& b) { return a / b; }
+};
+
+} // namespace detail
+
+/// \brief A value and its standard uncertainty.
+/// \details The uncertainty is always positive; arithmetic with a plain
+/// value treats it as exact.
+template<class Y>
+class measurement
+{
+    public:
+        typedef measurement<Y>  this_type;
+        typedef Y               value_type;
+
+        BOOST_CONSTEXPR measurement(const value_type& val = value_type(),
+                                    const value_type& err = value_type()) :
+            value_(val),
+            uncertainty_(err < value_type() ? -err : err)
+        { }
+
+        BOOST_CONSTEXPR value_type value() const       { return value_; }
+        BOOST_CONSTEXPR value_type uncertainty() const { return uncertainty_; }
+        BOOST_CONSTEXPR value_type lower_bound() const { return value_ - uncertainty_; }
+        BOOST_CONSTEXPR value_type upper_bound() const { return value_ + uncertainty_; }
+
+        this_type& operator+=(const value_type& val)
+        {
+            value_ += val;
+            return *this;
+        }
+
+        this_type& operator-=(const value_type& val)
+        {
+            value_ -= val;
+            return *this;
+        }
+
+        this_type& operator*=(const value_type& val)
+        {
+            value_ *= val;
+            uncertainty_ = detail::measurement_abs(uncertainty_ * val);
+            return *this;
+        }
+
+        this_type& operator/=(const value_type& val)
+        {
+            value_ /= val;
+            uncertainty_ = detail::measurement_abs(uncertainty_ / val);
+            return *this;
+        }
+
+        this_type& operator+=(const this_type& source) { return assign<detail::measurement_plus>(source, value_type()); }
+        this_type& operator-=(const this_type& source) { return assign<detail::measurement_minus>(source, value_type()); }
+        this_type& operator*=(const this_type& source) { return assign<detail::measurement_multiplies>(source, value_type()); }
+        this_type& operator/=(const this_type& source) { return assign<detail::measurement_divides>(source, value_type()); }
+
+        /// INTERNAL ONLY
+        template<class Op>
+        this_type& assign(const this_type& source, const value_type& correlation)
+        {
+            using std::sqrt;
+            uncertainty_ = sqrt(Op::variance(value_, uncertainty_, source.value_, source.uncertainty_, correlation));
+            value_ = Op::value(value_, source.value_);
+            return *this;
+        }
+
+    private:
+        value_type          value_,
+                            uncertainty_;
+};
+
+} // namespace units
+
+} // namespace boost
+
+#if BOOST_UNITS_HAS_BOOST_TYPEOF
+
+#include BOOST_TYPEOF_INCREMENT_REGISTRATION_GROUP()
+
+BOOST_TYPEOF_REGISTER_TEMPLATE(boost::units::measurement, (class))
+
+#endif
+
+namespace boost {
+
+namespace units {
+
+template<class Y>
+inline measurement<Y> operator+(const measurement<Y>& m) { return m; }
+
+template<class Y>
+inline measurement<Y> operator-(const measurement<Y>& m) { return measurement<Y>(-m.value(), m.uncertainty()); }
+
+// value_type op measurement
+template<class Y>
+inline measurement<Y> operator+(const Y& lhs, const measurement<Y>& rhs) { return measurement<Y>(lhs) += rhs; }
+
+template<class Y>
+inline measurement<Y> operator-(const Y& lhs, const measurement<Y>& rhs) { return measurement<Y>(lhs) -= rhs; }
+
+template<class Y>
+inline measurement<Y> operator*(const Y& lhs, const measurement<Y>& rhs) { return measurement<Y>(lhs) *= rhs; }
+
+template<class Y>
+inline measurement<Y> operator/(const Y& lhs, const measurement<Y>& rhs) { return measurement<Y>(lhs) /= rhs; }
+
+// measurement op value_type
+template<class Y>
+inline measurement<Y> operator+(const measurement<Y>& lhs, const Y& rhs) { return measurement<Y>(lhs) += rhs; }
+
+template<class Y>
+inline measurement<Y> operator-(const measurement<Y>& lhs, const Y& rhs) { return measurement<Y>(lhs) -= rhs; }
+
+template<class Y>
+inline measurement<Y> operator*(const measurement<Y>& lhs, const Y& rhs) { return measurement<Y>(lhs) *= rhs; }
+
+template<class Y>
+inline measurement<Y> operator/(const measurement<Y>& lhs, const Y& rhs) { return measurement<Y>(lhs) /= rhs; }
+
+// measurement op measurement, for independent measurements
+template<class Y>
+inline measurement<Y> operator+(const measurement<Y>& lhs, const measurement<Y>& rhs) { return measurement<Y>(lhs) += rhs; }
+
+template<class Y>
+inline measurement<Y> operator-(const measurement<Y>& lhs, const measurement<Y>& rhs) { return measurement<Y>(lhs) -= rhs; }
+
+template<class Y>
+inline measurement<Y> operator*(const measurement<Y>& lhs, const measurement<Y>& rhs) { return measurement<Y>(lhs) *= rhs; }
+
+template<class Y>
+inline measurement<Y> operator/(const measurement<Y>& lhs, const measurement<Y>& rhs) { return measurement<Y>(lhs) /= rhs; }
+
+/// measurements are equal if both their values and their uncertainties are
+template<class Y>
+inline bool operator==(const measurement<Y>& lhs, const measurement<Y>& rhs)
+{ return lhs.value() == rhs.value() && lhs.uncertainty() == rhs.uncertainty(); }
+
+template<class Y>
+inline bool operator!=(const measurement<Y>& lhs, const measurement<Y>& rhs) { return !(lhs == rhs); }
+
+/// measurements are ordered by their values alone
+template<class Y>
+inline bool operator<(const measurement<Y>& lhs, const measurement<Y>& rhs) { return lhs.value() < rhs.value(); }
+
+template<class Y>
+inline bool operator<=(const measurement<Y>& lhs, const measurement<Y>& rhs) { return lhs.value() <= rhs.value(); }
+
+template<class Y>
+inline bool operator>(const measurement<Y>& lhs, const measurement<Y>& rhs) { return lhs.value() > rhs.value(); }
+
+template<class Y>
+inline bool operator>=(const measurement<Y>& lhs, const measurement<Y>& rhs) { return lhs.value() >= rhs.value(); }
+
+/// the sum of measurements with the given correlation coefficient
+template<class Y>
+inline measurement<Y> correlated_sum(const measurement<Y>& lhs, const measurement<Y>& rhs, const Y& correlation)
+{
+    return measurement<Y>(lhs).template assign<detail::measurement_plus>(rhs, correlation);
+}
+
+/// the difference of measurements with the given correlation
+/// coefficient; the difference of a measurement and itself, with a
+/// correlation of one, is exact
+template<class Y>
+inline measurement<Y> correlated_difference(const measurement<Y>& lhs, const measurement<Y>& rhs, const Y& correlation)
+{
+    return measurement<Y>(lhs).template assign<detail::measurement_minus>(rhs, correlation);
+}
+
+/// the product of measurements with the given correlation coefficient
+template<class Y>
+inline measurement<Y> correlated_product(const measurement<Y>& lhs, const measurement<Y>& rhs, const Y& correlation)
+{
+    return measurement<Y>(lhs).template assign<detail::measurement_multiplies>(rhs, correlation);
+}
+
+/// the quotient of measurements with the given correlation coefficient
+template<class Y>
+inline measurement<Y> correlated_quotient(const measurement<Y>& lhs, const measurement<Y>& rhs, const Y& correlation)
+{
+    return measurement<Y>(lhs).template assign<detail::measurement_divides>(rhs, correlation);
+}
+
+template<class Unit1, class Unit2, class Y>
+inline typename add_typeof_helper<quantity<Unit1, measurement<Y> >, quantity<Unit2, measurement<Y> > >::type
+correlated_sum(const quantity<Unit1, measurement<Y> >& lhs, const quantity<Unit2, measurement<Y> >& rhs, const Y& correlation)
+{
+    typedef typename add_typeof_helper<quantity<Unit1, measurement<Y> >, quantity<Unit2, measurement<Y> > >::type type;
+    return type::from_value(correlated_sum(lhs.value(), rhs.value(), correlation));
+}
+
+template<class Unit1, class Unit2, class Y>
+inline typename subtract_typeof_helper<quantity<Unit1, measurement<Y> >, quantity<Unit2, measurement<Y> > >::type
+correlated_difference(const quantity<Unit1, measurement<Y> >& lhs, const quantity<Unit2, measurement<Y> >& rhs, const Y& correlation)
+{
+    typedef typename subtract_typeof_helper<quantity<Unit1, measurement<Y> >, quantity<Unit2, measurement<Y> > >::type type;
+    return type::from_value(correlated_difference(lhs.value(), rhs.value(), correlation));
+}
+
+template<class Unit1, class Unit2, class Y>
+inline typename multiply_typeof_helper<quantity<Unit1, measurement<Y> >, quantity<Unit2, measurement<Y> > >::type
+correlated_product(const quantity<Unit1, measurement<Y> >& lhs, const quantity<Unit2, measurement<Y> >& rhs, const Y& correlation)
+{
+    typedef typename multiply_typeof_helper<quantity<Unit1, measurement<Y> >, quantity<Unit2, measurement<Y> > >::type type;
+    return type::from_value(correlated_product(lhs.value(), rhs.value(), correlation));
+}
+
+template<class Unit1, class Unit2, class Y>
+inline typename divide_typeof_helper<quantity<Unit1, measurement<Y> >, quantity<Unit2, measurement<Y> > >::type
+correlated_quotient(const quantity<Unit1, measurement<Y> >& lhs, const quantity<Unit2, measurement<Y> >& rhs, const Y& correlation)
+{
+    typedef typename divide_typeof_helper<quantity<Unit1, measurement<Y> >, quantity<Unit2, measurement<Y> > >::type type;
+    return type::from_value(correlated_quotient(lhs.value(), rhs.value(), correlation));
+}
+
+/// specialize power typeof helper
+template<class Y,long N,long D>
+struct power_typeof_helper<measurement<Y>,static_rational<N,D> >
+{
+    typedef measurement<
+        typename power_typeof_helper<Y,static_rational<N,D> >::type
+    > type;
+
+    static type value(const measurement<Y>& x)
+    {
+        using std::pow;
+
+        const Y m = Y(N)/Y(D),
+                newval = pow(x.value(),m),
+                err = detail::measurement_abs(Y(m*pow(x.value(),m-Y(1))))*x.uncertainty();
+
+        return type(newval,err);
+    }
+};
+
+/// specialize root typeof helper
+template<class Y,long N,long D>
+struct root_typeof_helper<measurement<Y>,static_rational<N,D> >
+{
+    typedef measurement<
+        typename root_typeof_helper<Y,static_rational<N,D> >::type
+    > type;
+
+    static type value(const measurement<Y>& x)
+    {
+        return power_typeof_helper<measurement<Y>,static_rational<D,N> >::value(x);
+    }
+};
+
+// Functions of <cmath>, which the overloads for quantities in cmath.hpp
+// find by argument dependent lookup.
+
+template<class Y>
+inline measurement<Y> abs BOOST_PREVENT_MACRO_SUBSTITUTION (const measurement<Y>& x)
+{
+    return measurement<Y>(detail::measurement_abs(x.value()), x.uncertainty());
+}
+
+template<class Y>
+inline measurement<Y> fabs BOOST_PREVENT_MACRO_SUBSTITUTION (const measurement<Y>& x)
+{
+    return measurement<Y>(detail::measurement_abs(x.value()), x.uncertainty());
+}
+
+template<class Y>
+inline measurement<Y> sqrt(const measurement<Y>& x)
+{
+    using std::sqrt;
+    const Y root = sqrt(x.value());
+    return measurement<Y>(root, x.uncertainty() / (Y(2) * root));
+}
+
+template<class Y>
+inline measurement<Y> exp(const measurement<Y>& x)
+{
+    using std::exp;
+    const Y result = exp(x.value());
+    return measurement<Y>(result, result * x.uncertainty());
+}
+
+template<class Y>
+inline measurement<Y> log(const measurement<Y>& x)
+{
+    using std::log;
+    return measurement<Y>(log(x.value()), x.uncertainty() / x.value());
+}
+
+template<class Y>
+inline measurement<Y> log10(const measurement<Y>& x)
+{
+    using std::log10;
+    return measurement<Y>(log10(x.value()), x.uncertainty() / (x.value() * boost::math::constants::ln_ten<Y>()));
+}
+
+template<class Y>
+inline measurement<Y> pow(const measurement<Y>& x, const Y& y)
+{
+    using std::pow;
+    return measurement<Y>(pow(x.value(), y), y * pow(x.value(), y - Y(1)) * x.uncertainty());
+}
+
+/// x^y for independent @c x and @c y; an exact exponent contributes no
+/// uncertainty, even for negative @c x
+template<class Y>
+inline measurement<Y> pow(const measurement<Y>& x, const measurement<Y>& y)
+{
+    using std::pow;
+    using std::log;
+    const Y result = pow(x.value(), y.value());
+    const Y dx = y.value() * pow(x.value(), y.value() - Y(1)) * x.uncertainty();
+    const Y dy = y.uncertainty() == Y() ? Y() : result * log(x.value()) * y.uncertainty();
+    return measurement<Y>(result, detail::measurement_uncertainty(dx, dy, Y()));
+}
+
+template<class Y>
+inline measurement<Y> sin(const measurement<Y>& x)
+{
+    using std::sin;
+    using std::cos;
+    return measurement<Y>(sin(x.value()), cos(x.value()) * x.uncertainty());
+}
+
+template<class Y>
+inline measurement<Y> cos(const measurement<Y>& x)
+{
+    using std::sin;
+    using std::cos;
+    return measurement<Y>(cos(x.value()), sin(x.value()) * x.uncertainty());
+}
+
+template<class Y>
+inline measurement<Y> tan(const measurement<Y>& x)
+{
+    using std::tan;
+    using std::cos;
+    const Y c = cos(x.value());
+    return measurement<Y>(tan(x.value()), x.uncertainty() / (c * c));
+}
+
+template<class Y>
+inline measurement<Y> asin(const measurement<Y>& x)
+{
+    using std::asin;
+    using std::sqrt;
+    return measurement<Y>(asin(x.value()), x.uncertainty() / sqrt(Y(1) - x.value() * x.value()));
+}
+
+template<class Y>
+inline measurement<Y> acos(const measurement<Y>& x)
+{
+    using std::acos;
+    using std::sqrt;
+    return measurement<Y>(acos(x.value()), x.uncertainty() / sqrt(Y(1) - x.value() * x.value()));
+}
+
+template<class Y>
+inline measurement<Y> atan(const measurement<Y>& x)
+{
+    using std::atan;
+    return measurement<Y>(atan(x.value()), x.uncertainty() / (Y(1) + x.value() * x.value()));
+}
+
+/// atan2 of independent measurements
+template<class Y>
+inline measurement<Y> atan2(const measurement<Y>& y, const measurement<Y>& x)
+{
+    using std::atan2;
+    const Y r2 = x.value() * x.value() + y.value() * y.value();
+    return measurement<Y>(atan2(y.value(), x.value()),
+        detail::measurement_uncertainty(Y(x.value() * y.uncertainty() / r2), Y(y.value() * x.uncertainty() / r2), Y()));
+}
+
+/// hypot of independent measurements; at the origin, where the derivative
+/// is undefined, the uncertainty is the hypot of the uncertainties
+template<class Y>
+inline measurement<Y> hypot BOOST_PREVENT_MACRO_SUBSTITUTION (const measurement<Y>& x, const measurement<Y>& y)
+{
+    using boost::math::hypot;
+    const Y h = hypot BOOST_PREVENT_MACRO_SUBSTITUTION (x.value(), y.value());
+    if(h == Y())
+        return measurement<Y>(h, hypot BOOST_PREVENT_MACRO_SUBSTITUTION (x.uncertainty(), y.uncertainty()));
+    return measurement<Y>(h,
+        detail::measurement_uncertainty(Y(x.value() / h * x.uncertainty()), Y(y.value() / h * y.uncertainty()), Y()));
+}
+
+// stream output
+template<class Y>
+inline std::ostream& operator<<(std::ostream& os, const measurement<Y>& val)
+{
+    os << val.value() << "(+/-" << val.uncertainty() << ")";
+    return os;
+}
+
+/// \brief Quantities of measurements stored as an array of values and an
+///   array of uncertainties, both in @c Unit.
+/// \details Each array is contiguous, so that @c add, @c subtract,
+///   @c multiply and @c divide can process several measurements per
+///   instruction.  The elements are <tt>quantity<Unit, measurement<Y> ></tt>,
+///   and the unit of a result is deduced as for single quantities.
+template<class Unit, class Y = double, class Allocator = std::allocator<Y> >
+class measurement_array
+{
+    private:
+        typedef std::vector<Y, Allocator>               storage_type;
+    public:
+        typedef measurement_array<Unit, Y, Allocator>   this_type;
+        typedef Unit                                    unit_type;
+        typedef quantity<Unit, measurement<Y> >         value_type;
+        typedef Y                                       raw_value_type;
+        typedef Allocator                               allocator_type;
+        typedef typename storage_type::size_type        size_type;
+
+        measurement_array() { }
+        explicit measurement_array(const allocator_type& alloc) : values_(alloc), uncertainties_(alloc) { }
+        explicit measurement_array(size_type n, const value_type& m = value_type(), const allocator_type& alloc = allocator_type()) :
+            values_(n, m.value().value(), alloc),
+            uncertainties_(n, m.value().uncertainty(), alloc)
+        { }
+
+        allocator_type get_allocator() const { return values_.get_allocator(); }
+
+        size_type size() const { return values_.size(); }
+        bool empty() const { return values_.empty(); }
+        void reserve(size_type n) { values_.reserve(n); uncertainties_.reserve(n); }
+        void resize(size_type n, const value_type& m = value_type())
+        {
+            values_.resize(n, m.value().value());
+            uncertainties_.resize(n, m.value().uncertainty());
+        }
+        void clear() { values_.clear(); uncertainties_.clear(); }
+        void swap(this_type& other) { values_.swap(other.values_); uncertainties_.swap(other.uncertainties_); }
+
+        void push_back(const value_type& m)
+        {
+            values_.push_back(m.value().value());
+            uncertainties_.push_back(m.value().uncertainty());
+        }
+
+        value_type operator[](size_type i) const
+        {
+            return value_type::from_value(measurement<Y>(values_[i], uncertainties_[i]));
+        }
+
+        void set(size_type i, const value_type& m)
+        {
+            values_[i] = m.value().value();
+            uncertainties_[i] = m.value().uncertainty();
+        }
+
+        /// direct access to the values in @c Unit
+        Y* values() { return values_.empty() ? 0 : &values_[0]; }
+        const Y* values() const { return values_.empty() ? 0 : &values_[0]; }
+
+        /// direct access to the uncertainties in @c Unit, which must not
+        /// be negative
+        Y* uncertainties() { return uncertainties_.empty() ? 0 : &uncertainties_[0]; }
+        const Y* uncertainties() const { return uncertainties_.empty() ? 0 : &uncertainties_[0]; }
+
+    private:
+        storage_type values_;
+        storage_type uncertainties_;
+};
+
+template<class Unit, class Y, class Allocator>
+inline void swap(measurement_array<Unit, Y, Allocator>& lhs, measurement_array<Unit, Y, Allocator>& rhs)
+{
+    lhs.swap(rhs);
+}
+
+namespace detail {
+
+/// The uncertainties are computed before the values, which lets @c out
+/// be one of the operands, and the square roots are taken by the
+/// vectorized @c array_sqrt of cmath_array.hpp.
+template<class Op, class Y, class Lhs, class Rhs, class Out>
+inline void measurement_array_apply(const Lhs& lhs, const Rhs& rhs, Out& out, const Y& correlation)
+{
+    BOOST_ASSERT(lhs.size() == rhs.size());
+    const std::size_t n = lhs.size();
+    out.resize(n);
+    const Y* const a = lhs.values();
+    const Y* const ua = lhs.uncertainties();
+    const Y* const b = rhs.values();
+    const Y* const ub = rhs.uncertainties();
+    Y* const values = out.values();
+    Y* const uncertainties = out.uncertainties();
+    for(std::size_t i = 0; i < n; ++i)
+        uncertainties[i] = Op::variance(a[i], ua[i], b[i], ub[i], correlation);
+    array_sqrt(uncertainties, uncertainties, n);
+    for(std::size_t i = 0; i < n; ++i)
+        values[i] = Op::value(a[i], b[i]);
+}
+
+} // namespace detail
+
+/// the sums of corresponding elements of @c lhs and @c rhs, which have
+/// the given correlation, in @c out, which may be @c lhs or @c rhs
+template<class Unit, class Y, class Allocator>
+inline void add(const measurement_array<Unit, Y, Allocator>& lhs,
+                const measurement_array<Unit, Y, Allocator>& rhs,
+                measurement_array<Unit, Y, Allocator>& out,
+                const Y& correlation = Y())
+{
+    detail::measurement_array_apply<detail::measurement_plus>(lhs, rhs, out, correlation);
+}
+
+/// the differences of corresponding elements of @c lhs and @c rhs
+template<class Unit, class Y, class Allocator>
+inline void subtract(const measurement_array<Unit, Y, Allocator>& lhs,
+                     const measurement_array<Unit, Y, Allocator>& rhs,
+                     measurement_array<Unit, Y, Allocator>& out,
+                     const Y& correlation = Y())
+{
+    detail::measurement_array_apply<detail::measurement_minus>(lhs, rhs, out, correlation);
+}
+
+/// the products of corresponding elements of @c lhs and @c rhs, in the
+/// product of their units
+template<class Unit1, class Unit2, class Y, class Allocator>
+inline void multiply(const measurement_array<Unit1, Y, Allocator>& lhs,
+                     const measurement_array<Unit2, Y, Allocator>& rhs,
+                     measurement_array<typename multiply_typeof_helper<Unit1, Unit2>::type, Y, Allocator>& out,
+                     const Y& correlation = Y())
+{
+    detail::measurement_array_apply<detail::measurement_multiplies>(lhs, rhs, out, correlation);
+}
+
+/// the quotients of corresponding elements of @c lhs and @c rhs, in the
+/// quotient of their units
+template<class Unit1, class Unit2, class Y, class Allocator>
+inline void divide(const measurement_array<Unit1, Y, Allocator>& lhs,
+                   const measurement_array<Unit2, Y, Allocator>& rhs,
+                   measurement_array<typename divide_typeof_helper<Unit1, Unit2>::type, Y, Allocator>& out,
+                   const Y& correlation = Y())
+{
+    detail::measurement_array_apply<detail::measurement_divides>(lhs, rhs, out, correlation);
+}
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_MEASUREMENT_HPP
@@ -0,0 +1,398 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_PARSE_QUANTITY_HPP
+#define BOOST_UNITS_PARSE_QUANTITY_HPP
+
+///
+/// \file
+/// \brief Parsing of quantities written as a number and a unit.
+/// \details @c parse_quantity reads text such as "12.5 km/h",
+///   "3 kJ mol^-1" or "9.81 m s^-2" into a @c quantity of a unit known
+///   at compile time.  The units are looked up in a
+///   @c runtime_unit_registry, with or without an SI or binary prefix,
+///   and the value is converted to the unit of the quantity.  Errors
+///   are returned as a @c parse_error rather than thrown, and nothing
+///   is allocated except for numbers of 64 characters or more where
+///   @c std::from_chars is not available, so it can be used on every
+///   field of a large input.
+///
+
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <boost/config.hpp>
+
+#include <boost/units/io.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/runtime_quantity.hpp>
+#include <boost/units/runtime_unit.hpp>
+#include <boost/units/runtime_unit_registry.hpp>
+#include <boost/units/unit.hpp>
+
+namespace boost {
+
+namespace units {
+
+/// \enum parse_error why @c parse_quantity failed.
+enum parse_error
+{
+    parse_ok = 0,               /// the quantity was parsed.
+    parse_invalid_number,       /// the text does not start with a number.
+    parse_unknown_unit,         /// a unit is not in the registry, with or without a prefix.
+    parse_invalid_unit,         /// an operator or an exponent is not followed by what it needs.
+    parse_dimension_mismatch,   /// the unit does not have the dimension of the quantity.
+    parse_out_of_range          /// the number is too large or too small for a double.
+};
+
+/// The result of @c parse_quantity.  On success @c ptr is one past the
+/// text of the quantity, otherwise it is where the error was found.
+struct parse_quantity_result
+{
+    const char* ptr;
+    parse_error error;
+};
+
+namespace detail {
+
+inline parse_quantity_result make_parse_quantity_result(const char* ptr, parse_error error)
+{
+    parse_quantity_result result = { ptr, error };
+    return result;
+}
+
+inline bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline const char* skip_blanks(const char* first, const char* last)
+{
+    while(first != last && (*first == ' ' || *first == '\t')) ++first;
+    return first;
+}
+
+/// Characters that cannot be part of a unit symbol in a quantity.
+/// Quotes, commas and brackets end a unit so that a quantity can be
+/// read in place from CSV or JSON.
+inline bool ends_unit_symbol(char c)
+{
+    switch(c)
+    {
+        case ' ': case '\t': case '\r': case '\n':
+        case '*': case '/': case '^':
+        case ',': case ';': case '"':
+        case '(': case ')': case '[': case ']': case '{': case '}':
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// Parses a decimal number in the form accepted by @c std::from_chars:
+/// no leading '+', no hexadecimal, and no infinity or NaN.
+inline parse_quantity_result parse_number(const char* first, const char* last, double& result)
+{
+    const char* p = first;
+    if(p != last && *p == '-') ++p;
+    if(p == last || !(is_digit(*p) || *p == '.')) return make_parse_quantity_result(first, parse_invalid_number);
+
+#ifdef BOOST_UNITS_HAS_STD_TO_CHARS
+
+    const std::from_chars_result r = std::from_chars(first, last, result);
+    if(r.ec == std::errc::invalid_argument) return make_parse_quantity_result(first, parse_invalid_number);
+    return make_parse_quantity_result(r.ptr, r.ec == std::errc() ? parse_ok : parse_out_of_range);
+
+#else
+
+    bool has_digits = false;
+    while(p != last && is_digit(*p)) { ++p; has_digits = true; }
+    if(p != last && *p == '.')
+    {
+        ++p;
+        while(p != last && is_digit(*p)) { ++p; has_digits = true; }
+    }
+    if(!has_digits) return make_parse_quantity_result(first, parse_invalid_number);
+    if(p != last && (*p == 'e' || *p == 'E'))
+    {
+        const char* exponent = p + 1;
+        if(exponent != last && (*exponent == '+' || *exponent == '-')) ++exponent;
+        if(exponent != last && is_digit(*exponent))
+        {
+            p = exponent;
+            while(p != last && is_digit(*p)) ++p;
+        }
+    }
+
+    // strtod needs a terminated string
+    const std::size_t size = static_cast<std::size_t>(p - first);
+    char buffer[64];
+    std::string long_number;
+    const char* str = buffer;
+    if(size < sizeof(buffer))
+    {
+        std::memcpy(buffer, first, size);
+        buffer[size] = '\0';
+    }
+    else
+    {
+        long_number.assign(first, p);
+        str = long_number.c_str();
+    }
+    errno = 0;
+    result = std::strtod(str, 0);
+    return make_parse_quantity_result(p, errno == ERANGE ? parse_out_of_range : parse_ok);
+
+#endif
+}
+
+/// Parses the exponent after a '^', at most two digits.
+inline const char* parse_unit_exponent(const char* first, const char* last, int& result)
+{
+    const char* p = first;
+    const bool negative = p != last && *p == '-';
+    if(p != last && (*p == '-' || *p == '+')) ++p;
+    result = 0;
+    const char* digits = p;
+    while(p != last && is_digit(*p) && p - digits < 2) result = 10 * result + (*p++ - '0');
+    if(p == digits || (p != last && is_digit(*p))) return 0;
+    if(negative) result = -result;
+    return p;
+}
+
+struct unit_prefix
+{
+    const char* symbol;
+    const char* name;
+    double      value;
+};
+
+/// Looks up @c str as a unit of @c registry, first as it is, then as a
+/// prefix followed by the symbol or the name of a unit.  @c prefix is
+/// set to the value of the prefix.
+inline const runtime_unit* find_prefixed_unit(const runtime_unit_registry& registry, const char* str, std::size_t len, double& prefix)
+{
+    prefix = 1.0;
+    if(const runtime_unit* result = registry.find(str, len)) return result;
+
+    // the prefixes of scale.hpp, constant initialized
+    static const unit_prefix prefixes[] = {
+        { "y", "yocto", 1e-24 },
+        { "z", "zepto", 1e-21 },
+        { "a", "atto", 1e-18 },
+        { "f", "femto", 1e-15 },
+        { "p", "pico", 1e-12 },
+        { "n", "nano", 1e-9 },
+        { "u", "micro", 1e-6 },
+        { "m", "milli", 1e-3 },
+        { "c", "centi", 1e-2 },
+        { "d", "deci", 1e-1 },
+        { "da", "deka", 1e1 },
+        { "h", "hecto", 1e2 },
+        { "k", "kilo", 1e3 },
+        { "M", "mega", 1e6 },
+        { "G", "giga", 1e9 },
+        { "T", "tera", 1e12 },
+        { "P", "peta", 1e15 },
+        { "E", "exa", 1e18 },
+        { "Z", "zetta", 1e21 },
+        { "Y", "yotta", 1e24 },
+        { "Ki", "kibi", 1024.0 },
+        { "Mi", "mebi", 1048576.0 },
+        { "Gi", "gibi", 1073741824.0 },
+        { "Ti", "tebi", 1099511627776.0 },
+        { "Pi", "pebi", 1125899906842624.0 },
+        { "Ei", "exbi", 1152921504606846976.0 },
+        { "Zi", "zebi", 1180591620717411303424.0 },
+        { "Yi", "yobi", 1208925819614629174706176.0 }
+    };
+    static const std::size_t count = sizeof(prefixes) / sizeof(prefixes[0]);
+
+    // every prefix that matches is tried, so "dam" is found as
+    // deka meter even though "d" matches too
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const std::size_t size = std::strlen(prefixes[i].symbol);
+        if(len > size && std::memcmp(str, prefixes[i].symbol, size) == 0)
+        {
+            if(const runtime_unit* result = registry.find_symbol(str + size, len - size))
+            {
+                prefix = prefixes[i].value;
+                return result;
+            }
+        }
+    }
+    // the micro sign and the greek letter mu
+    if(len > 2 && (std::memcmp(str, "\xC2\xB5", 2) == 0 || std::memcmp(str, "\xCE\xBC", 2) == 0))
+    {
+        if(const runtime_unit* result = registry.find_symbol(str + 2, len - 2))
+        {
+            prefix = 1e-6;
+            return result;
+        }
+    }
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const std::size_t size = std::strlen(prefixes[i].name);
+        if(len > size && std::memcmp(str, prefixes[i].name, size) == 0)
+        {
+            if(const runtime_unit* result = registry.find_name(str + size, len - size))
+            {
+                prefix = prefixes[i].value;
+                return result;
+            }
+        }
+    }
+    return 0;
+}
+
+} // namespace detail
+
+/// \brief Parses a quantity from <tt>[first, last)</tt> into @c q.
+/// \details The text is a number followed by a product of units, each
+/// optionally raised to an integral power with '^'.  Units are
+/// separated by blanks or '*', and a unit after '/' is divided by,
+/// so "m/s^2", "m s^-2" and "m*s^-2" are the same.  A unit is the
+/// symbol or the name of a unit of @c registry, optionally after the
+/// symbol or the name of an SI or binary prefix.  Parsing stops at the
+/// first character that cannot continue the quantity, such as a comma,
+/// and a number without units is dimensionless.  Symbols containing
+/// blanks or '"' cannot be written.  The offsets of units such as
+/// celsius are not applied, so they convert as differences, like any
+/// other @c quantity.  On error @c q is unchanged.
+template<class Dim, class System, class Y>
+inline parse_quantity_result parse_quantity(const char* first,
+                                            const char* last,
+                                            quantity<unit<Dim, System>, Y>& q,
+                                            const runtime_unit_registry& registry = runtime_unit_registry::builtin())
+{
+    double value = 0.0;
+    parse_quantity_result result = detail::parse_number(first, last, value);
+    if(result.error != parse_ok) return result;
+
+    int exponents[runtime_dimension::size] = { 0 };
+    double factor = 1.0;
+    const char* end = result.ptr;
+    for(;;)
+    {
+        const char* p = detail::skip_blanks(end, last);
+        bool divide = false;
+        const bool has_operator = p != last && (*p == '*' || *p == '/');
+        if(has_operator)
+        {
+            divide = *p == '/';
+            p = detail::skip_blanks(p + 1, last);
+        }
+
+        const char* symbol = p;
+        while(p != last && !detail::ends_unit_symbol(*p)) ++p;
+        if(p == symbol || detail::is_digit(*symbol))
+        {
+            if(has_operator) return detail::make_parse_quantity_result(symbol, parse_invalid_unit);
+            break;
+        }
+
+        double prefix;
+        const runtime_unit* u = detail::find_prefixed_unit(registry, symbol, static_cast<std::size_t>(p - symbol), prefix);
+        if(u == 0) return detail::make_parse_quantity_result(symbol, parse_unknown_unit);
+
+        int exponent = 1;
+        if(p != last && *p == '^')
+        {
+            p = detail::parse_unit_exponent(p + 1, last, exponent);
+            if(p == 0) return detail::make_parse_quantity_result(symbol, parse_invalid_unit);
+        }
+        if(divide) exponent = -exponent;
+
+        for(std::size_t i = 0; i < runtime_dimension::size; ++i)
+            exponents[i] += u->dimension().exponent(i) * exponent;
+        factor *= std::pow(prefix * u->scale(), exponent);
+        end = p;
+    }
+
+    const runtime_dimension target = make_runtime_dimension<Dim>();
+    for(std::size_t i = 0; i < runtime_dimension::size; ++i)
+    {
+        if(exponents[i] != target.exponent(i))
+            return detail::make_parse_quantity_result(end, parse_dimension_mismatch);
+    }
+
+    q = quantity<unit<Dim, System>, Y>::from_value(
+        static_cast<Y>(value * (factor / detail::runtime_reference_factor<Dim, System>::value())));
+    return detail::make_parse_quantity_result(end, parse_ok);
+}
+
+/// Parses all of @c str into @c q.  Text after the quantity is
+/// reported as @c parse_invalid_unit.
+template<class Dim, class System, class Y>
+inline parse_error parse_quantity(const std::string& str,
+                                  quantity<unit<Dim, System>, Y>& q,
+                                  const runtime_unit_registry& registry = runtime_unit_registry::builtin())
+{
+    const char* last = str.data() + str.size();
+    quantity<unit<Dim, System>, Y> result;
+    const parse_quantity_result r = parse_quantity(str.data(), last, result, registry);
+    if(r.error != parse_ok) return r.error;
+    if(detail::skip_blanks(r.ptr, last) != last) return parse_invalid_unit;
+    q = result;
+    return parse_ok;
+}
+
+#ifndef BOOST_NO_CXX11_HDR_SYSTEM_ERROR
+
+#ifdef BOOST_UNITS_HAS_STD_TO_CHARS
+
+/// The result of @c from_chars, as for numbers.
+typedef std::from_chars_result from_chars_result;
+
+#else
+
+/// The result of @c from_chars, as for numbers.
+struct from_chars_result
+{
+    const char* ptr;
+    std::errc ec;
+};
+
+#endif
+
+/// \brief Parses a quantity as @c parse_quantity does, reporting errors
+/// like @c std::from_chars.
+/// \details A number that does not fit is @c std::errc::result_out_of_range,
+/// and every other error, including a unit of the wrong dimension, is
+/// @c std::errc::invalid_argument with @c ptr equal to @c first.
+template<class Dim, class System, class Y>
+inline from_chars_result from_chars(const char* first,
+                                    const char* last,
+                                    quantity<unit<Dim, System>, Y>& q,
+                                    const runtime_unit_registry& registry = runtime_unit_registry::builtin())
+{
+    const parse_quantity_result r = parse_quantity(first, last, q, registry);
+    from_chars_result result = { r.ptr, std::errc() };
+    if(r.error == parse_out_of_range)
+    {
+        result.ec = std::errc::result_out_of_range;
+    }
+    else if(r.error != parse_ok)
+    {
+        result.ptr = first;
+        result.ec = std::errc::invalid_argument;
+    }
+    return result;
+}
+
+#endif // BOOST_NO_CXX11_HDR_SYSTEM_ERROR
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_PARSE_QUANTITY_HPP
@@ -0,0 +1,37 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and 
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_DATA_RATE_DERIVED_DIMENSION_HPP
+#define BOOST_UNITS_DATA_RATE_DERIVED_DIMENSION_HPP
+
+#include <boost/units/derived_dimension.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/rescale.hpp>
+#include <boost/units/unit.hpp>
+#include <boost/units/physical_dimensions/information.hpp>
+#include <boost/units/physical_dimensions/time.hpp>
+
+namespace boost {
+
+namespace units {
+
+/// derived dimension for data rate : information T^-1
+typedef derived_dimension<information_base_dimension,1,
+                          time_base_dimension,-1>::type data_rate_dimension;
+
+/// Integral data rates convert exactly, like amounts of information.
+template<class System1, class System2, class T>
+struct conversion_helper<quantity<unit<data_rate_dimension, System1>, T>,
+                         quantity<unit<data_rate_dimension, System2>, T> > :
+    detail::exact_conversion_helper<unit<data_rate_dimension, System1>, unit<data_rate_dimension, System2>, T>
+{ };
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_DATA_RATE_DERIVED_DIMENSION_HPP
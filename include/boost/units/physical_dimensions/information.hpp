@@ -12,6 +12,9 @@
 
 #include <boost/units/config.hpp>
 #include <boost/units/base_dimension.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/rescale.hpp>
+#include <boost/units/unit.hpp>
 
 namespace boost {
 namespace units { 
@@ -38,6 +41,16 @@ namespace units {
 /// dimension of information
 typedef information_base_dimension::dimension_type information_dimension;
 
+/// Integral amounts of information convert exactly between bits, bytes
+/// and their binary and decimal multiples, rather than through a
+/// floating point factor, and throw @c std::overflow_error if the
+/// result does not fit.
+template<class System1, class System2, class T>
+struct conversion_helper<quantity<unit<information_dimension, System1>, T>,
+                         quantity<unit<information_dimension, System2>, T> > :
+    detail::exact_conversion_helper<unit<information_dimension, System1>, unit<information_dimension, System2>, T>
+{ };
+
 } // namespace units
 } // namespace boost
 
@@ -0,0 +1,41 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and 
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_OPERATION_BASE_DIMENSION_HPP
+#define BOOST_UNITS_OPERATION_BASE_DIMENSION_HPP
+
+#include <boost/units/config.hpp>
+#include <boost/units/base_dimension.hpp>
+
+namespace boost {
+namespace units { 
+
+/// Counts of operations, such as I/O requests.
+struct operation_base_dimension : 
+    boost::units::base_dimension<operation_base_dimension, -710>
+{ };
+
+} // namespace units
+} // namespace boost
+
+#if BOOST_UNITS_HAS_BOOST_TYPEOF
+
+#include BOOST_TYPEOF_INCREMENT_REGISTRATION_GROUP()
+
+BOOST_TYPEOF_REGISTER_TYPE(boost::units::operation_base_dimension)
+
+#endif
+
+namespace boost {
+namespace units {
+
+typedef operation_base_dimension::dimension_type operation_dimension;
+
+} // namespace units
+} // namespace boost
+
+#endif
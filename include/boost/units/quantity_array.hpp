@@ -0,0 +1,393 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_QUANTITY_ARRAY_HPP
+#define BOOST_UNITS_QUANTITY_ARRAY_HPP
+
+///
+/// \file
+/// \brief Contiguous storage of quantities as raw values.
+/// \details @c quantity_array owns a contiguous block of @c Y and
+///   @c quantity_span is a non-owning view of one.  Both give
+///   unit-typed element access while exposing the underlying
+///   @c Y* without a copy, so the values can be handed directly
+///   to numeric code that knows nothing about units.
+///
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/config.hpp>
+#include <boost/assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/units/quantity.hpp>
+#include <boost/units/units_fwd.hpp>
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+/// Proxy returned by mutable element access.  Reads and writes
+/// go straight to the underlying @c Y, so no quantity object is
+/// ever materialized in the storage.
+template<class Unit, class Y>
+class quantity_reference
+{
+    public:
+        typedef quantity<Unit, Y>   value_type;
+
+        explicit quantity_reference(Y& val) : ptr_(&val) { }
+
+        operator value_type() const { return value_type::from_value(*ptr_); }
+
+        value_type get() const { return value_type::from_value(*ptr_); }
+        Y& value() const { return *ptr_; }
+
+        const quantity_reference& operator=(const value_type& source) const
+        {
+            *ptr_ = source.value();
+            return *this;
+        }
+
+        const quantity_reference& operator=(const quantity_reference& source) const
+        {
+            *ptr_ = *source.ptr_;
+            return *this;
+        }
+
+        const quantity_reference& operator+=(const value_type& source) const
+        {
+            *ptr_ += source.value();
+            return *this;
+        }
+
+        const quantity_reference& operator-=(const value_type& source) const
+        {
+            *ptr_ -= source.value();
+            return *this;
+        }
+
+        const quantity_reference& operator*=(const Y& source) const
+        {
+            *ptr_ *= source;
+            return *this;
+        }
+
+        const quantity_reference& operator/=(const Y& source) const
+        {
+            *ptr_ /= source;
+            return *this;
+        }
+
+        // Found only by ADL on the proxy, so that comparisons with
+        // a quantity pick up the conversion to value_type.
+        friend bool operator==(const value_type& lhs, const value_type& rhs) { return lhs.value() == rhs.value(); }
+        friend bool operator!=(const value_type& lhs, const value_type& rhs) { return lhs.value() != rhs.value(); }
+        friend bool operator<(const value_type& lhs, const value_type& rhs) { return lhs.value() < rhs.value(); }
+        friend bool operator<=(const value_type& lhs, const value_type& rhs) { return lhs.value() <= rhs.value(); }
+        friend bool operator>(const value_type& lhs, const value_type& rhs) { return lhs.value() > rhs.value(); }
+        friend bool operator>=(const value_type& lhs, const value_type& rhs) { return lhs.value() >= rhs.value(); }
+
+    private:
+        Y* ptr_;
+};
+
+template<class Unit, class Y>
+struct quantity_reference_type
+{
+    typedef quantity_reference<Unit, Y> type;
+    static type make(Y& val) { return type(val); }
+};
+
+template<class Unit, class Y>
+struct quantity_reference_type<Unit, const Y>
+{
+    typedef quantity<Unit, Y> type;
+    static type make(const Y& val) { return type::from_value(val); }
+};
+
+/// Random access iterator over raw values yielding quantities.
+template<class Unit, class Y>
+class quantity_iterator
+{
+    public:
+        typedef std::random_access_iterator_tag                 iterator_category;
+        typedef quantity<Unit, typename remove_const<Y>::type>  value_type;
+        typedef std::ptrdiff_t                                  difference_type;
+        typedef typename quantity_reference_type<Unit, Y>::type reference;
+        typedef void                                            pointer;
+
+        quantity_iterator() : ptr_(0) { }
+        explicit quantity_iterator(Y* ptr) : ptr_(ptr) { }
+
+        /// mutable iterators are convertible to const iterators
+        template<class YY>
+        quantity_iterator(const quantity_iterator<Unit, YY>& other,
+            typename boost::enable_if_c<is_same<const YY, Y>::value>::type* = 0) :
+            ptr_(other.base())
+        { }
+
+        Y* base() const { return ptr_; }
+
+        reference operator*() const { return quantity_reference_type<Unit, Y>::make(*ptr_); }
+        reference operator[](difference_type n) const { return quantity_reference_type<Unit, Y>::make(ptr_[n]); }
+
+        quantity_iterator& operator++() { ++ptr_; return *this; }
+        quantity_iterator& operator--() { --ptr_; return *this; }
+        quantity_iterator operator++(int) { quantity_iterator result(*this); ++ptr_; return result; }
+        quantity_iterator operator--(int) { quantity_iterator result(*this); --ptr_; return result; }
+        quantity_iterator& operator+=(difference_type n) { ptr_ += n; return *this; }
+        quantity_iterator& operator-=(difference_type n) { ptr_ -= n; return *this; }
+
+        friend quantity_iterator operator+(quantity_iterator it, difference_type n) { return it += n; }
+        friend quantity_iterator operator+(difference_type n, quantity_iterator it) { return it += n; }
+        friend quantity_iterator operator-(quantity_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const quantity_iterator& lhs, const quantity_iterator& rhs) { return lhs.ptr_ - rhs.ptr_; }
+
+        friend bool operator==(const quantity_iterator& lhs, const quantity_iterator& rhs) { return lhs.ptr_ == rhs.ptr_; }
+        friend bool operator!=(const quantity_iterator& lhs, const quantity_iterator& rhs) { return lhs.ptr_ != rhs.ptr_; }
+        friend bool operator<(const quantity_iterator& lhs, const quantity_iterator& rhs) { return lhs.ptr_ < rhs.ptr_; }
+        friend bool operator>(const quantity_iterator& lhs, const quantity_iterator& rhs) { return lhs.ptr_ > rhs.ptr_; }
+        friend bool operator<=(const quantity_iterator& lhs, const quantity_iterator& rhs) { return lhs.ptr_ <= rhs.ptr_; }
+        friend bool operator>=(const quantity_iterator& lhs, const quantity_iterator& rhs) { return lhs.ptr_ >= rhs.ptr_; }
+
+    private:
+        Y* ptr_;
+};
+
+} // namespace detail
+
+template<class Expr>
+class quantity_expression;
+
+/// A non-owning view of @c size() contiguous values of type @c Y, each of
+/// which is interpreted as a @c quantity<Unit,Y>.  Use a const-qualified
+/// @c Y for a read-only view, e.g. @c quantity_span<si::length, const double>.
+template<class Unit, class Y>
+class quantity_span
+{
+    public:
+        typedef quantity_span<Unit, Y>                                      this_type;
+        typedef Unit                                                        unit_type;
+        typedef Y                                                           element_type;
+        typedef typename remove_const<Y>::type                              raw_value_type;
+        typedef quantity<Unit, raw_value_type>                              value_type;
+        typedef std::size_t                                                 size_type;
+        typedef std::ptrdiff_t                                              difference_type;
+        typedef typename detail::quantity_reference_type<Unit, Y>::type     reference;
+        typedef value_type                                                  const_reference;
+        typedef detail::quantity_iterator<Unit, Y>                          iterator;
+        typedef detail::quantity_iterator<Unit, const raw_value_type>       const_iterator;
+
+        BOOST_CONSTEXPR quantity_span() : data_(0), size_(0) { }
+        BOOST_CONSTEXPR quantity_span(Y* data, size_type size) : data_(data), size_(size) { }
+
+        /// a mutable span is implicitly convertible to a read-only span
+        template<class YY>
+        BOOST_CONSTEXPR quantity_span(const quantity_span<Unit, YY>& other,
+            typename boost::enable_if_c<is_same<const YY, Y>::value>::type* = 0) :
+            data_(other.data()), size_(other.size())
+        { }
+
+        /// writes the elements of @c expr, which must have the size
+        /// of the span, to the viewed values; see quantity_expression.hpp
+        template<class Expr>
+        this_type& operator=(const quantity_expression<Expr>& expr)
+        {
+            expr.evaluate(*this);
+            return *this;
+        }
+
+        /// direct access to the raw values
+        BOOST_CONSTEXPR Y* data() const { return data_; }
+        BOOST_CONSTEXPR size_type size() const { return size_; }
+        BOOST_CONSTEXPR bool empty() const { return size_ == 0; }
+
+        reference operator[](size_type i) const
+        {
+            BOOST_ASSERT(i < size_);
+            return detail::quantity_reference_type<Unit, Y>::make(data_[i]);
+        }
+
+        /// bounds-checked element access, throws @c std::out_of_range
+        reference at(size_type i) const
+        {
+            if(i >= size_) throw std::out_of_range("boost::units::quantity_span::at");
+            return detail::quantity_reference_type<Unit, Y>::make(data_[i]);
+        }
+
+        reference front() const { return (*this)[0]; }
+        reference back() const { return (*this)[size_ - 1]; }
+
+        iterator begin() const { return iterator(data_); }
+        iterator end() const { return iterator(data_ + size_); }
+
+        /// the view of @c count elements starting at @c offset
+        this_type subspan(size_type offset, size_type count) const
+        {
+            BOOST_ASSERT(offset + count <= size_);
+            return this_type(data_ + offset, count);
+        }
+
+    private:
+        Y*          data_;
+        size_type   size_;
+};
+
+/// An owning, allocator-aware, contiguous container of quantities.
+/// Elements are stored as plain @c Y, so @c data() can be passed to
+/// numeric libraries without a copy or a cast.
+template<class Unit, class Y = double, class Allocator = std::allocator<Y> >
+class quantity_array
+{
+    private:
+        typedef std::vector<Y, Allocator>                       storage_type;
+    public:
+        typedef quantity_array<Unit, Y, Allocator>              this_type;
+        typedef Unit                                            unit_type;
+        typedef Y                                               raw_value_type;
+        typedef quantity<Unit, Y>                               value_type;
+        typedef Allocator                                       allocator_type;
+        typedef typename storage_type::size_type                size_type;
+        typedef typename storage_type::difference_type          difference_type;
+        typedef detail::quantity_reference<Unit, Y>             reference;
+        typedef value_type                                      const_reference;
+        typedef detail::quantity_iterator<Unit, Y>              iterator;
+        typedef detail::quantity_iterator<Unit, const Y>        const_iterator;
+        typedef quantity_span<Unit, Y>                          span_type;
+        typedef quantity_span<Unit, const Y>                    const_span_type;
+
+        quantity_array() { }
+        explicit quantity_array(const allocator_type& alloc) : values_(alloc) { }
+        explicit quantity_array(size_type n, const value_type& q = value_type(), const allocator_type& alloc = allocator_type()) :
+            values_(n, q.value(), alloc)
+        { }
+        /// construct from a range of quantities
+        template<class Iterator>
+        quantity_array(Iterator first, Iterator last, const allocator_type& alloc = allocator_type()) :
+            values_(alloc)
+        {
+            assign(first, last);
+        }
+        /// construct from the elements of an expression; see quantity_expression.hpp
+        template<class Expr>
+        quantity_array(const quantity_expression<Expr>& expr, const allocator_type& alloc = allocator_type()) :
+            values_(expr.size(), Y(), alloc)
+        {
+            expr.evaluate(span());
+        }
+
+        /// Evaluate @c expr into this array, which may be one of its operands.
+        /// If the size changes the result is computed into new storage first.
+        template<class Expr>
+        this_type& operator=(const quantity_expression<Expr>& expr)
+        {
+            if(expr.size() == size())
+            {
+                expr.evaluate(span());
+            }
+            else
+            {
+                this_type result(expr, get_allocator());
+                swap(result);
+            }
+            return *this;
+        }
+
+        template<class Iterator>
+        void assign(Iterator first, Iterator last)
+        {
+            values_.clear();
+            for(; first != last; ++first) push_back(*first);
+        }
+
+        allocator_type get_allocator() const { return values_.get_allocator(); }
+
+        size_type size() const { return values_.size(); }
+        bool empty() const { return values_.empty(); }
+        size_type capacity() const { return values_.capacity(); }
+        void reserve(size_type n) { values_.reserve(n); }
+        void resize(size_type n, const value_type& q = value_type()) { values_.resize(n, q.value()); }
+        void clear() { values_.clear(); }
+        void swap(this_type& other) { values_.swap(other.values_); }
+
+        void push_back(const value_type& q) { values_.push_back(q.value()); }
+        void pop_back() { values_.pop_back(); }
+
+        reference operator[](size_type i) { return reference(values_[i]); }
+        const_reference operator[](size_type i) const { return value_type::from_value(values_[i]); }
+
+        /// bounds-checked element access, throws @c std::out_of_range
+        reference at(size_type i) { return reference(values_.at(i)); }
+        const_reference at(size_type i) const { return value_type::from_value(values_.at(i)); }
+
+        reference front() { return reference(values_.front()); }
+        const_reference front() const { return value_type::from_value(values_.front()); }
+        reference back() { return reference(values_.back()); }
+        const_reference back() const { return value_type::from_value(values_.back()); }
+
+        /// direct access to the raw values
+        Y* data() { return values_.empty() ? 0 : &values_[0]; }
+        const Y* data() const { return values_.empty() ? 0 : &values_[0]; }
+
+        iterator begin() { return iterator(data()); }
+        iterator end() { return iterator(data() + size()); }
+        const_iterator begin() const { return const_iterator(data()); }
+        const_iterator end() const { return const_iterator(data() + size()); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        span_type span() { return span_type(data(), size()); }
+        const_span_type span() const { return const_span_type(data(), size()); }
+
+        operator span_type() { return span(); }
+        operator const_span_type() const { return span(); }
+
+    private:
+        storage_type values_;
+};
+
+template<class Unit, class Y, class Allocator>
+inline void swap(quantity_array<Unit, Y, Allocator>& lhs, quantity_array<Unit, Y, Allocator>& rhs)
+{
+    lhs.swap(rhs);
+}
+
+/// create a view of @c size raw values as quantities of @c Unit
+template<class Unit, class Y>
+inline BOOST_CONSTEXPR quantity_span<Unit, Y> make_quantity_span(const Unit&, Y* data, std::size_t size)
+{
+    return quantity_span<Unit, Y>(data, size);
+}
+
+/// create a mutable view of a @c quantity_array
+template<class Unit, class Y, class Allocator>
+inline quantity_span<Unit, Y> make_quantity_span(quantity_array<Unit, Y, Allocator>& arr)
+{
+    return arr.span();
+}
+
+/// create a read-only view of a @c quantity_array
+template<class Unit, class Y, class Allocator>
+inline quantity_span<Unit, const Y> make_quantity_span(const quantity_array<Unit, Y, Allocator>& arr)
+{
+    return arr.span();
+}
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_QUANTITY_ARRAY_HPP
@@ -0,0 +1,346 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_QUANTITY_COLUMN_HPP
+#define BOOST_UNITS_QUANTITY_COLUMN_HPP
+
+///
+/// \file
+/// \brief A binary format for arrays of quantities.
+/// \details A quantity column is a header of
+///   @c quantity_column_header::size bytes describing the unit and the
+///   value type, followed by the values, little-endian and without
+///   padding.  The unit is recorded as a @c runtime_dimension and the
+///   factor to the coherent unit of the reference system of
+///   @c runtime_unit, so a column can be read as a quantity of any
+///   unit with the same dimension.  As the values start at a multiple
+///   of 64 bytes, a column mapped into memory can be used in place.
+///
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/predef/other/endian.h>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_signed.hpp>
+
+#include <boost/units/quantity.hpp>
+#include <boost/units/runtime_quantity.hpp>
+#include <boost/units/runtime_unit.hpp>
+#include <boost/units/unit.hpp>
+
+namespace boost {
+
+namespace units {
+
+/// \enum column_value_kind representation of the values of a column.
+enum column_value_kind
+{
+    column_float = 1,       /// IEEE 754 binary floating point.
+    column_signed = 2,      /// two's complement integers.
+    column_unsigned = 3     /// unsigned integers.
+};
+
+namespace detail {
+
+template<class Y,
+         bool IsFloat = boost::is_floating_point<Y>::value,
+         bool IsIntegral = boost::is_integral<Y>::value>
+struct column_value_traits
+{
+    BOOST_STATIC_ASSERT_MSG(IsFloat || IsIntegral, "quantity columns only hold arithmetic values");
+};
+
+template<class Y>
+struct column_value_traits<Y, true, false>
+{
+    BOOST_STATIC_ASSERT_MSG(std::numeric_limits<Y>::is_iec559 && (sizeof(Y) == 4 || sizeof(Y) == 8),
+        "quantity columns only hold 32 and 64 bit IEEE 754 floating point values");
+    static const column_value_kind kind = column_float;
+};
+
+template<class Y>
+struct column_value_traits<Y, false, true>
+{
+    static const column_value_kind kind = boost::is_signed<Y>::value ? column_signed : column_unsigned;
+};
+
+inline void store_little_endian(char* out, boost::uint64_t value, std::size_t size)
+{
+    for(std::size_t i = 0; i < size; ++i)
+        out[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+inline boost::uint64_t load_little_endian(const char* in, std::size_t size)
+{
+    boost::uint64_t result = 0;
+    for(std::size_t i = 0; i < size; ++i)
+        result |= static_cast<boost::uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    return result;
+}
+
+/// Converts @c count values of @c size bytes between the native byte
+/// order and little-endian, which is the same in both directions.
+inline void swap_to_little_endian(char* values, std::size_t count, std::size_t size)
+{
+#if BOOST_ENDIAN_LITTLE_BYTE
+    static_cast<void>(values);
+    static_cast<void>(count);
+    static_cast<void>(size);
+#else
+    for(std::size_t i = 0; i < count; ++i, values += size)
+        std::reverse(values, values + size);
+#endif
+}
+
+} // namespace detail
+
+/// The header of a quantity column.  Its encoding is
+///
+///     bytes  0-5   "BUQCOL"
+///     bytes  6-7   format version
+///     bytes  8-15  the packed runtime_dimension
+///     bytes 16-23  the factor to the reference unit, as a double
+///     byte  24     the column_value_kind
+///     byte  25     the size of a value in bytes
+///     bytes 32-39  the number of values
+///
+/// with integers and doubles little-endian and the other bytes zero.
+class quantity_column_header
+{
+    public:
+        /// size of an encoded header, and the offset of the values
+        BOOST_STATIC_CONSTANT(std::size_t, size = 64);
+        /// version of the format written
+        BOOST_STATIC_CONSTANT(unsigned, version = 1);
+
+        quantity_column_header() :
+            scale_(1.0),
+            kind_(column_float),
+            value_size_(sizeof(double)),
+            count_(0)
+        { }
+
+        quantity_column_header(const runtime_dimension& dimension,
+                               double scale,
+                               column_value_kind kind,
+                               std::size_t value_size,
+                               boost::uint64_t count) :
+            dimension_(dimension),
+            scale_(scale),
+            kind_(kind),
+            value_size_(value_size),
+            count_(count)
+        { }
+
+        const runtime_dimension& dimension() const { return dimension_; }
+        /// the factor from a value to the coherent unit of the reference system
+        double scale() const { return scale_; }
+        column_value_kind value_kind() const { return kind_; }
+        std::size_t value_size() const { return value_size_; }
+        boost::uint64_t count() const { return count_; }
+
+        /// Writes the header to the @c size bytes at @c out.
+        void encode(char* out) const
+        {
+            std::memset(out, 0, size);
+            std::memcpy(out, magic(), 6);
+            detail::store_little_endian(out + 6, version, 2);
+            detail::store_little_endian(out + 8, dimension_.packed(), 8);
+            boost::uint64_t scale_bits;
+            std::memcpy(&scale_bits, &scale_, sizeof(scale_bits));
+            detail::store_little_endian(out + 16, scale_bits, 8);
+            out[24] = static_cast<char>(kind_);
+            out[25] = static_cast<char>(value_size_);
+            detail::store_little_endian(out + 32, count_, 8);
+        }
+
+        /// Reads a header from the @c size bytes at @c in.  Throws
+        /// @c std::runtime_error if they are not the header of a
+        /// quantity column of a known version and value type.
+        static quantity_column_header decode(const char* in)
+        {
+            if(std::memcmp(in, magic(), 6) != 0)
+                throw std::runtime_error("boost::units::quantity_column_header: not a quantity column");
+            if(detail::load_little_endian(in + 6, 2) != version)
+                throw std::runtime_error("boost::units::quantity_column_header: unknown version");
+
+            const boost::uint64_t packed = detail::load_little_endian(in + 8, 8);
+            if(packed >> (runtime_dimension::bits * runtime_dimension::size) != 0)
+                throw std::runtime_error("boost::units::quantity_column_header: invalid dimension");
+
+            const boost::uint64_t scale_bits = detail::load_little_endian(in + 16, 8);
+            double scale;
+            std::memcpy(&scale, &scale_bits, sizeof(scale));
+
+            const unsigned kind = static_cast<unsigned char>(in[24]);
+            const std::size_t value_size = static_cast<unsigned char>(in[25]);
+            const bool valid_type =
+                kind == column_float ? (value_size == 4 || value_size == 8) :
+                (kind == column_signed || kind == column_unsigned) &&
+                    (value_size == 1 || value_size == 2 || value_size == 4 || value_size == 8);
+            if(!valid_type)
+                throw std::runtime_error("boost::units::quantity_column_header: unknown value type");
+
+            return quantity_column_header(runtime_dimension::from_packed(packed),
+                                          scale,
+                                          static_cast<column_value_kind>(kind),
+                                          value_size,
+                                          detail::load_little_endian(in + 32, 8));
+        }
+
+    private:
+        static const char* magic() { return "BUQCOL"; }
+
+        runtime_dimension   dimension_;
+        double              scale_;
+        column_value_kind   kind_;
+        std::size_t         value_size_;
+        boost::uint64_t     count_;
+};
+
+/// The header of a column of @c count values of type @c Y in @c Unit.
+template<class Unit, class Y>
+inline quantity_column_header make_quantity_column_header(boost::uint64_t count)
+{
+    typedef typename Unit::dimension_type dimension_type;
+    typedef typename Unit::system_type system_type;
+    return quantity_column_header(make_runtime_dimension<dimension_type>(),
+                                  detail::runtime_reference_factor<dimension_type, system_type>::value(),
+                                  detail::column_value_traits<Y>::kind,
+                                  sizeof(Y),
+                                  count);
+}
+
+namespace detail {
+
+/// The number of values converted at a time.
+const std::size_t column_chunk_size = 512;
+
+template<class S, class Y>
+void convert_column_values(const char* in, std::size_t count, double factor, Y* out)
+{
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        S value;
+        std::memcpy(&value, in + i * sizeof(S), sizeof(S));
+        out[i] = factor == 1.0 ? static_cast<Y>(value) : static_cast<Y>(value * factor);
+    }
+}
+
+/// The conversion from the values of a column to @c Y.
+template<class Y>
+struct column_converter
+{
+    typedef void (*type)(const char*, std::size_t, double, Y*);
+
+    static type select(const quantity_column_header& header)
+    {
+        switch(header.value_kind())
+        {
+            case column_float:
+                return header.value_size() == 4 ? &convert_column_values<float, Y> : &convert_column_values<double, Y>;
+            case column_signed:
+                switch(header.value_size())
+                {
+                    case 1: return &convert_column_values<boost::int8_t, Y>;
+                    case 2: return &convert_column_values<boost::int16_t, Y>;
+                    case 4: return &convert_column_values<boost::int32_t, Y>;
+                    default: return &convert_column_values<boost::int64_t, Y>;
+                }
+            default:
+                switch(header.value_size())
+                {
+                    case 1: return &convert_column_values<boost::uint8_t, Y>;
+                    case 2: return &convert_column_values<boost::uint16_t, Y>;
+                    case 4: return &convert_column_values<boost::uint32_t, Y>;
+                    default: return &convert_column_values<boost::uint64_t, Y>;
+                }
+        }
+    }
+};
+
+} // namespace detail
+
+/// Writes @c count quantities as a column.
+template<class Unit, class Y>
+inline void write_quantity_column(std::ostream& os, const quantity<Unit, Y>* values, std::size_t count)
+{
+    char header[quantity_column_header::size];
+    make_quantity_column_header<Unit, Y>(count).encode(header);
+    os.write(header, sizeof(header));
+
+    Y buffer[detail::column_chunk_size];
+    for(std::size_t i = 0; i < count; )
+    {
+        const std::size_t n = (std::min)(count - i, detail::column_chunk_size);
+        for(std::size_t j = 0; j < n; ++j)
+            buffer[j] = values[i + j].value();
+        detail::swap_to_little_endian(reinterpret_cast<char*>(buffer), n, sizeof(Y));
+        os.write(reinterpret_cast<const char*>(buffer), static_cast<std::streamsize>(n * sizeof(Y)));
+        i += n;
+    }
+}
+
+/// Writes a vector of quantities as a column.
+template<class Unit, class Y, class Alloc>
+inline void write_quantity_column(std::ostream& os, const std::vector<quantity<Unit, Y>, Alloc>& values)
+{
+    write_quantity_column(os, values.empty() ? 0 : &values[0], values.size());
+}
+
+/// \brief Reads a column into @c result, replacing its contents.
+/// \details The column may have any unit with the dimension of @c Unit
+/// and any value type; its values are converted as @c static_cast
+/// and multiplied by the conversion factor if the units differ.
+/// Throws @c std::domain_error if the dimensions differ and
+/// @c std::runtime_error if the input is not a complete column.
+template<class Unit, class Y, class Alloc>
+inline void read_quantity_column(std::istream& is, std::vector<quantity<Unit, Y>, Alloc>& result)
+{
+    char bytes[quantity_column_header::size];
+    if(!is.read(bytes, sizeof(bytes)))
+        throw std::runtime_error("boost::units::read_quantity_column: truncated header");
+    const quantity_column_header header = quantity_column_header::decode(bytes);
+    const quantity_column_header target = make_quantity_column_header<Unit, Y>(header.count());
+    if(header.dimension() != target.dimension())
+        throw std::domain_error("boost::units::read_quantity_column: the column has a different dimension");
+
+    const typename detail::column_converter<Y>::type convert = detail::column_converter<Y>::select(header);
+    const double factor = header.scale() / target.scale();
+
+    result.clear();
+    char buffer[detail::column_chunk_size * 8];
+    Y values[detail::column_chunk_size];
+    for(boost::uint64_t remaining = header.count(); remaining != 0; )
+    {
+        const std::size_t n = static_cast<std::size_t>((std::min)(remaining, static_cast<boost::uint64_t>(detail::column_chunk_size)));
+        if(!is.read(buffer, static_cast<std::streamsize>(n * header.value_size())))
+            throw std::runtime_error("boost::units::read_quantity_column: truncated values");
+        detail::swap_to_little_endian(buffer, n, header.value_size());
+        convert(buffer, n, factor, values);
+        for(std::size_t i = 0; i < n; ++i)
+            result.push_back(quantity<Unit, Y>::from_value(values[i]));
+        remaining -= n;
+    }
+}
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_QUANTITY_COLUMN_HPP
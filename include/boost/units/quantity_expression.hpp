@@ -0,0 +1,365 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_QUANTITY_EXPRESSION_HPP
+#define BOOST_UNITS_QUANTITY_EXPRESSION_HPP
+
+///
+/// \file
+/// \brief Lazy elementwise arithmetic on arrays of quantities.
+/// \details The operators @c +, @c -, @c * and @c / applied to a
+///   @c quantity_array or @c quantity_span, and to a quantity or a
+///   scalar, build a @c quantity_expression instead of computing a new
+///   array.  The unit of every node is deduced at compile time with the
+///   typeof helpers of operators.hpp, so an expression whose units do not
+///   match does not compile, just as for single quantities.  Assigning
+///   the expression to an array or a span evaluates the whole expression
+///   in one loop over the raw values, with no temporary arrays.
+///
+///   An expression refers to the arrays it was built from, so it must be
+///   evaluated before they are changed or destroyed.
+///
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/units/operators.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/quantity_array.hpp>
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+/// The values of an array or span in an expression.
+template<class Unit, class Y>
+class quantity_expression_range
+{
+    public:
+        typedef quantity<Unit, Y>   result_type;
+        typedef Y                   value_type;
+
+        BOOST_STATIC_CONSTANT(bool, is_range = true);
+
+        quantity_expression_range(const Y* data, std::size_t size) : data_(data), size_(size) { }
+
+        std::size_t size() const { return size_; }
+        const Y& value(std::size_t i) const { return data_[i]; }
+
+    private:
+        const Y*    data_;
+        std::size_t size_;
+};
+
+/// A quantity or a scalar, which is the same for every element.
+/// @c T is the quantity or the scalar type and @c Y its value type.
+template<class T, class Y>
+class quantity_expression_scalar
+{
+    public:
+        typedef T   result_type;
+        typedef Y   value_type;
+
+        BOOST_STATIC_CONSTANT(bool, is_range = false);
+
+        explicit quantity_expression_scalar(const Y& val) : value_(val) { }
+
+        std::size_t size() const { return 0; }
+        const Y& value(std::size_t) const { return value_; }
+
+    private:
+        Y   value_;
+};
+
+struct quantity_expression_plus
+{
+    template<class X, class Y>
+    struct result { typedef typename add_typeof_helper<X, Y>::type type; };
+
+    template<class X, class Y>
+    static typename add_typeof_helper<X, Y>::type apply(const X& x, const Y& y) { return x + y; }
+};
+
+struct quantity_expression_minus
+{
+    template<class X, class Y>
+    struct result { typedef typename subtract_typeof_helper<X, Y>::type type; };
+
+    template<class X, class Y>
+    static typename subtract_typeof_helper<X, Y>::type apply(const X& x, const Y& y) { return x - y; }
+};
+
+struct quantity_expression_multiplies
+{
+    template<class X, class Y>
+    struct result { typedef typename multiply_typeof_helper<X, Y>::type type; };
+
+    template<class X, class Y>
+    static typename multiply_typeof_helper<X, Y>::type apply(const X& x, const Y& y) { return x * y; }
+};
+
+struct quantity_expression_divides
+{
+    template<class X, class Y>
+    struct result { typedef typename divide_typeof_helper<X, Y>::type type; };
+
+    template<class X, class Y>
+    static typename divide_typeof_helper<X, Y>::type apply(const X& x, const Y& y) { return x / y; }
+};
+
+/// @c Op applied to each pair of elements of @c L and @c R.  The result
+/// type is that of @c Op applied to a single quantity of each, so that
+/// mismatched units are caught here, when the node is built.
+template<class Op, class L, class R>
+class quantity_expression_binary
+{
+    public:
+        typedef typename Op::template result<
+            typename L::result_type,
+            typename R::result_type
+        >::type                                     result_type;
+        typedef typename result_type::value_type    value_type;
+
+        BOOST_STATIC_CONSTANT(bool, is_range = (L::is_range || R::is_range));
+
+        quantity_expression_binary(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs)
+        {
+            BOOST_ASSERT(!L::is_range || !R::is_range || lhs.size() == rhs.size());
+        }
+
+        std::size_t size() const { return L::is_range ? lhs_.size() : rhs_.size(); }
+        value_type value(std::size_t i) const { return Op::apply(lhs_.value(i), rhs_.value(i)); }
+
+    private:
+        L   lhs_;
+        R   rhs_;
+};
+
+template<class E>
+class quantity_expression_negate
+{
+    public:
+        typedef typename unary_minus_typeof_helper<typename E::result_type>::type  result_type;
+        typedef typename result_type::value_type                                    value_type;
+
+        BOOST_STATIC_CONSTANT(bool, is_range = E::is_range);
+
+        explicit quantity_expression_negate(const E& expr) : expr_(expr) { }
+
+        std::size_t size() const { return expr_.size(); }
+        value_type value(std::size_t i) const { return -expr_.value(i); }
+
+    private:
+        E   expr_;
+};
+
+} // namespace detail
+
+/// \brief A lazily evaluated elementwise expression over arrays of
+///   quantities.
+/// \details Elements are computed only when the expression is assigned
+///   to a @c quantity_array or @c quantity_span, or when they are
+///   accessed with @c operator[].
+template<class Expr>
+class quantity_expression
+{
+    public:
+        typedef Expr                                        expression_type;
+        typedef typename Expr::result_type::unit_type       unit_type;
+        typedef typename Expr::value_type                   raw_value_type;
+        typedef quantity<unit_type, raw_value_type>         value_type;
+        typedef std::size_t                                 size_type;
+
+        explicit quantity_expression(const Expr& expr) : expr_(expr) { }
+
+        const Expr& expression() const { return expr_; }
+
+        size_type size() const { return expr_.size(); }
+
+        value_type operator[](size_type i) const
+        {
+            BOOST_ASSERT(i < size());
+            return value_type::from_value(expr_.value(i));
+        }
+
+        /// \brief Writes every element to @c out in a single loop.
+        /// \details @c out must have the size of the expression and
+        /// its unit, and may be one of the arrays in the expression.
+        template<class Unit, class Y>
+        void evaluate(const quantity_span<Unit, Y>& out) const
+        {
+            BOOST_STATIC_ASSERT_MSG((is_same<Unit, unit_type>::value),
+                "the expression must have the unit of the destination");
+            BOOST_ASSERT(out.size() == size());
+            const Expr expr(expr_);
+            Y* const data = out.data();
+            const size_type n = size();
+            for(size_type i = 0; i < n; ++i)
+                data[i] = static_cast<Y>(expr.value(i));
+        }
+
+    private:
+        Expr    expr_;
+};
+
+namespace detail {
+
+/// How each kind of operand enters an expression.  Only arrays, spans
+/// and expressions are ranges; quantities and arithmetic scalars apply
+/// to every element.
+template<class T, class Enable = void>
+struct quantity_expression_operand
+{
+    BOOST_STATIC_CONSTANT(bool, is_operand = false);
+    BOOST_STATIC_CONSTANT(bool, is_range = false);
+};
+
+template<class Expr>
+struct quantity_expression_operand<quantity_expression<Expr> >
+{
+    BOOST_STATIC_CONSTANT(bool, is_operand = true);
+    BOOST_STATIC_CONSTANT(bool, is_range = true);
+    typedef Expr type;
+    static const type& make(const quantity_expression<Expr>& expr) { return expr.expression(); }
+};
+
+template<class Unit, class Y, class Allocator>
+struct quantity_expression_operand<quantity_array<Unit, Y, Allocator> >
+{
+    BOOST_STATIC_CONSTANT(bool, is_operand = true);
+    BOOST_STATIC_CONSTANT(bool, is_range = true);
+    typedef quantity_expression_range<Unit, Y> type;
+    static type make(const quantity_array<Unit, Y, Allocator>& arr) { return type(arr.data(), arr.size()); }
+};
+
+template<class Unit, class Y>
+struct quantity_expression_operand<quantity_span<Unit, Y> >
+{
+    BOOST_STATIC_CONSTANT(bool, is_operand = true);
+    BOOST_STATIC_CONSTANT(bool, is_range = true);
+    typedef quantity_expression_range<Unit, typename remove_const<Y>::type> type;
+    static type make(const quantity_span<Unit, Y>& span) { return type(span.data(), span.size()); }
+};
+
+template<class Unit, class Y>
+struct quantity_expression_operand<quantity<Unit, Y> >
+{
+    BOOST_STATIC_CONSTANT(bool, is_operand = true);
+    BOOST_STATIC_CONSTANT(bool, is_range = false);
+    typedef quantity_expression_scalar<quantity<Unit, Y>, Y> type;
+    static type make(const quantity<Unit, Y>& q) { return type(q.value()); }
+};
+
+template<class T>
+struct quantity_expression_operand<T, typename boost::enable_if<is_arithmetic<T> >::type>
+{
+    BOOST_STATIC_CONSTANT(bool, is_operand = true);
+    BOOST_STATIC_CONSTANT(bool, is_range = false);
+    typedef quantity_expression_scalar<T, T> type;
+    static type make(const T& x) { return type(x); }
+};
+
+/// Empty unless one of @c L and @c R is a range and the other an
+/// operand, which keeps the operators below away from everything else.
+template<class Op, class L, class R,
+         bool Enable = (quantity_expression_operand<L>::is_operand &&
+                        quantity_expression_operand<R>::is_operand &&
+                        (quantity_expression_operand<L>::is_range || quantity_expression_operand<R>::is_range))>
+struct quantity_expression_binary_result { };
+
+template<class Op, class L, class R>
+struct quantity_expression_binary_result<Op, L, R, true>
+{
+    typedef quantity_expression_operand<L>  lhs_operand;
+    typedef quantity_expression_operand<R>  rhs_operand;
+    typedef quantity_expression<
+        quantity_expression_binary<Op, typename lhs_operand::type, typename rhs_operand::type>
+    > type;
+
+    static type make(const L& lhs, const R& rhs)
+    {
+        typedef typename type::expression_type expression_type;
+        return type(expression_type(lhs_operand::make(lhs), rhs_operand::make(rhs)));
+    }
+};
+
+template<class T, bool Enable = quantity_expression_operand<T>::is_range>
+struct quantity_expression_negate_result { };
+
+template<class T>
+struct quantity_expression_negate_result<T, true>
+{
+    typedef quantity_expression_operand<T>  operand;
+    typedef quantity_expression<quantity_expression_negate<typename operand::type> > type;
+
+    static type make(const T& x)
+    {
+        typedef typename type::expression_type expression_type;
+        return type(expression_type(operand::make(x)));
+    }
+};
+
+} // namespace detail
+
+/// elementwise negation of an array, span or expression
+template<class T>
+inline typename detail::quantity_expression_negate_result<T>::type
+operator-(const T& x)
+{
+    return detail::quantity_expression_negate_result<T>::make(x);
+}
+
+/// elementwise sum of arrays, spans or expressions, or of one of them
+/// and a quantity or scalar
+template<class L, class R>
+inline typename detail::quantity_expression_binary_result<detail::quantity_expression_plus, L, R>::type
+operator+(const L& lhs, const R& rhs)
+{
+    return detail::quantity_expression_binary_result<detail::quantity_expression_plus, L, R>::make(lhs, rhs);
+}
+
+/// elementwise difference of arrays, spans or expressions, or of one of
+/// them and a quantity or scalar
+template<class L, class R>
+inline typename detail::quantity_expression_binary_result<detail::quantity_expression_minus, L, R>::type
+operator-(const L& lhs, const R& rhs)
+{
+    return detail::quantity_expression_binary_result<detail::quantity_expression_minus, L, R>::make(lhs, rhs);
+}
+
+/// elementwise product of arrays, spans or expressions, or of one of
+/// them and a quantity or scalar
+template<class L, class R>
+inline typename detail::quantity_expression_binary_result<detail::quantity_expression_multiplies, L, R>::type
+operator*(const L& lhs, const R& rhs)
+{
+    return detail::quantity_expression_binary_result<detail::quantity_expression_multiplies, L, R>::make(lhs, rhs);
+}
+
+/// elementwise quotient of arrays, spans or expressions, or of one of
+/// them and a quantity or scalar
+template<class L, class R>
+inline typename detail::quantity_expression_binary_result<detail::quantity_expression_divides, L, R>::type
+operator/(const L& lhs, const R& rhs)
+{
+    return detail::quantity_expression_binary_result<detail::quantity_expression_divides, L, R>::make(lhs, rhs);
+}
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_QUANTITY_EXPRESSION_HPP
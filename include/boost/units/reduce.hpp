@@ -0,0 +1,412 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_REDUCE_HPP
+#define BOOST_UNITS_REDUCE_HPP
+
+///
+/// \file
+/// \brief Sums and statistics of ranges of quantities.
+/// \details The reductions take random-access iterators over quantities
+///   and return quantities of the appropriate unit.  Sums are
+///   compensated (Neumaier), so their error does not grow with the
+///   length of the range.  Long ranges are split into chunks reduced on
+///   separate threads when @c BOOST_UNITS_HAS_THREADS is set; the
+///   @c threads argument limits their number, and zero means as many as
+///   the hardware supports.  The results do not depend on the order in
+///   which the chunks finish, but may differ in the last bits with the
+///   number of threads.
+///
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/units/config.hpp>
+#include <boost/units/operators.hpp>
+#include <boost/units/pow.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/static_rational.hpp>
+
+#if BOOST_UNITS_HAS_THREADS
+#include <exception>
+#include <thread>
+#endif
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+template<class Quantity>
+struct reduce_quantity_traits;
+
+template<class Unit, class Y>
+struct reduce_quantity_traits<quantity<Unit, Y> >
+{
+    typedef quantity<Unit, Y>   quantity_type;
+    typedef Y                   value_type;
+};
+
+/// The quantity type and value type of the elements of a range.
+template<class Iterator>
+struct quantity_range_traits :
+    reduce_quantity_traits<typename std::iterator_traits<Iterator>::value_type>
+{ };
+
+/// Neumaier's variant of Kahan summation.
+template<class Y>
+struct compensated_sum
+{
+    compensated_sum() : sum(), compensation() { }
+
+    void add(const Y& x)
+    {
+        const Y t = sum + x;
+        const bool larger = (sum < Y() ? -sum : sum) >= (x < Y() ? -x : x);
+        compensation += larger ? (sum - t) + x : (x - t) + sum;
+        sum = t;
+    }
+
+    void add(const compensated_sum& other)
+    {
+        add(other.sum);
+        compensation += other.compensation;
+    }
+
+    Y value() const { return sum + compensation; }
+
+    Y sum;
+    Y compensation;
+};
+
+/// The count, mean and sum of squared deviations of a range.
+template<class Y>
+struct range_moments
+{
+    range_moments() : count(0), mean(), m2() { }
+
+    /// Chan et al.'s combination of the moments of two ranges.
+    void add(const range_moments& other)
+    {
+        if(other.count == 0) return;
+        if(count == 0) { *this = other; return; }
+        const std::size_t n = count + other.count;
+        const Y delta = other.mean - mean;
+        const Y a = static_cast<Y>(count);
+        const Y b = static_cast<Y>(other.count);
+        mean += delta * b / static_cast<Y>(n);
+        m2 += other.m2 + delta * delta * a * b / static_cast<Y>(n);
+        count = n;
+    }
+
+    std::size_t count;
+    Y           mean;
+    Y           m2;
+};
+
+template<class Y>
+struct sum_reducer
+{
+    typedef compensated_sum<Y> result_type;
+
+    /// Four independent sums hide the latency of the additions.
+    template<class Iterator>
+    result_type operator()(Iterator first, Iterator last) const
+    {
+        result_type result[4];
+        for(; last - first >= 4; first += 4)
+        {
+            result[0].add((*first).value());
+            result[1].add((*(first + 1)).value());
+            result[2].add((*(first + 2)).value());
+            result[3].add((*(first + 3)).value());
+        }
+        for(; first != last; ++first)
+            result[0].add((*first).value());
+        result[0].add(result[1]);
+        result[2].add(result[3]);
+        result[0].add(result[2]);
+        return result[0];
+    }
+};
+
+/// Sums the deviations from the first element and their squares, which
+/// keeps the sum of squares accurate when the mean is large compared
+/// with the spread.
+template<class Y>
+struct moments_reducer
+{
+    typedef range_moments<Y> result_type;
+
+    template<class Iterator>
+    result_type operator()(Iterator first, Iterator last) const
+    {
+        result_type result;
+        if(first == last) return result;
+        const Y shift = (*first).value();
+        compensated_sum<Y> sum, squares;
+        for(; first != last; ++first, ++result.count)
+        {
+            const Y d = (*first).value() - shift;
+            sum.add(d);
+            squares.add(d * d);
+        }
+        const Y n = static_cast<Y>(result.count);
+        const Y s = sum.value();
+        result.mean = shift + s / n;
+        result.m2 = squares.value() - s * s / n;
+        if(result.m2 < Y()) result.m2 = Y();
+        return result;
+    }
+};
+
+template<class Y>
+struct extrema_reducer
+{
+    typedef std::pair<Y, Y> result_type;
+
+    template<class Iterator>
+    result_type operator()(Iterator first, Iterator last) const
+    {
+        result_type result((*first).value(), (*first).value());
+        for(++first; first != last; ++first)
+        {
+            const Y x = (*first).value();
+            if(x < result.first) result.first = x;
+            if(result.second < x) result.second = x;
+        }
+        return result;
+    }
+};
+
+template<class Iterator1, class Iterator2, class Y>
+struct dot_reducer
+{
+    typedef compensated_sum<Y> result_type;
+
+    dot_reducer(Iterator1 f1, Iterator2 f2) : first1(f1), first2(f2) { }
+
+    result_type operator()(Iterator1 first, Iterator1 last) const
+    {
+        Iterator2 other = first2 + (first - first1);
+        result_type result;
+        for(; first != last; ++first, ++other)
+            result.add((*first).value() * (*other).value());
+        return result;
+    }
+
+    Iterator1 first1;
+    Iterator2 first2;
+};
+
+/// The smallest number of elements given a thread of their own.
+const std::size_t reduce_min_chunk = 32768;
+
+inline std::size_t reduce_chunk_count(std::size_t n, unsigned threads)
+{
+#if BOOST_UNITS_HAS_THREADS
+    std::size_t result = threads != 0 ? threads : std::thread::hardware_concurrency();
+    result = (std::min)(result, n / reduce_min_chunk);
+    return result != 0 ? result : 1;
+#else
+    static_cast<void>(n);
+    static_cast<void>(threads);
+    return 1;
+#endif
+}
+
+#if BOOST_UNITS_HAS_THREADS
+
+template<class Iterator, class Reducer>
+struct reduce_task
+{
+    reduce_task(const Reducer& r, Iterator f, Iterator l, typename Reducer::result_type* out, std::exception_ptr* e) :
+        reducer(&r), first(f), last(l), result(out), error(e)
+    { }
+
+    // an exception leaving a thread would terminate the program, so it
+    // is kept for the calling thread to rethrow
+    void operator()() const
+    {
+        try
+        {
+            *result = (*reducer)(first, last);
+        }
+        catch(...)
+        {
+            *error = std::current_exception();
+        }
+    }
+
+    const Reducer*                  reducer;
+    Iterator                        first;
+    Iterator                        last;
+    typename Reducer::result_type*  result;
+    std::exception_ptr*             error;
+};
+
+/// Joins the threads of a reduction however it ends, since destroying
+/// a joinable thread terminates the program.
+class reduce_joiner
+{
+    public:
+        explicit reduce_joiner(std::vector<std::thread>& workers) : workers_(&workers) { }
+
+        ~reduce_joiner()
+        {
+            for(std::size_t i = 0; i < workers_->size(); ++i)
+                if((*workers_)[i].joinable())
+                    (*workers_)[i].join();
+        }
+
+    private:
+        reduce_joiner(const reduce_joiner&);
+        reduce_joiner& operator=(const reduce_joiner&);
+
+        std::vector<std::thread>* workers_;
+};
+
+#endif
+
+/// Applies @c reducer to consecutive chunks of the @c n elements at
+/// @c first, one chunk per thread, and stores the results in order.
+/// If @c reducer throws, the exception of the first such chunk is
+/// rethrown once all the threads have finished.
+template<class Iterator, class Reducer>
+void reduce_chunks(Iterator first, std::size_t n, unsigned threads, const Reducer& reducer,
+                   std::vector<typename Reducer::result_type>& partials)
+{
+    const std::size_t chunks = reduce_chunk_count(n, threads);
+    partials.resize(chunks);
+#if BOOST_UNITS_HAS_THREADS
+    std::vector<std::exception_ptr> errors(chunks);
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(chunks - 1);
+        const reduce_joiner joiner(workers);
+        for(std::size_t i = 1; i < chunks; ++i)
+        {
+            const Iterator begin = first + static_cast<std::ptrdiff_t>(n * i / chunks);
+            const Iterator end = first + static_cast<std::ptrdiff_t>(n * (i + 1) / chunks);
+            workers.push_back(std::thread(reduce_task<Iterator, Reducer>(reducer, begin, end, &partials[i], &errors[i])));
+        }
+        reduce_task<Iterator, Reducer>(reducer, first, first + static_cast<std::ptrdiff_t>(n / chunks), &partials[0], &errors[0])();
+    }
+    for(std::size_t i = 0; i < chunks; ++i)
+        if(errors[i])
+            std::rethrow_exception(errors[i]);
+#else
+    partials[0] = reducer(first, first + static_cast<std::ptrdiff_t>(n));
+#endif
+}
+
+template<class Iterator, class Reducer>
+typename Reducer::result_type reduce_range(Iterator first, Iterator last, unsigned threads, const Reducer& reducer)
+{
+    std::vector<typename Reducer::result_type> partials;
+    reduce_chunks(first, static_cast<std::size_t>(last - first), threads, reducer, partials);
+    typename Reducer::result_type result = partials[0];
+    for(std::size_t i = 1; i < partials.size(); ++i)
+        result.add(partials[i]);
+    return result;
+}
+
+} // namespace detail
+
+/// The sum of the quantities in [first, last).
+template<class Iterator>
+inline typename detail::quantity_range_traits<Iterator>::quantity_type
+reduce_sum(Iterator first, Iterator last, unsigned threads = 0)
+{
+    typedef detail::quantity_range_traits<Iterator> traits;
+    return traits::quantity_type::from_value(
+        detail::reduce_range(first, last, threads, detail::sum_reducer<typename traits::value_type>()).value());
+}
+
+/// The mean of the quantities in [first, last), which must not be empty.
+template<class Iterator>
+inline typename detail::quantity_range_traits<Iterator>::quantity_type
+mean(Iterator first, Iterator last, unsigned threads = 0)
+{
+    typedef detail::quantity_range_traits<Iterator> traits;
+    if(first == last)
+        throw std::invalid_argument("boost::units::mean: empty range");
+    return traits::quantity_type::from_value(
+        detail::reduce_range(first, last, threads, detail::moments_reducer<typename traits::value_type>()).mean);
+}
+
+/// The population variance of the quantities in [first, last), which
+/// must not be empty, in the square of their unit.
+template<class Iterator>
+inline typename power_typeof_helper<
+    typename detail::quantity_range_traits<Iterator>::quantity_type,
+    static_rational<2>
+>::type
+variance(Iterator first, Iterator last, unsigned threads = 0)
+{
+    typedef detail::quantity_range_traits<Iterator> traits;
+    typedef typename power_typeof_helper<typename traits::quantity_type, static_rational<2> >::type result_type;
+    if(first == last)
+        throw std::invalid_argument("boost::units::variance: empty range");
+    const detail::range_moments<typename traits::value_type> moments =
+        detail::reduce_range(first, last, threads, detail::moments_reducer<typename traits::value_type>());
+    return result_type::from_value(moments.m2 / static_cast<typename traits::value_type>(moments.count));
+}
+
+/// The smallest and the largest of the quantities in [first, last),
+/// which must not be empty.
+template<class Iterator>
+inline std::pair<typename detail::quantity_range_traits<Iterator>::quantity_type,
+                 typename detail::quantity_range_traits<Iterator>::quantity_type>
+min_max(Iterator first, Iterator last, unsigned threads = 0)
+{
+    typedef detail::quantity_range_traits<Iterator> traits;
+    typedef typename traits::quantity_type quantity_type;
+    typedef typename traits::value_type value_type;
+    if(first == last)
+        throw std::invalid_argument("boost::units::min_max: empty range");
+    std::vector<std::pair<value_type, value_type> > partials;
+    detail::reduce_chunks(first, static_cast<std::size_t>(last - first), threads,
+                          detail::extrema_reducer<value_type>(), partials);
+    std::pair<value_type, value_type> result = partials[0];
+    for(std::size_t i = 1; i < partials.size(); ++i)
+    {
+        if(partials[i].first < result.first) result.first = partials[i].first;
+        if(result.second < partials[i].second) result.second = partials[i].second;
+    }
+    return std::make_pair(quantity_type::from_value(result.first), quantity_type::from_value(result.second));
+}
+
+/// The sum of the products of the quantities in [first1, last1) and
+/// those starting at @c first2, in the product of their units.
+template<class Iterator1, class Iterator2>
+inline typename multiply_typeof_helper<
+    typename detail::quantity_range_traits<Iterator1>::quantity_type,
+    typename detail::quantity_range_traits<Iterator2>::quantity_type
+>::type
+dot(Iterator1 first1, Iterator1 last1, Iterator2 first2, unsigned threads = 0)
+{
+    typedef typename multiply_typeof_helper<
+        typename detail::quantity_range_traits<Iterator1>::quantity_type,
+        typename detail::quantity_range_traits<Iterator2>::quantity_type
+    >::type result_type;
+    typedef typename result_type::value_type value_type;
+    typedef detail::dot_reducer<Iterator1, Iterator2, value_type> reducer_type;
+    return result_type::from_value(
+        detail::reduce_range(first1, last1, threads, reducer_type(first1, first2)).value());
+}
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_REDUCE_HPP
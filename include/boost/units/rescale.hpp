@@ -0,0 +1,363 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_RESCALE_HPP
+#define BOOST_UNITS_RESCALE_HPP
+
+///
+/// \file
+/// \brief Exact conversion of integral quantities between scaled units.
+/// \details @c rescale converts between units that differ only by
+///   factors of @c scale<10, N> and @c scale<2, N>, such as meters,
+///   millimeters and kilometers, or bytes and kibibytes.  The factor is
+///   reduced at compile time to a fraction of two integers, so the
+///   value is multiplied and divided by integer constants and never
+///   passes through floating point.  A rounding policy decides what
+///   happens to a remainder and an overflow policy whether the
+///   multiplication is checked.
+///
+
+#include <limits>
+#include <stdexcept>
+
+#include <boost/cstdint.hpp>
+#include <boost/integer_traits.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/divides.hpp>
+#include <boost/mpl/if.hpp>
+
+#include <boost/units/conversion.hpp>
+#include <boost/units/heterogeneous_system.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/reduce_unit.hpp>
+#include <boost/units/scale.hpp>
+#include <boost/units/unit.hpp>
+#include <boost/units/detail/unscale.hpp>
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+template<class Y, bool Signed = std::numeric_limits<Y>::is_signed>
+struct rescale_sign
+{
+    static BOOST_CONSTEXPR bool negative(const Y& x) { return x < Y(0); }
+    static BOOST_CONSTEXPR bool below(const Y& x, const Y& bound) { return x < bound; }
+};
+
+template<class Y>
+struct rescale_sign<Y, false>
+{
+    static BOOST_CONSTEXPR bool negative(const Y&) { return false; }
+    static BOOST_CONSTEXPR bool below(const Y&, const Y&) { return false; }
+};
+
+} // namespace detail
+
+/// Rounding policy of @c rescale: discards the remainder, as integer
+/// division does.
+struct round_toward_zero
+{
+    template<class Y>
+    static Y divide(const Y& n, const Y& d) { return n / d; }
+};
+
+/// Rounding policy of @c rescale: rounds to the nearest integer, and
+/// halves away from zero.
+struct round_to_nearest
+{
+    template<class Y>
+    static Y divide(const Y& n, const Y& d)
+    {
+        const Y q = n / d;
+        const Y r = n % d;
+        if(detail::rescale_sign<Y>::negative(r)) return Y(0) - r >= d + r ? q - Y(1) : q;
+        return r >= d - r ? q + Y(1) : q;
+    }
+};
+
+/// Rounding policy of @c rescale: rounds toward negative infinity.
+struct round_downward
+{
+    template<class Y>
+    static Y divide(const Y& n, const Y& d)
+    {
+        const Y q = n / d;
+        return detail::rescale_sign<Y>::negative(n % d) ? q - Y(1) : q;
+    }
+};
+
+/// Rounding policy of @c rescale: rounds toward positive infinity.
+struct round_upward
+{
+    template<class Y>
+    static Y divide(const Y& n, const Y& d)
+    {
+        const Y q = n / d;
+        return n % d > Y(0) ? q + Y(1) : q;
+    }
+};
+
+/// Rounding policy of @c rescale: throws @c std::domain_error if the
+/// value cannot be represented exactly in the new unit.
+struct round_exact
+{
+    template<class Y>
+    static Y divide(const Y& n, const Y& d)
+    {
+        if(n % d != Y(0))
+            throw std::domain_error("boost::units::rescale: the value is not exact in the new unit");
+        return n / d;
+    }
+};
+
+/// Overflow policy of @c rescale: the multiplication is not checked.
+struct unchecked_overflow
+{
+    template<class Y>
+    static Y multiply(const Y& x, boost::intmax_t n) { return x * static_cast<Y>(n); }
+};
+
+/// Overflow policy of @c rescale: throws @c std::overflow_error if the
+/// multiplication overflows.
+struct checked_overflow
+{
+    template<class Y>
+    static Y multiply(const Y& x, boost::intmax_t n)
+    {
+        typedef std::numeric_limits<Y> limits;
+        if(static_cast<boost::uintmax_t>(n) > static_cast<boost::uintmax_t>((limits::max)()))
+        {
+            if(x != Y(0))
+                throw std::overflow_error("boost::units::rescale: overflow");
+            return x;
+        }
+        const Y factor = static_cast<Y>(n);
+        if(x > (limits::max)() / factor || detail::rescale_sign<Y>::below(x, (limits::min)() / factor))
+            throw std::overflow_error("boost::units::rescale: overflow");
+        return x * factor;
+    }
+};
+
+namespace detail {
+
+template<boost::intmax_t Base, long Exponent>
+struct static_integer_power
+{
+    typedef static_integer_power<Base, Exponent - 1> next;
+    BOOST_STATIC_ASSERT_MSG(next::value <= boost::integer_traits<boost::intmax_t>::const_max / Base, "the scale factor does not fit in intmax_t");
+    BOOST_STATIC_CONSTANT(boost::intmax_t, value = Base * next::value);
+};
+
+template<boost::intmax_t Base>
+struct static_integer_power<Base, 0>
+{
+    BOOST_STATIC_CONSTANT(boost::intmax_t, value = 1);
+};
+
+template<boost::intmax_t A, boost::intmax_t B>
+struct static_integer_gcd
+{
+    BOOST_STATIC_CONSTANT(boost::intmax_t, value = (static_integer_gcd<B, A % B>::value));
+};
+
+template<boost::intmax_t A>
+struct static_integer_gcd<A, 0>
+{
+    BOOST_STATIC_CONSTANT(boost::intmax_t, value = A);
+};
+
+template<boost::intmax_t A, boost::intmax_t B>
+struct static_checked_multiply
+{
+    BOOST_STATIC_ASSERT_MSG(A <= boost::integer_traits<boost::intmax_t>::const_max / B, "the scale factor does not fit in intmax_t");
+    BOOST_STATIC_CONSTANT(boost::intmax_t, value = A * B);
+};
+
+/// The product of a list of scales as a fraction, with the positive
+/// exponents in the numerator and the negative ones in the denominator.
+template<int N>
+struct scale_list_fraction_impl
+{
+    template<class Begin>
+    struct apply
+    {
+        typedef typename scale_list_fraction_impl<N - 1>::template apply<typename Begin::next> next;
+        typedef typename Begin::item::exponent exponent;
+        BOOST_STATIC_ASSERT_MSG(exponent::Denominator == 1, "rescale needs integral exponents");
+        BOOST_STATIC_CONSTANT(long, power = exponent::Numerator < 0 ? -exponent::Numerator : exponent::Numerator);
+        typedef static_integer_power<Begin::item::base, power> factor;
+        BOOST_STATIC_CONSTANT(boost::intmax_t, numerator =
+            (static_checked_multiply<next::numerator, exponent::Numerator < 0 ? 1 : factor::value>::value));
+        BOOST_STATIC_CONSTANT(boost::intmax_t, denominator =
+            (static_checked_multiply<next::denominator, exponent::Numerator < 0 ? factor::value : 1>::value));
+    };
+};
+
+template<>
+struct scale_list_fraction_impl<0>
+{
+    template<class Begin>
+    struct apply
+    {
+        BOOST_STATIC_CONSTANT(boost::intmax_t, numerator = 1);
+        BOOST_STATIC_CONSTANT(boost::intmax_t, denominator = 1);
+    };
+};
+
+/// The factor from @c From to @c To as a fraction in lowest terms.
+/// The units must differ only in their scales.
+template<class From, class To>
+struct rescale_fraction
+{
+    typedef typename reduce_unit<From>::type from_type;
+    typedef typename reduce_unit<To>::type to_type;
+    BOOST_STATIC_ASSERT_MSG((boost::is_same<typename unscale<from_type>::type, typename unscale<to_type>::type>::value),
+        "rescale needs units that differ only in their scales");
+    typedef typename mpl::divides<
+        typename get_scale_list<from_type>::type,
+        typename get_scale_list<to_type>::type
+    >::type scale_list;
+    typedef typename scale_list_fraction_impl<scale_list::size::value>::template apply<scale_list> fraction;
+    BOOST_STATIC_CONSTANT(boost::intmax_t, gcd = (static_integer_gcd<fraction::numerator, fraction::denominator>::value));
+    BOOST_STATIC_CONSTANT(boost::intmax_t, numerator = fraction::numerator / gcd);
+    BOOST_STATIC_CONSTANT(boost::intmax_t, denominator = fraction::denominator / gcd);
+};
+
+/// The type in which a @c Y is divided by @c Denominator: @c Y itself
+/// if the denominator fits in it, and otherwise the widest integer of
+/// the same signedness.  The rounded quotient then has a magnitude of
+/// at most one, so it always fits back in @c Y.
+template<class Y, boost::intmax_t Denominator,
+         bool Fits = (static_cast<boost::uintmax_t>(Denominator) <= static_cast<boost::uintmax_t>(boost::integer_traits<Y>::const_max))>
+struct rescale_division_type
+{
+    typedef Y type;
+};
+
+template<class Y, boost::intmax_t Denominator>
+struct rescale_division_type<Y, Denominator, false>
+{
+    typedef typename mpl::if_c<std::numeric_limits<Y>::is_signed, boost::intmax_t, boost::uintmax_t>::type type;
+};
+
+/// Multiplies @c x by @c Numerator and divides it by @c Denominator, as
+/// @c Overflow and @c Rounding say.
+template<boost::intmax_t Numerator, boost::intmax_t Denominator, class Rounding, class Overflow, class Y>
+inline Y rescale_value(const Y& x)
+{
+    BOOST_STATIC_ASSERT_MSG(boost::is_integral<Y>::value, "rescale needs an integral value type");
+    typedef typename rescale_division_type<Y, Denominator>::type division_type;
+    Y result = Numerator == 1 ? x : Overflow::multiply(x, Numerator);
+    if(Denominator != 1)
+        result = static_cast<Y>(Rounding::divide(static_cast<division_type>(result), static_cast<division_type>(Denominator)));
+    return result;
+}
+
+/// Whether multiplying a @c Y by @c Numerator overflows, as a single
+/// expression so that it is @c constexpr in C++11.
+template<class Y, boost::intmax_t Numerator,
+         bool Fits = (static_cast<boost::uintmax_t>(Numerator) <= static_cast<boost::uintmax_t>(boost::integer_traits<Y>::const_max))>
+struct rescale_multiply_overflows
+{
+    static BOOST_CONSTEXPR bool check(const Y& x)
+    {
+        return x > static_cast<Y>(boost::integer_traits<Y>::const_max / static_cast<Y>(Numerator)) ||
+            rescale_sign<Y>::below(x, static_cast<Y>(boost::integer_traits<Y>::const_min / static_cast<Y>(Numerator)));
+    }
+};
+
+template<class Y, boost::intmax_t Numerator>
+struct rescale_multiply_overflows<Y, Numerator, false>
+{
+    static BOOST_CONSTEXPR bool check(const Y& x) { return x != Y(0); }
+};
+
+/// Whether @c From and @c To differ only in their scales.
+template<class From, class To>
+struct rescale_compatible :
+    boost::is_same<
+        typename unscale<typename reduce_unit<From>::type>::type,
+        typename unscale<typename reduce_unit<To>::type>::type
+    >
+{ };
+
+/// A @c conversion_helper that converts integral values with
+/// @c rescale_value when the units differ only in their scales, and
+/// otherwise multiplies by the conversion factor as the default does.
+template<class Unit1, class Unit2, class T,
+         bool Exact = mpl::and_<boost::is_integral<T>, rescale_compatible<Unit1, Unit2> >::value>
+struct exact_conversion_helper
+{
+    typedef quantity<Unit2, T> destination_type;
+    static BOOST_CONSTEXPR destination_type convert(const quantity<Unit1, T>& source)
+    {
+        return(destination_type::from_value(static_cast<T>(source.value() * conversion_factor(Unit1(), Unit2()))));
+    }
+};
+
+template<class Unit1, class Unit2, class T>
+struct exact_conversion_helper<Unit1, Unit2, T, true>
+{
+    typedef quantity<Unit2, T> destination_type;
+    typedef rescale_fraction<Unit1, Unit2> fraction;
+    typedef typename rescale_division_type<T, fraction::denominator>::type division_type;
+    /// As @c rescale with @c round_toward_zero and @c checked_overflow,
+    /// in a single expression so that it is @c constexpr in C++11.
+    static BOOST_CONSTEXPR destination_type convert(const quantity<Unit1, T>& source)
+    {
+        return(rescale_multiply_overflows<T, fraction::numerator>::check(source.value()) ?
+            throw std::overflow_error("boost::units::conversion: overflow") :
+            destination_type::from_value(static_cast<T>(
+                static_cast<division_type>(static_cast<T>(source.value() * static_cast<T>(fraction::numerator))) /
+                static_cast<division_type>(fraction::denominator))));
+    }
+};
+
+} // namespace detail
+
+/// \brief Converts @c q to @c Unit exactly, using only integer
+/// arithmetic.
+/// \details @c Unit and the unit of @c q must differ only by factors of
+/// @c scale, which must have integral exponents; otherwise the call does
+/// not compile.  The value is multiplied by the numerator of the factor,
+/// as @c Overflow allows, and then divided by its denominator, rounding
+/// as @c Rounding says.
+template<class Unit, class Rounding, class Overflow, class Unit2, class Y>
+inline quantity<Unit, Y> rescale(const quantity<Unit2, Y>& q)
+{
+    typedef detail::rescale_fraction<Unit2, Unit> fraction;
+    return quantity<Unit, Y>::from_value(
+        detail::rescale_value<fraction::numerator, fraction::denominator, Rounding, Overflow>(q.value()));
+}
+
+/// Converts @c q to @c Unit exactly, rounding as @c Rounding says and
+/// without checking for overflow.
+template<class Unit, class Rounding, class Unit2, class Y>
+inline quantity<Unit, Y> rescale(const quantity<Unit2, Y>& q)
+{
+    return rescale<Unit, Rounding, unchecked_overflow>(q);
+}
+
+/// Converts @c q to @c Unit exactly, discarding any remainder and
+/// without checking for overflow.
+template<class Unit, class Unit2, class Y>
+inline quantity<Unit, Y> rescale(const quantity<Unit2, Y>& q)
+{
+    return rescale<Unit, round_toward_zero, unchecked_overflow>(q);
+}
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_RESCALE_HPP
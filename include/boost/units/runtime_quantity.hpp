@@ -0,0 +1,322 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_RUNTIME_QUANTITY_HPP
+#define BOOST_UNITS_RUNTIME_QUANTITY_HPP
+
+///
+/// \file
+/// \brief Quantities whose dimension is only known at runtime.
+/// \details A @c runtime_quantity is a value in the coherent unit of
+///   the reference system of @c runtime_unit together with a packed
+///   @c runtime_dimension, so it is no larger than the value and one
+///   64-bit word.  Dimensions are checked when quantities are added,
+///   compared or converted to a @c quantity, and @c std::domain_error
+///   is thrown when they differ.
+///
+
+#include <cmath>
+#include <ostream>
+#include <stdexcept>
+
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/units/conversion.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/runtime_unit.hpp>
+#include <boost/units/unit.hpp>
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+inline void check_runtime_dimension(const runtime_dimension& lhs, const runtime_dimension& rhs, const char* what)
+{
+    if(lhs != rhs) throw std::domain_error(what);
+}
+
+/// The factor from Unit to the unit of the reference system with the
+/// same dimension.
+template<class Dim, class System>
+struct runtime_reference_factor
+{
+    typedef unit<Dim, System> unit_type;
+    typedef unit<Dim, runtime_reference_system> reference_type;
+    typedef typename one_to_double_type<
+        typename conversion_factor_helper<unit_type, reference_type>::type
+    >::type type;
+    static type value() { return conversion_factor(unit_type(), reference_type()); }
+};
+
+/// The @c n th root of a value.  Integral values are rooted in
+/// @c double and rounded, since @c Y(1)/n would be zero.
+template<class Y, bool Integral = boost::is_integral<Y>::value>
+struct runtime_root
+{
+    static Y call(const Y& val, int n)
+    {
+        using std::pow;
+        return static_cast<Y>(pow(val, Y(1) / static_cast<Y>(n)));
+    }
+};
+
+template<class Y>
+struct runtime_root<Y, true>
+{
+    static Y call(const Y& val, int n)
+    {
+        using std::floor;
+        using std::pow;
+        const double magnitude = pow(std::abs(static_cast<double>(val)), 1.0 / n);
+        if(val < Y() && n % 2 == 0) throw std::domain_error("boost::units::root: even root of a negative value");
+        const Y result = static_cast<Y>(floor(magnitude + 0.5));
+        return val < Y() ? static_cast<Y>(-result) : result;
+    }
+};
+
+} // namespace detail
+
+/// A value together with a dimension known only at runtime.
+template<class Y>
+class runtime_quantity
+{
+    public:
+        typedef runtime_quantity<Y> this_type;
+        typedef Y                   value_type;
+
+        /// zero, dimensionless
+        runtime_quantity() : val_(), dimension_() { }
+
+        /// @c val in the coherent unit of the reference system.
+        runtime_quantity(const value_type& val, const runtime_dimension& d) : val_(val), dimension_(d) { }
+
+        /// @c val in the unit @c u.  The offset of @c u is not applied,
+        /// so the result is a difference, not an absolute value.
+        runtime_quantity(const value_type& val, const runtime_unit& u) :
+            val_(static_cast<value_type>(val * u.scale())),
+            dimension_(u.dimension())
+        { }
+
+        /// Converts a @c quantity, whose dimension is known statically.
+        template<class Dim, class System, class Y2>
+        explicit runtime_quantity(const quantity<unit<Dim, System>, Y2>& q) :
+            val_(static_cast<value_type>(q.value() * detail::runtime_reference_factor<Dim, System>::value())),
+            dimension_(make_runtime_dimension<Dim>())
+        { }
+
+        /// the value in the coherent unit of the reference system
+        const value_type& value() const { return val_; }
+        const runtime_dimension& dimension() const { return dimension_; }
+
+        /// The value in the unit @c u, which must have the same dimension.
+        value_type value_in(const runtime_unit& u) const
+        {
+            detail::check_runtime_dimension(dimension_, u.dimension(), "boost::units::runtime_quantity::value_in: the dimension of the unit differs");
+            return static_cast<value_type>(val_ / u.scale());
+        }
+
+        /// Converts to a @c quantity in the unit @c u, which must have
+        /// the same dimension.
+        template<class Dim, class System>
+        quantity<unit<Dim, System>, value_type> as(const unit<Dim, System>&) const
+        {
+            detail::check_runtime_dimension(dimension_, make_runtime_dimension<Dim>(), "boost::units::runtime_quantity::as: the dimension of the unit differs");
+            return quantity<unit<Dim, System>, value_type>::from_value(
+                static_cast<value_type>(val_ / detail::runtime_reference_factor<Dim, System>::value()));
+        }
+
+        this_type& operator+=(const this_type& source)
+        {
+            detail::check_runtime_dimension(dimension_, source.dimension_, "boost::units::runtime_quantity: adding different dimensions");
+            val_ += source.val_;
+            return *this;
+        }
+
+        this_type& operator-=(const this_type& source)
+        {
+            detail::check_runtime_dimension(dimension_, source.dimension_, "boost::units::runtime_quantity: subtracting different dimensions");
+            val_ -= source.val_;
+            return *this;
+        }
+
+        this_type& operator*=(const this_type& source)
+        {
+            // the dimension may throw, so it is computed before anything changes
+            runtime_dimension d(dimension_);
+            d *= source.dimension_;
+            val_ *= source.val_;
+            dimension_ = d;
+            return *this;
+        }
+
+        this_type& operator/=(const this_type& source)
+        {
+            runtime_dimension d(dimension_);
+            d /= source.dimension_;
+            val_ /= source.val_;
+            dimension_ = d;
+            return *this;
+        }
+
+        this_type& operator*=(const value_type& source) { val_ *= source; return *this; }
+        this_type& operator/=(const value_type& source) { val_ /= source; return *this; }
+
+    private:
+        value_type          val_;
+        runtime_dimension   dimension_;
+};
+
+/// runtime_quantity + runtime_quantity, the dimensions must agree
+template<class Y>
+inline runtime_quantity<Y> operator+(runtime_quantity<Y> lhs, const runtime_quantity<Y>& rhs)
+{
+    return lhs += rhs;
+}
+
+/// runtime_quantity - runtime_quantity, the dimensions must agree
+template<class Y>
+inline runtime_quantity<Y> operator-(runtime_quantity<Y> lhs, const runtime_quantity<Y>& rhs)
+{
+    return lhs -= rhs;
+}
+
+/// runtime_quantity * runtime_quantity
+template<class Y>
+inline runtime_quantity<Y> operator*(runtime_quantity<Y> lhs, const runtime_quantity<Y>& rhs)
+{
+    return lhs *= rhs;
+}
+
+/// runtime_quantity / runtime_quantity
+template<class Y>
+inline runtime_quantity<Y> operator/(runtime_quantity<Y> lhs, const runtime_quantity<Y>& rhs)
+{
+    return lhs /= rhs;
+}
+
+/// runtime_quantity * scalar
+template<class Y>
+inline runtime_quantity<Y> operator*(runtime_quantity<Y> lhs, const Y& rhs)
+{
+    return lhs *= rhs;
+}
+
+/// scalar * runtime_quantity
+template<class Y>
+inline runtime_quantity<Y> operator*(const Y& lhs, runtime_quantity<Y> rhs)
+{
+    return rhs *= lhs;
+}
+
+/// runtime_quantity / scalar
+template<class Y>
+inline runtime_quantity<Y> operator/(runtime_quantity<Y> lhs, const Y& rhs)
+{
+    return lhs /= rhs;
+}
+
+/// scalar / runtime_quantity
+template<class Y>
+inline runtime_quantity<Y> operator/(const Y& lhs, const runtime_quantity<Y>& rhs)
+{
+    return runtime_quantity<Y>(lhs / rhs.value(), runtime_dimension() / rhs.dimension());
+}
+
+/// unary minus
+template<class Y>
+inline runtime_quantity<Y> operator-(const runtime_quantity<Y>& val)
+{
+    return runtime_quantity<Y>(-val.value(), val.dimension());
+}
+
+/// unary plus
+template<class Y>
+inline runtime_quantity<Y> operator+(const runtime_quantity<Y>& val)
+{
+    return val;
+}
+
+/// Quantities of different dimensions are never equal.
+template<class Y>
+inline bool operator==(const runtime_quantity<Y>& lhs, const runtime_quantity<Y>& rhs)
+{
+    return lhs.dimension() == rhs.dimension() && lhs.value() == rhs.value();
+}
+
+template<class Y>
+inline bool operator!=(const runtime_quantity<Y>& lhs, const runtime_quantity<Y>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/// ordering, the dimensions must agree
+template<class Y>
+inline bool operator<(const runtime_quantity<Y>& lhs, const runtime_quantity<Y>& rhs)
+{
+    detail::check_runtime_dimension(lhs.dimension(), rhs.dimension(), "boost::units::runtime_quantity: comparing different dimensions");
+    return lhs.value() < rhs.value();
+}
+
+template<class Y>
+inline bool operator>(const runtime_quantity<Y>& lhs, const runtime_quantity<Y>& rhs)
+{
+    return rhs < lhs;
+}
+
+template<class Y>
+inline bool operator<=(const runtime_quantity<Y>& lhs, const runtime_quantity<Y>& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template<class Y>
+inline bool operator>=(const runtime_quantity<Y>& lhs, const runtime_quantity<Y>& rhs)
+{
+    return !(lhs < rhs);
+}
+
+/// Raises a runtime_quantity to the integral power @c n.
+template<class Y>
+inline runtime_quantity<Y> pow(const runtime_quantity<Y>& val, int n)
+{
+    using std::pow;
+    return runtime_quantity<Y>(static_cast<Y>(pow(val.value(), n)), pow(val.dimension(), n));
+}
+
+/// Takes the @c n th root of a runtime_quantity.  Throws
+/// @c std::domain_error unless the exponents of its dimension are
+/// multiples of @c n.  Integral values are rounded to the nearest root.
+template<class Y>
+inline runtime_quantity<Y> root(const runtime_quantity<Y>& val, int n)
+{
+    const runtime_dimension d = root(val.dimension(), n);
+    return runtime_quantity<Y>(detail::runtime_root<Y>::call(val.value(), n), d);
+}
+
+/// Writes the value followed by the symbols of the base units of the
+/// reference system, e.g. "9.81 m s^-2".
+template<class Char, class Traits, class Y>
+inline std::basic_ostream<Char, Traits>& operator<<(std::basic_ostream<Char, Traits>& os, const runtime_quantity<Y>& q)
+{
+    static const char* const symbols[runtime_dimension::size] = { "m", "kg", "s", "A", "K", "mol", "cd", "rad", "sr", "b" };
+    os << q.value();
+    for(std::size_t i = 0; i < runtime_dimension::size; ++i)
+    {
+        const int e = q.dimension().exponent(i);
+        if(e == 0) continue;
+        os << ' ' << symbols[i];
+        if(e != 1) os << '^' << e;
+    }
+    return os;
+}
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_RUNTIME_QUANTITY_HPP
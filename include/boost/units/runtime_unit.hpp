@@ -0,0 +1,336 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_RUNTIME_UNIT_HPP
+#define BOOST_UNITS_RUNTIME_UNIT_HPP
+
+///
+/// \file
+/// \brief Descriptions of units that are only known at runtime.
+/// \details A @c runtime_unit records what the type of a unit
+///   encodes: the exponents of its base dimensions, and the factor
+///   and offset that take a value in the unit to the coherent unit of
+///   the reference system (SI, plus the bit for information).
+///   @c make_runtime_unit builds one from any unit type whose base
+///   dimensions are those of <tt>boost/units/physical_dimensions</tt>.
+///
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/units/absolute.hpp>
+#include <boost/units/conversion.hpp>
+#include <boost/units/dimensionless_type.hpp>
+#include <boost/units/io.hpp>
+#include <boost/units/make_system.hpp>
+#include <boost/units/reduce_unit.hpp>
+#include <boost/units/unit.hpp>
+#include <boost/units/units_fwd.hpp>
+#include <boost/units/base_units/angle/radian.hpp>
+#include <boost/units/base_units/angle/steradian.hpp>
+#include <boost/units/base_units/information/bit.hpp>
+#include <boost/units/base_units/si/ampere.hpp>
+#include <boost/units/base_units/si/candela.hpp>
+#include <boost/units/base_units/si/kelvin.hpp>
+#include <boost/units/base_units/si/kilogram.hpp>
+#include <boost/units/base_units/si/meter.hpp>
+#include <boost/units/base_units/si/mole.hpp>
+#include <boost/units/base_units/si/second.hpp>
+#include <boost/units/physical_dimensions/amount.hpp>
+#include <boost/units/physical_dimensions/current.hpp>
+#include <boost/units/physical_dimensions/information.hpp>
+#include <boost/units/physical_dimensions/length.hpp>
+#include <boost/units/physical_dimensions/luminous_intensity.hpp>
+#include <boost/units/physical_dimensions/mass.hpp>
+#include <boost/units/physical_dimensions/plane_angle.hpp>
+#include <boost/units/physical_dimensions/solid_angle.hpp>
+#include <boost/units/physical_dimensions/temperature.hpp>
+#include <boost/units/physical_dimensions/time.hpp>
+
+namespace boost {
+
+namespace units {
+
+/// Position of a base dimension in a @c runtime_dimension.  Only the
+/// base dimensions of <tt>boost/units/physical_dimensions</tt> have one.
+template<class BaseDimension>
+struct runtime_dimension_index;
+
+/// INTERNAL ONLY
+#define BOOST_UNITS_RUNTIME_DIMENSION_INDEX(base_dimension_, index_)    \
+template<>                                                              \
+struct runtime_dimension_index<base_dimension_>                         \
+{                                                                       \
+    BOOST_STATIC_CONSTANT(std::size_t, value = index_);                 \
+}
+
+BOOST_UNITS_RUNTIME_DIMENSION_INDEX(length_base_dimension, 0);
+BOOST_UNITS_RUNTIME_DIMENSION_INDEX(mass_base_dimension, 1);
+BOOST_UNITS_RUNTIME_DIMENSION_INDEX(time_base_dimension, 2);
+BOOST_UNITS_RUNTIME_DIMENSION_INDEX(current_base_dimension, 3);
+BOOST_UNITS_RUNTIME_DIMENSION_INDEX(temperature_base_dimension, 4);
+BOOST_UNITS_RUNTIME_DIMENSION_INDEX(amount_base_dimension, 5);
+BOOST_UNITS_RUNTIME_DIMENSION_INDEX(luminous_intensity_base_dimension, 6);
+BOOST_UNITS_RUNTIME_DIMENSION_INDEX(plane_angle_base_dimension, 7);
+BOOST_UNITS_RUNTIME_DIMENSION_INDEX(solid_angle_base_dimension, 8);
+BOOST_UNITS_RUNTIME_DIMENSION_INDEX(information_base_dimension, 9);
+
+#undef BOOST_UNITS_RUNTIME_DIMENSION_INDEX
+
+/// The exponents of the base dimensions of a unit, packed as ten
+/// six-bit two's complement fields of one 64-bit word.  Exponents
+/// range over [-32, 31].  Multiplying and dividing dimensions adds and
+/// subtracts all the fields at once, without carries between them.
+/// Operations whose exponents would leave that range throw
+/// @c std::overflow_error.
+class runtime_dimension
+{
+    public:
+        /// number of base dimensions
+        BOOST_STATIC_CONSTANT(std::size_t, size = 10);
+        /// bits per exponent
+        BOOST_STATIC_CONSTANT(std::size_t, bits = 6);
+
+        /// dimensionless
+        runtime_dimension() : packed_(0) { }
+
+        int exponent(std::size_t i) const
+        {
+            const int field = static_cast<int>((packed_ >> (bits * i)) & field_mask);
+            return field >= (1 << (bits - 1)) ? field - (1 << bits) : field;
+        }
+
+        /// Throws @c std::overflow_error if @c e is not in [-32, 31].
+        void set_exponent(std::size_t i, boost::intmax_t e)
+        {
+            if(e < -(1 << (bits - 1)) || e >= (1 << (bits - 1)))
+                throw std::overflow_error("boost::units::runtime_dimension: exponent out of range");
+            packed_ &= ~(field_mask << (bits * i));
+            packed_ |= (static_cast<boost::uint64_t>(e) & field_mask) << (bits * i);
+        }
+
+        bool dimensionless() const { return packed_ == 0; }
+
+        /// the packed representation
+        boost::uint64_t packed() const { return packed_; }
+
+        /// The dimension whose packed representation is @c p.  Only
+        /// the low <tt>bits * size</tt> bits of @c p may be set.
+        static runtime_dimension from_packed(boost::uint64_t p)
+        {
+            BOOST_ASSERT((p & ~all_fields) == 0);
+            runtime_dimension result;
+            result.packed_ = p;
+            return result;
+        }
+
+        /// the dimension of a product
+        runtime_dimension& operator*=(const runtime_dimension& other)
+        {
+            const boost::uint64_t sum = ((packed_ & ~high_bits) + (other.packed_ & ~high_bits)) ^ ((packed_ ^ other.packed_) & high_bits);
+            // a field overflows when both signs agree and differ from the result
+            if((~(packed_ ^ other.packed_) & (packed_ ^ sum) & high_bits) != 0)
+                throw std::overflow_error("boost::units::runtime_dimension: exponent out of range");
+            packed_ = sum & all_fields;
+            return *this;
+        }
+
+        /// the dimension of a quotient
+        runtime_dimension& operator/=(const runtime_dimension& other)
+        {
+            const boost::uint64_t difference = ((packed_ | high_bits) - (other.packed_ & ~high_bits)) ^ ((packed_ ^ ~other.packed_) & high_bits);
+            if(((packed_ ^ other.packed_) & (packed_ ^ difference) & high_bits) != 0)
+                throw std::overflow_error("boost::units::runtime_dimension: exponent out of range");
+            packed_ = difference & all_fields;
+            return *this;
+        }
+
+        friend runtime_dimension operator*(runtime_dimension lhs, const runtime_dimension& rhs) { return lhs *= rhs; }
+        friend runtime_dimension operator/(runtime_dimension lhs, const runtime_dimension& rhs) { return lhs /= rhs; }
+
+        friend bool operator==(const runtime_dimension& lhs, const runtime_dimension& rhs)
+        {
+            return lhs.packed_ == rhs.packed_;
+        }
+
+        friend bool operator!=(const runtime_dimension& lhs, const runtime_dimension& rhs)
+        {
+            return lhs.packed_ != rhs.packed_;
+        }
+
+    private:
+        static const boost::uint64_t field_mask = (1u << bits) - 1;
+        static const boost::uint64_t all_fields = (static_cast<boost::uint64_t>(1) << (bits * size)) - 1;
+        // the sign bit of every field
+        static const boost::uint64_t high_bits = all_fields / field_mask * (field_mask ^ (field_mask >> 1));
+
+        boost::uint64_t packed_;
+};
+
+/// Raises a dimension to the integral power @c n.  Throws
+/// @c std::overflow_error if an exponent leaves [-32, 31].
+inline runtime_dimension pow(const runtime_dimension& d, int n)
+{
+    runtime_dimension result;
+    for(std::size_t i = 0; i < runtime_dimension::size; ++i)
+        result.set_exponent(i, static_cast<boost::intmax_t>(d.exponent(i)) * n);
+    return result;
+}
+
+/// Takes the @c n th root of a dimension.  Throws @c std::domain_error
+/// if @c n is zero or some exponent is not a multiple of @c n.
+inline runtime_dimension root(const runtime_dimension& d, int n)
+{
+    if(n == 0)
+        throw std::domain_error("boost::units::root: the zeroth root is undefined");
+    runtime_dimension result;
+    for(std::size_t i = 0; i < runtime_dimension::size; ++i)
+    {
+        if(d.exponent(i) % n != 0)
+            throw std::domain_error("boost::units::root: the exponents of the dimension are not multiples of the root");
+        result.set_exponent(i, d.exponent(i) / n);
+    }
+    return result;
+}
+
+/// A unit known only at runtime.  A value @c x in this unit is
+/// <tt>x * scale() + offset()</tt> in the coherent unit of the
+/// reference system with the same dimension.  The offset only
+/// applies to absolute values, such as temperatures in celsius.
+class runtime_unit
+{
+    public:
+        runtime_unit() : scale_(1.0), offset_(0.0) { }
+        runtime_unit(const std::string& name,
+                     const std::string& symbol,
+                     const runtime_dimension& dimension,
+                     double scale,
+                     double offset = 0.0) :
+            name_(name),
+            symbol_(symbol),
+            dimension_(dimension),
+            scale_(scale),
+            offset_(offset)
+        { }
+
+        const std::string& name() const { return name_; }
+        const std::string& symbol() const { return symbol_; }
+        const runtime_dimension& dimension() const { return dimension_; }
+        double scale() const { return scale_; }
+        double offset() const { return offset_; }
+
+    private:
+        std::string         name_;
+        std::string         symbol_;
+        runtime_dimension   dimension_;
+        double              scale_;
+        double              offset_;
+};
+
+namespace detail {
+
+/// The system that runtime units are expressed in.
+typedef make_system<
+    si::meter_base_unit,
+    si::kilogram_base_unit,
+    si::second_base_unit,
+    si::ampere_base_unit,
+    si::kelvin_base_unit,
+    si::mole_base_unit,
+    si::candela_base_unit,
+    angle::radian_base_unit,
+    angle::steradian_base_unit,
+    information::bit_base_unit
+>::type runtime_reference_system;
+
+template<class DimensionList>
+struct make_runtime_dimension_impl
+{
+    static void apply(runtime_dimension& result)
+    {
+        typedef typename DimensionList::item dim_type;
+        typedef typename dim_type::value_type exponent_type;
+        BOOST_STATIC_ASSERT_MSG(exponent_type::Denominator == 1,
+            "runtime units only support integral exponents");
+        result.set_exponent(runtime_dimension_index<typename dim_type::tag_type>::value,
+                            static_cast<int>(exponent_type::Numerator));
+        make_runtime_dimension_impl<typename DimensionList::next>::apply(result);
+    }
+};
+
+template<>
+struct make_runtime_dimension_impl<dimensionless_type>
+{
+    static void apply(runtime_dimension&) { }
+};
+
+template<bool IsDefined, bool ReverseIsDefined>
+struct runtime_unit_offset_impl
+{
+    template<class Unit, class Reference>
+    static double value() { return 0.0; }
+};
+
+template<bool ReverseIsDefined>
+struct runtime_unit_offset_impl<true, ReverseIsDefined>
+{
+    template<class Unit, class Reference>
+    static double value()
+    {
+        return affine_conversion_helper<Unit, Reference>::value();
+    }
+};
+
+template<>
+struct runtime_unit_offset_impl<false, true>
+{
+    template<class Unit, class Reference>
+    static double value()
+    {
+        return -affine_conversion_helper<Reference, Unit>::value() * conversion_factor(Unit(), Reference());
+    }
+};
+
+} // namespace detail
+
+/// The exponents of the base dimensions of a dimension list.
+template<class Dimension>
+inline runtime_dimension make_runtime_dimension()
+{
+    runtime_dimension result;
+    detail::make_runtime_dimension_impl<Dimension>::apply(result);
+    return result;
+}
+
+/// Describes @c Unit, using the strings from @c name_string and
+/// @c symbol_string.
+template<class Dim, class System>
+inline runtime_unit make_runtime_unit(const unit<Dim, System>& u)
+{
+    typedef typename reduce_unit<unit<Dim, System> >::type unit_type;
+    typedef typename reduce_unit<unit<Dim, detail::runtime_reference_system> >::type reference_type;
+    typedef detail::runtime_unit_offset_impl<
+        affine_conversion_helper<unit_type, reference_type>::is_defined,
+        affine_conversion_helper<reference_type, unit_type>::is_defined
+    > offset_impl;
+    return runtime_unit(name_string(u),
+                        symbol_string(u),
+                        make_runtime_dimension<Dim>(),
+                        conversion_factor(unit_type(), reference_type()),
+                        offset_impl::template value<unit_type, reference_type>());
+}
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_RUNTIME_UNIT_HPP
@@ -0,0 +1,432 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_RUNTIME_UNIT_REGISTRY_HPP
+#define BOOST_UNITS_RUNTIME_UNIT_REGISTRY_HPP
+
+///
+/// \file
+/// \brief Lookup of runtime units by symbol or name.
+/// \details @c runtime_unit_registry maps the symbol and the name of
+///   each unit to its @c runtime_unit through two open-addressing hash
+///   tables, so a lookup hashes the string once and usually compares
+///   it against a single candidate.  @c runtime_unit_registry::builtin
+///   holds the units of <tt>systems/si</tt>, <tt>systems/cgs</tt> and
+///   <tt>base_units</tt>.
+///
+
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/units/runtime_unit.hpp>
+#include <boost/units/detail/static_object.hpp>
+#include <boost/units/systems/cgs.hpp>
+#include <boost/units/systems/cgs/io.hpp>
+#include <boost/units/systems/si.hpp>
+#include <boost/units/systems/si/io.hpp>
+
+#include <boost/units/base_units/angle/arcminute.hpp>
+#include <boost/units/base_units/angle/arcsecond.hpp>
+#include <boost/units/base_units/angle/degree.hpp>
+#include <boost/units/base_units/angle/gradian.hpp>
+#include <boost/units/base_units/angle/revolution.hpp>
+#include <boost/units/base_units/astronomical/astronomical_unit.hpp>
+#include <boost/units/base_units/astronomical/light_day.hpp>
+#include <boost/units/base_units/astronomical/light_hour.hpp>
+#include <boost/units/base_units/astronomical/light_minute.hpp>
+#include <boost/units/base_units/astronomical/light_second.hpp>
+#include <boost/units/base_units/astronomical/light_year.hpp>
+#include <boost/units/base_units/astronomical/parsec.hpp>
+#include <boost/units/base_units/cgs/biot.hpp>
+#include <boost/units/base_units/cgs/centimeter.hpp>
+#include <boost/units/base_units/cgs/gram.hpp>
+#include <boost/units/base_units/imperial/drachm.hpp>
+#include <boost/units/base_units/imperial/fluid_ounce.hpp>
+#include <boost/units/base_units/imperial/foot.hpp>
+#include <boost/units/base_units/imperial/furlong.hpp>
+#include <boost/units/base_units/imperial/gallon.hpp>
+#include <boost/units/base_units/imperial/gill.hpp>
+#include <boost/units/base_units/imperial/grain.hpp>
+#include <boost/units/base_units/imperial/hundredweight.hpp>
+#include <boost/units/base_units/imperial/inch.hpp>
+#include <boost/units/base_units/imperial/league.hpp>
+#include <boost/units/base_units/imperial/mile.hpp>
+#include <boost/units/base_units/imperial/ounce.hpp>
+#include <boost/units/base_units/imperial/pint.hpp>
+#include <boost/units/base_units/imperial/pound.hpp>
+#include <boost/units/base_units/imperial/quart.hpp>
+#include <boost/units/base_units/imperial/quarter.hpp>
+#include <boost/units/base_units/imperial/stone.hpp>
+#include <boost/units/base_units/imperial/thou.hpp>
+#include <boost/units/base_units/imperial/ton.hpp>
+#include <boost/units/base_units/imperial/yard.hpp>
+#include <boost/units/base_units/information/byte.hpp>
+#include <boost/units/base_units/information/hartley.hpp>
+#include <boost/units/base_units/information/nat.hpp>
+#include <boost/units/base_units/information/shannon.hpp>
+#include <boost/units/base_units/metric/angstrom.hpp>
+#include <boost/units/base_units/metric/are.hpp>
+#include <boost/units/base_units/metric/atmosphere.hpp>
+#include <boost/units/base_units/metric/bar.hpp>
+#include <boost/units/base_units/metric/barn.hpp>
+#include <boost/units/base_units/metric/day.hpp>
+#include <boost/units/base_units/metric/fermi.hpp>
+#include <boost/units/base_units/metric/hectare.hpp>
+#include <boost/units/base_units/metric/hour.hpp>
+#include <boost/units/base_units/metric/knot.hpp>
+#include <boost/units/base_units/metric/liter.hpp>
+#include <boost/units/base_units/metric/micron.hpp>
+#include <boost/units/base_units/metric/minute.hpp>
+#include <boost/units/base_units/metric/mmHg.hpp>
+#include <boost/units/base_units/metric/nautical_mile.hpp>
+#include <boost/units/base_units/metric/ton.hpp>
+#include <boost/units/base_units/metric/torr.hpp>
+#include <boost/units/base_units/metric/year.hpp>
+#include <boost/units/base_units/temperature/celsius.hpp>
+#include <boost/units/base_units/temperature/fahrenheit.hpp>
+#include <boost/units/base_units/us/cup.hpp>
+#include <boost/units/base_units/us/dram.hpp>
+#include <boost/units/base_units/us/fluid_dram.hpp>
+#include <boost/units/base_units/us/fluid_ounce.hpp>
+#include <boost/units/base_units/us/foot.hpp>
+#include <boost/units/base_units/us/gallon.hpp>
+#include <boost/units/base_units/us/gill.hpp>
+#include <boost/units/base_units/us/grain.hpp>
+#include <boost/units/base_units/us/hundredweight.hpp>
+#include <boost/units/base_units/us/inch.hpp>
+#include <boost/units/base_units/us/mil.hpp>
+#include <boost/units/base_units/us/mile.hpp>
+#include <boost/units/base_units/us/minim.hpp>
+#include <boost/units/base_units/us/ounce.hpp>
+#include <boost/units/base_units/us/pint.hpp>
+#include <boost/units/base_units/us/pound.hpp>
+#include <boost/units/base_units/us/pound_force.hpp>
+#include <boost/units/base_units/us/quart.hpp>
+#include <boost/units/base_units/us/tablespoon.hpp>
+#include <boost/units/base_units/us/teaspoon.hpp>
+#include <boost/units/base_units/us/ton.hpp>
+#include <boost/units/base_units/us/yard.hpp>
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+/// FNV-1a
+inline boost::uint64_t runtime_unit_hash(const char* str, std::size_t len)
+{
+    boost::uint64_t result = UINT64_C(14695981039346656037);
+    for(std::size_t i = 0; i < len; ++i)
+    {
+        result ^= static_cast<unsigned char>(str[i]);
+        result *= UINT64_C(1099511628211);
+    }
+    return result;
+}
+
+} // namespace detail
+
+/// Maps the symbols and names of units to @c runtime_unit descriptions.
+/// Symbols and names are looked up separately and are case sensitive.
+/// When two units share a symbol or a name, the one inserted first
+/// keeps it.  Pointers returned by the lookup functions stay valid
+/// as long as the registry.
+class runtime_unit_registry
+{
+    private:
+        typedef std::deque<runtime_unit> storage_type;
+
+    public:
+        typedef storage_type::const_iterator    const_iterator;
+        typedef storage_type::size_type         size_type;
+
+        runtime_unit_registry() : symbols_(initial_capacity), names_(initial_capacity) { }
+
+        /// Adds @c u under its symbol and its name.  Returns false,
+        /// without adding anything, when both are already in use.
+        bool insert(const runtime_unit& u)
+        {
+            const bool has_symbol = !u.symbol().empty() && find_symbol(u.symbol()) == 0;
+            const bool has_name = !u.name().empty() && find_name(u.name()) == 0;
+            if(!has_symbol && !has_name) return false;
+
+            // keep both tables at most half full
+            if(2 * (units_.size() + 1) > symbols_.size()) rehash(2 * symbols_.size());
+
+            const std::size_t index = units_.size();
+            units_.push_back(u);
+            if(has_symbol) insert_key(symbols_, u.symbol(), index);
+            if(has_name) insert_key(names_, u.name(), index);
+            return true;
+        }
+
+        /// Adds the unit @c u as described by @c make_runtime_unit.
+        template<class Dim, class System>
+        bool insert(const unit<Dim, System>& u)
+        {
+            return insert(make_runtime_unit(u));
+        }
+
+        /// The unit with the symbol <tt>[str, str + len)</tt>, or null.
+        const runtime_unit* find_symbol(const char* str, std::size_t len) const
+        {
+            return find_key(symbols_, &runtime_unit::symbol, str, len);
+        }
+        const runtime_unit* find_symbol(const char* str) const { return find_symbol(str, std::strlen(str)); }
+        const runtime_unit* find_symbol(const std::string& str) const { return find_symbol(str.data(), str.size()); }
+
+        /// The unit with the name <tt>[str, str + len)</tt>, or null.
+        const runtime_unit* find_name(const char* str, std::size_t len) const
+        {
+            return find_key(names_, &runtime_unit::name, str, len);
+        }
+        const runtime_unit* find_name(const char* str) const { return find_name(str, std::strlen(str)); }
+        const runtime_unit* find_name(const std::string& str) const { return find_name(str.data(), str.size()); }
+
+        /// The unit with the symbol or, failing that, the name
+        /// <tt>[str, str + len)</tt>, or null.
+        const runtime_unit* find(const char* str, std::size_t len) const
+        {
+            const runtime_unit* result = find_symbol(str, len);
+            return result ? result : find_name(str, len);
+        }
+        const runtime_unit* find(const char* str) const { return find(str, std::strlen(str)); }
+        const runtime_unit* find(const std::string& str) const { return find(str.data(), str.size()); }
+
+        size_type size() const { return units_.size(); }
+        bool empty() const { return units_.empty(); }
+        const_iterator begin() const { return units_.begin(); }
+        const_iterator end() const { return units_.end(); }
+
+        /// The units of <tt>systems/si</tt>, <tt>systems/cgs</tt> and
+        /// <tt>base_units</tt>.  SI comes first, then CGS and the other
+        /// metric units, and US customary units before imperial ones,
+        /// so for instance "gal" is the US gallon.
+        static const runtime_unit_registry& builtin();
+
+    private:
+        BOOST_STATIC_CONSTANT(std::size_t, initial_capacity = 64);
+        BOOST_STATIC_CONSTANT(std::size_t, empty_slot = ~static_cast<std::size_t>(0));
+
+        struct slot
+        {
+            slot() : hash(0), index(empty_slot) { }
+            boost::uint64_t hash;
+            std::size_t     index;
+        };
+
+        typedef std::vector<slot> table_type;
+        typedef const std::string& (runtime_unit::*key_type)() const;
+
+        const runtime_unit* find_key(const table_type& table, key_type key, const char* str, std::size_t len) const
+        {
+            const boost::uint64_t hash = detail::runtime_unit_hash(str, len);
+            const std::size_t mask = table.size() - 1;
+            for(std::size_t i = static_cast<std::size_t>(hash) & mask; table[i].index != empty_slot; i = (i + 1) & mask)
+            {
+                if(table[i].hash != hash) continue;
+                const std::string& candidate = (units_[table[i].index].*key)();
+                if(candidate.size() == len && std::memcmp(candidate.data(), str, len) == 0)
+                    return &units_[table[i].index];
+            }
+            return 0;
+        }
+
+        static void insert_key(table_type& table, const std::string& key, std::size_t index)
+        {
+            slot s;
+            s.hash = detail::runtime_unit_hash(key.data(), key.size());
+            s.index = index;
+            insert_slot(table, s);
+        }
+
+        static void insert_slot(table_type& table, const slot& s)
+        {
+            const std::size_t mask = table.size() - 1;
+            std::size_t i = static_cast<std::size_t>(s.hash) & mask;
+            while(table[i].index != empty_slot) i = (i + 1) & mask;
+            table[i] = s;
+        }
+
+        void rehash(std::size_t capacity)
+        {
+            table_type symbols(capacity);
+            table_type names(capacity);
+            for(std::size_t i = 0; i < symbols_.size(); ++i)
+            {
+                if(symbols_[i].index != empty_slot) insert_slot(symbols, symbols_[i]);
+                if(names_[i].index != empty_slot) insert_slot(names, names_[i]);
+            }
+            symbols_.swap(symbols);
+            names_.swap(names);
+        }
+
+        storage_type    units_;
+        table_type      symbols_;
+        table_type      names_;
+};
+
+namespace detail {
+
+template<class BaseUnit>
+inline void insert_base_unit(runtime_unit_registry& registry)
+{
+    registry.insert(typename BaseUnit::unit_type());
+}
+
+inline void insert_builtin_units(runtime_unit_registry& r)
+{
+    // SI base and derived units
+    r.insert(si::meter);
+    r.insert(si::kilogram);
+    r.insert(si::second);
+    r.insert(si::ampere);
+    r.insert(si::kelvin);
+    r.insert(si::mole);
+    r.insert(si::candela);
+    r.insert(si::radian);
+    r.insert(si::steradian);
+    r.insert(si::coulomb);
+    r.insert(si::farad);
+    r.insert(si::gray);
+    r.insert(si::henry);
+    r.insert(si::hertz);
+    r.insert(si::joule);
+    r.insert(si::katal);
+    r.insert(si::lumen);
+    r.insert(si::lux);
+    r.insert(si::newton);
+    r.insert(si::ohm);
+    r.insert(si::pascal);
+    r.insert(si::siemens);
+    r.insert(si::tesla);
+    r.insert(si::volt);
+    r.insert(si::watt);
+    r.insert(si::weber);
+
+    // CGS base and derived units
+    r.insert(cgs::centimeter);
+    r.insert(cgs::gram);
+    r.insert(cgs::biot);
+    r.insert(cgs::gal);
+    r.insert(cgs::poise);
+    r.insert(cgs::erg);
+    r.insert(cgs::dyne);
+    r.insert(cgs::stoke);
+    r.insert(cgs::barye);
+    r.insert(cgs::kayser);
+
+    insert_base_unit<angle::degree_base_unit>(r);
+    insert_base_unit<angle::gradian_base_unit>(r);
+    insert_base_unit<angle::revolution_base_unit>(r);
+    insert_base_unit<angle::arcminute_base_unit>(r);
+    insert_base_unit<angle::arcsecond_base_unit>(r);
+
+    insert_base_unit<temperature::celsius_base_unit>(r);
+    insert_base_unit<temperature::fahrenheit_base_unit>(r);
+
+    insert_base_unit<information::bit_base_unit>(r);
+    insert_base_unit<information::byte_base_unit>(r);
+    insert_base_unit<information::nat_base_unit>(r);
+    insert_base_unit<information::hartley_base_unit>(r);
+    insert_base_unit<information::shannon_base_unit>(r);
+
+    insert_base_unit<metric::angstrom_base_unit>(r);
+    insert_base_unit<metric::are_base_unit>(r);
+    insert_base_unit<metric::atmosphere_base_unit>(r);
+    insert_base_unit<metric::bar_base_unit>(r);
+    insert_base_unit<metric::barn_base_unit>(r);
+    insert_base_unit<metric::day_base_unit>(r);
+    insert_base_unit<metric::fermi_base_unit>(r);
+    insert_base_unit<metric::hectare_base_unit>(r);
+    insert_base_unit<metric::hour_base_unit>(r);
+    insert_base_unit<metric::knot_base_unit>(r);
+    insert_base_unit<metric::liter_base_unit>(r);
+    insert_base_unit<metric::micron_base_unit>(r);
+    insert_base_unit<metric::minute_base_unit>(r);
+    insert_base_unit<metric::mmHg_base_unit>(r);
+    insert_base_unit<metric::nautical_mile_base_unit>(r);
+    insert_base_unit<metric::ton_base_unit>(r);
+    insert_base_unit<metric::torr_base_unit>(r);
+    insert_base_unit<metric::year_base_unit>(r);
+
+    insert_base_unit<astronomical::astronomical_unit_base_unit>(r);
+    insert_base_unit<astronomical::light_second_base_unit>(r);
+    insert_base_unit<astronomical::light_minute_base_unit>(r);
+    insert_base_unit<astronomical::light_hour_base_unit>(r);
+    insert_base_unit<astronomical::light_day_base_unit>(r);
+    insert_base_unit<astronomical::light_year_base_unit>(r);
+    insert_base_unit<astronomical::parsec_base_unit>(r);
+
+    insert_base_unit<us::cup_base_unit>(r);
+    insert_base_unit<us::dram_base_unit>(r);
+    insert_base_unit<us::fluid_dram_base_unit>(r);
+    insert_base_unit<us::fluid_ounce_base_unit>(r);
+    insert_base_unit<us::foot_base_unit>(r);
+    insert_base_unit<us::gallon_base_unit>(r);
+    insert_base_unit<us::gill_base_unit>(r);
+    insert_base_unit<us::grain_base_unit>(r);
+    insert_base_unit<us::hundredweight_base_unit>(r);
+    insert_base_unit<us::inch_base_unit>(r);
+    insert_base_unit<us::mil_base_unit>(r);
+    insert_base_unit<us::mile_base_unit>(r);
+    insert_base_unit<us::minim_base_unit>(r);
+    insert_base_unit<us::ounce_base_unit>(r);
+    insert_base_unit<us::pint_base_unit>(r);
+    insert_base_unit<us::pound_base_unit>(r);
+    insert_base_unit<us::pound_force_base_unit>(r);
+    insert_base_unit<us::quart_base_unit>(r);
+    insert_base_unit<us::tablespoon_base_unit>(r);
+    insert_base_unit<us::teaspoon_base_unit>(r);
+    insert_base_unit<us::ton_base_unit>(r);
+    insert_base_unit<us::yard_base_unit>(r);
+
+    insert_base_unit<imperial::drachm_base_unit>(r);
+    insert_base_unit<imperial::fluid_ounce_base_unit>(r);
+    insert_base_unit<imperial::foot_base_unit>(r);
+    insert_base_unit<imperial::furlong_base_unit>(r);
+    insert_base_unit<imperial::gallon_base_unit>(r);
+    insert_base_unit<imperial::gill_base_unit>(r);
+    insert_base_unit<imperial::grain_base_unit>(r);
+    insert_base_unit<imperial::hundredweight_base_unit>(r);
+    insert_base_unit<imperial::inch_base_unit>(r);
+    insert_base_unit<imperial::league_base_unit>(r);
+    insert_base_unit<imperial::mile_base_unit>(r);
+    insert_base_unit<imperial::ounce_base_unit>(r);
+    insert_base_unit<imperial::pint_base_unit>(r);
+    insert_base_unit<imperial::pound_base_unit>(r);
+    insert_base_unit<imperial::quart_base_unit>(r);
+    insert_base_unit<imperial::quarter_base_unit>(r);
+    insert_base_unit<imperial::stone_base_unit>(r);
+    insert_base_unit<imperial::thou_base_unit>(r);
+    insert_base_unit<imperial::ton_base_unit>(r);
+    insert_base_unit<imperial::yard_base_unit>(r);
+}
+
+struct builtin_registry : runtime_unit_registry
+{
+    builtin_registry() { insert_builtin_units(*this); }
+};
+
+} // namespace detail
+
+inline const runtime_unit_registry& runtime_unit_registry::builtin()
+{
+    return detail::static_object<detail::builtin_registry>::get();
+}
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_RUNTIME_UNIT_REGISTRY_HPP
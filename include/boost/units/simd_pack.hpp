@@ -0,0 +1,460 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_SIMD_PACK_HPP
+#define BOOST_UNITS_SIMD_PACK_HPP
+
+///
+/// \file
+/// \brief A fixed-width packed value type for use as @c quantity<Unit, simd_pack<T,N> >.
+/// \details @c simd_pack holds @c N lanes of @c T in a suitably aligned
+///   block and implements every operation lane-wise with a fixed trip count,
+///   which compilers map directly onto SSE2, AVX2 or AVX-512 registers
+///   depending on the target flags.  No intrinsics are used, so the same
+///   code is portable to any target.  Comparisons return a @c simd_mask
+///   rather than a @c bool.  The math functions are found by ADL from the
+///   overloads in cmath.hpp, so @c sqrt, @c hypot, @c fma, @c pow<>,
+///   trigonometric functions, etc. all work on packed quantities.
+///
+
+#include <cstddef>
+#include <ostream>
+
+#include <boost/config.hpp>
+#include <boost/config/no_tr1/cmath.hpp>
+#include <boost/math/special_functions/hypot.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/units/config.hpp>
+#include <boost/units/detail/cmath_impl.hpp>
+#include <boost/units/operators.hpp>
+#include <boost/units/quantity.hpp>
+
+/// The width in bytes of the widest vector register that the target is
+/// compiled for.  Used to choose the lane count of @c native_simd_pack.
+#ifndef BOOST_UNITS_SIMD_BYTES
+    #if defined(__AVX512F__)
+        #define BOOST_UNITS_SIMD_BYTES 64
+    #elif defined(__AVX__)
+        #define BOOST_UNITS_SIMD_BYTES 32
+    #else
+        #define BOOST_UNITS_SIMD_BYTES 16
+    #endif
+#endif
+
+namespace boost {
+
+namespace units {
+
+template<class T, std::size_t N> class simd_pack;
+
+/// The result of a lane-wise comparison of two @c simd_pack.
+template<class T, std::size_t N>
+class simd_mask
+{
+    public:
+        typedef simd_mask<T, N>     this_type;
+        typedef bool                value_type;
+
+        BOOST_STATIC_CONSTEXPR std::size_t size = N;
+
+        simd_mask() { for(std::size_t i = 0; i < N; ++i) m_[i] = false; }
+        explicit simd_mask(bool b) { for(std::size_t i = 0; i < N; ++i) m_[i] = b; }
+
+        bool operator[](std::size_t i) const { return m_[i]; }
+        bool& operator[](std::size_t i) { return m_[i]; }
+
+        friend this_type operator&&(const this_type& lhs, const this_type& rhs)
+        {
+            this_type result;
+            for(std::size_t i = 0; i < N; ++i) result.m_[i] = lhs.m_[i] && rhs.m_[i];
+            return result;
+        }
+        friend this_type operator||(const this_type& lhs, const this_type& rhs)
+        {
+            this_type result;
+            for(std::size_t i = 0; i < N; ++i) result.m_[i] = lhs.m_[i] || rhs.m_[i];
+            return result;
+        }
+        friend this_type operator!(const this_type& arg)
+        {
+            this_type result;
+            for(std::size_t i = 0; i < N; ++i) result.m_[i] = !arg.m_[i];
+            return result;
+        }
+
+    private:
+        bool m_[N];
+};
+
+template<class T, std::size_t N>
+BOOST_CONSTEXPR_OR_CONST std::size_t simd_mask<T, N>::size;
+
+/// true if every lane of the mask is set
+template<class T, std::size_t N>
+inline bool all_of(const simd_mask<T, N>& m)
+{
+    bool result = true;
+    for(std::size_t i = 0; i < N; ++i) result = result && m[i];
+    return result;
+}
+
+/// true if any lane of the mask is set
+template<class T, std::size_t N>
+inline bool any_of(const simd_mask<T, N>& m)
+{
+    bool result = false;
+    for(std::size_t i = 0; i < N; ++i) result = result || m[i];
+    return result;
+}
+
+/// true if no lane of the mask is set
+template<class T, std::size_t N>
+inline bool none_of(const simd_mask<T, N>& m)
+{
+    return !(any_of)(m);
+}
+
+/// @c N lanes of @c T processed together.  @c N must be a power of two.
+template<class T, std::size_t N>
+class simd_pack
+{
+        BOOST_STATIC_ASSERT_MSG((N != 0 && (N & (N - 1)) == 0), "the lane count of a simd_pack must be a power of two");
+    public:
+        typedef simd_pack<T, N>     this_type;
+        typedef T                   value_type;
+        typedef simd_mask<T, N>     mask_type;
+
+        BOOST_STATIC_CONSTEXPR std::size_t size = N;
+
+        simd_pack() { for(std::size_t i = 0; i < N; ++i) v_[i] = T(); }
+
+        /// broadcast a scalar to every lane
+        explicit simd_pack(const T& val) { for(std::size_t i = 0; i < N; ++i) v_[i] = val; }
+
+        /// lane-wise conversion is implicit if it is for the lane type
+        template<class U>
+        simd_pack(const simd_pack<U, N>& source,
+            typename boost::enable_if<detail::is_non_narrowing_conversion<U, T> >::type* = 0)
+        {
+            for(std::size_t i = 0; i < N; ++i) v_[i] = source[i];
+        }
+
+        /// lane-wise conversion is explicit if it narrows the lane type
+        template<class U>
+        explicit simd_pack(const simd_pack<U, N>& source,
+            typename boost::disable_if<detail::is_non_narrowing_conversion<U, T> >::type* = 0)
+        {
+            for(std::size_t i = 0; i < N; ++i) v_[i] = static_cast<T>(source[i]);
+        }
+
+        /// load @c N values from unaligned memory
+        static this_type load(const T* src)
+        {
+            this_type result;
+            for(std::size_t i = 0; i < N; ++i) result.v_[i] = src[i];
+            return result;
+        }
+
+        /// store @c N values to unaligned memory
+        void store(T* dest) const { for(std::size_t i = 0; i < N; ++i) dest[i] = v_[i]; }
+
+        const T& operator[](std::size_t i) const { return v_[i]; }
+        T& operator[](std::size_t i) { return v_[i]; }
+
+        this_type& operator+=(const this_type& rhs) { for(std::size_t i = 0; i < N; ++i) v_[i] += rhs.v_[i]; return *this; }
+        this_type& operator-=(const this_type& rhs) { for(std::size_t i = 0; i < N; ++i) v_[i] -= rhs.v_[i]; return *this; }
+        this_type& operator*=(const this_type& rhs) { for(std::size_t i = 0; i < N; ++i) v_[i] *= rhs.v_[i]; return *this; }
+        this_type& operator/=(const this_type& rhs) { for(std::size_t i = 0; i < N; ++i) v_[i] /= rhs.v_[i]; return *this; }
+        this_type& operator*=(const T& rhs) { for(std::size_t i = 0; i < N; ++i) v_[i] *= rhs; return *this; }
+        this_type& operator/=(const T& rhs) { for(std::size_t i = 0; i < N; ++i) v_[i] /= rhs; return *this; }
+
+    private:
+        BOOST_ALIGNMENT(sizeof(T) * N) T v_[N];
+};
+
+template<class T, std::size_t N>
+BOOST_CONSTEXPR_OR_CONST std::size_t simd_pack<T, N>::size;
+
+/// The @c simd_pack of @c T that fills one register of the target.
+template<class T>
+struct native_simd_pack
+{
+    typedef simd_pack<T, (sizeof(T) < BOOST_UNITS_SIMD_BYTES ? BOOST_UNITS_SIMD_BYTES / sizeof(T) : 1)> type;
+};
+
+// The lane-wise functions are written in terms of these so that every
+// loop has the same shape and a compile-time trip count.
+#define BOOST_UNITS_SIMD_UNARY(name_, expr_)                                    \
+template<class T, std::size_t N>                                                \
+inline simd_pack<T, N> name_(const simd_pack<T, N>& x)                          \
+{                                                                               \
+    simd_pack<T, N> result;                                                     \
+    for(std::size_t i = 0; i < N; ++i) result[i] = (expr_);                     \
+    return result;                                                              \
+}
+
+#define BOOST_UNITS_SIMD_BINARY(name_, expr_)                                   \
+template<class T, std::size_t N>                                                \
+inline simd_pack<T, N> name_(const simd_pack<T, N>& x, const simd_pack<T, N>& y)\
+{                                                                               \
+    simd_pack<T, N> result;                                                     \
+    for(std::size_t i = 0; i < N; ++i) result[i] = (expr_);                     \
+    return result;                                                              \
+}
+
+#define BOOST_UNITS_SIMD_COMPARE(op_)                                           \
+template<class T, std::size_t N>                                                \
+inline simd_mask<T, N> operator op_(const simd_pack<T, N>& x, const simd_pack<T, N>& y)\
+{                                                                               \
+    simd_mask<T, N> result;                                                     \
+    for(std::size_t i = 0; i < N; ++i) result[i] = (x[i] op_ y[i]);             \
+    return result;                                                              \
+}
+
+// arithmetic
+
+template<class T, std::size_t N>
+inline simd_pack<T, N> operator+(const simd_pack<T, N>& x) { return x; }
+
+template<class T, std::size_t N>
+inline simd_pack<T, N> operator-(const simd_pack<T, N>& x)
+{
+    simd_pack<T, N> result;
+    for(std::size_t i = 0; i < N; ++i) result[i] = -x[i];
+    return result;
+}
+
+BOOST_UNITS_SIMD_BINARY(operator+, x[i] + y[i])
+BOOST_UNITS_SIMD_BINARY(operator-, x[i] - y[i])
+BOOST_UNITS_SIMD_BINARY(operator*, x[i] * y[i])
+BOOST_UNITS_SIMD_BINARY(operator/, x[i] / y[i])
+
+// The scalar is a non-deduced parameter, so that e.g. a conversion
+// factor of type double can multiply a pack of float.
+template<class T, std::size_t N>
+inline simd_pack<T, N> operator*(const simd_pack<T, N>& x, const typename simd_pack<T, N>::value_type& s)
+{
+    simd_pack<T, N> result(x);
+    return result *= s;
+}
+
+template<class T, std::size_t N>
+inline simd_pack<T, N> operator*(const typename simd_pack<T, N>::value_type& s, const simd_pack<T, N>& x)
+{
+    simd_pack<T, N> result(x);
+    return result *= s;
+}
+
+template<class T, std::size_t N>
+inline simd_pack<T, N> operator/(const simd_pack<T, N>& x, const typename simd_pack<T, N>::value_type& s)
+{
+    simd_pack<T, N> result(x);
+    return result /= s;
+}
+
+template<class T, std::size_t N>
+inline simd_pack<T, N> operator/(const typename simd_pack<T, N>::value_type& s, const simd_pack<T, N>& x)
+{
+    return simd_pack<T, N>(s) / x;
+}
+
+template<class T, std::size_t N>
+inline simd_pack<T, N> operator+(const simd_pack<T, N>& x, const typename simd_pack<T, N>::value_type& s)
+{
+    return x + simd_pack<T, N>(s);
+}
+
+template<class T, std::size_t N>
+inline simd_pack<T, N> operator-(const simd_pack<T, N>& x, const typename simd_pack<T, N>::value_type& s)
+{
+    return x - simd_pack<T, N>(s);
+}
+
+// comparisons
+
+BOOST_UNITS_SIMD_COMPARE(==)
+BOOST_UNITS_SIMD_COMPARE(!=)
+BOOST_UNITS_SIMD_COMPARE(<)
+BOOST_UNITS_SIMD_COMPARE(<=)
+BOOST_UNITS_SIMD_COMPARE(>)
+BOOST_UNITS_SIMD_COMPARE(>=)
+
+/// lane-wise choice: @c a where the mask is set, @c b elsewhere
+template<class T, std::size_t N>
+inline simd_pack<T, N> select(const simd_mask<T, N>& m, const simd_pack<T, N>& a, const simd_pack<T, N>& b)
+{
+    simd_pack<T, N> result;
+    for(std::size_t i = 0; i < N; ++i) result[i] = m[i] ? a[i] : b[i];
+    return result;
+}
+
+// math functions, found by ADL from cmath.hpp
+
+BOOST_UNITS_SIMD_UNARY(abs, x[i] < T(0) ? -x[i] : x[i])
+BOOST_UNITS_SIMD_UNARY(fabs, std::fabs(x[i]))
+BOOST_UNITS_SIMD_UNARY(sqrt, std::sqrt(x[i]))
+BOOST_UNITS_SIMD_UNARY(floor, std::floor(x[i]))
+BOOST_UNITS_SIMD_UNARY(ceil, std::ceil(x[i]))
+BOOST_UNITS_SIMD_UNARY(exp, std::exp(x[i]))
+BOOST_UNITS_SIMD_UNARY(log, std::log(x[i]))
+BOOST_UNITS_SIMD_UNARY(log10, std::log10(x[i]))
+BOOST_UNITS_SIMD_UNARY(sin, std::sin(x[i]))
+BOOST_UNITS_SIMD_UNARY(cos, std::cos(x[i]))
+BOOST_UNITS_SIMD_UNARY(tan, std::tan(x[i]))
+BOOST_UNITS_SIMD_UNARY(asin, std::asin(x[i]))
+BOOST_UNITS_SIMD_UNARY(acos, std::acos(x[i]))
+BOOST_UNITS_SIMD_UNARY(atan, std::atan(x[i]))
+
+BOOST_UNITS_SIMD_BINARY(atan2, std::atan2(x[i], y[i]))
+BOOST_UNITS_SIMD_BINARY(hypot, boost::math::hypot BOOST_PREVENT_MACRO_SUBSTITUTION (x[i], y[i]))
+BOOST_UNITS_SIMD_BINARY(fmin, x[i] < y[i] ? x[i] : y[i])
+BOOST_UNITS_SIMD_BINARY(fmax, x[i] < y[i] ? y[i] : x[i])
+
+/// lane-wise x*y+z, rounded once where @c std::fma is available, so that
+/// each lane matches @c fma of a single quantity
+template<class T, std::size_t N>
+inline simd_pack<T, N> fma(const simd_pack<T, N>& x, const simd_pack<T, N>& y, const simd_pack<T, N>& z)
+{
+    simd_pack<T, N> result;
+#ifdef BOOST_UNITS_HAS_STD_FMA
+    for(std::size_t i = 0; i < N; ++i) result[i] = std::fma(x[i], y[i], z[i]);
+#else
+    for(std::size_t i = 0; i < N; ++i) result[i] = x[i] * y[i] + z[i];
+#endif
+    return result;
+}
+
+/// raise every lane to a runtime exponent; used by @c pow<> for rational exponents
+template<class T, std::size_t N>
+inline simd_pack<T, N> pow(const simd_pack<T, N>& x, const typename simd_pack<T, N>::value_type& e)
+{
+    simd_pack<T, N> result;
+    for(std::size_t i = 0; i < N; ++i) result[i] = std::pow(x[i], e);
+    return result;
+}
+
+#undef BOOST_UNITS_SIMD_UNARY
+#undef BOOST_UNITS_SIMD_BINARY
+#undef BOOST_UNITS_SIMD_COMPARE
+
+/// Print the lanes of a pack, e.g. "(1 2 3 4)".
+template<class Char, class Traits, class T, std::size_t N>
+inline std::basic_ostream<Char, Traits>& operator<<(std::basic_ostream<Char, Traits>& os, const simd_pack<T, N>& x)
+{
+    os << '(';
+    for(std::size_t i = 0; i < N; ++i)
+    {
+        if(i != 0) os << ' ';
+        os << x[i];
+    }
+    os << ')';
+    return os;
+}
+
+// Comparisons of packed quantities yield masks.  These are more
+// specialized than the overloads in quantity.hpp, which return bool.
+
+/// lane-wise quantity comparison
+template<class Unit, class T, std::size_t N>
+inline simd_mask<T, N> operator==(const quantity<Unit, simd_pack<T, N> >& q1, const quantity<Unit, simd_pack<T, N> >& q2)
+{ return q1.value() == q2.value(); }
+
+/// lane-wise quantity comparison
+template<class Unit, class T, std::size_t N>
+inline simd_mask<T, N> operator!=(const quantity<Unit, simd_pack<T, N> >& q1, const quantity<Unit, simd_pack<T, N> >& q2)
+{ return q1.value() != q2.value(); }
+
+/// lane-wise quantity comparison
+template<class Unit, class T, std::size_t N>
+inline simd_mask<T, N> operator<(const quantity<Unit, simd_pack<T, N> >& q1, const quantity<Unit, simd_pack<T, N> >& q2)
+{ return q1.value() < q2.value(); }
+
+/// lane-wise quantity comparison
+template<class Unit, class T, std::size_t N>
+inline simd_mask<T, N> operator<=(const quantity<Unit, simd_pack<T, N> >& q1, const quantity<Unit, simd_pack<T, N> >& q2)
+{ return q1.value() <= q2.value(); }
+
+/// lane-wise quantity comparison
+template<class Unit, class T, std::size_t N>
+inline simd_mask<T, N> operator>(const quantity<Unit, simd_pack<T, N> >& q1, const quantity<Unit, simd_pack<T, N> >& q2)
+{ return q1.value() > q2.value(); }
+
+/// lane-wise quantity comparison
+template<class Unit, class T, std::size_t N>
+inline simd_mask<T, N> operator>=(const quantity<Unit, simd_pack<T, N> >& q1, const quantity<Unit, simd_pack<T, N> >& q2)
+{ return q1.value() >= q2.value(); }
+
+/// scalar times packed quantity, broadcasting the scalar
+template<class Unit, class T, std::size_t N>
+inline quantity<Unit, simd_pack<T, N> > operator*(const typename simd_pack<T, N>::value_type& lhs,
+                                                  const quantity<Unit, simd_pack<T, N> >& rhs)
+{
+    return quantity<Unit, simd_pack<T, N> >::from_value(lhs * rhs.value());
+}
+
+/// packed quantity times scalar, broadcasting the scalar
+template<class Unit, class T, std::size_t N>
+inline quantity<Unit, simd_pack<T, N> > operator*(const quantity<Unit, simd_pack<T, N> >& lhs,
+                                                  const typename simd_pack<T, N>::value_type& rhs)
+{
+    return quantity<Unit, simd_pack<T, N> >::from_value(lhs.value() * rhs);
+}
+
+/// packed quantity divided by scalar, broadcasting the scalar
+template<class Unit, class T, std::size_t N>
+inline quantity<Unit, simd_pack<T, N> > operator/(const quantity<Unit, simd_pack<T, N> >& lhs,
+                                                  const typename simd_pack<T, N>::value_type& rhs)
+{
+    return quantity<Unit, simd_pack<T, N> >::from_value(lhs.value() / rhs);
+}
+
+/// lane-wise choice between two packed quantities
+template<class Unit, class T, std::size_t N>
+inline quantity<Unit, simd_pack<T, N> > select(const simd_mask<T, N>& m,
+                                               const quantity<Unit, simd_pack<T, N> >& a,
+                                               const quantity<Unit, simd_pack<T, N> >& b)
+{
+    return quantity<Unit, simd_pack<T, N> >::from_value((select)(m, a.value(), b.value()));
+}
+
+/// load @c N consecutive quantities from raw memory into one packed quantity
+template<class Unit, std::size_t N, class T>
+inline quantity<Unit, simd_pack<T, N> > load_quantity(const Unit&, const T* src)
+{
+    return quantity<Unit, simd_pack<T, N> >::from_value(simd_pack<T, N>::load(src));
+}
+
+/// store the lanes of a packed quantity to raw memory
+template<class Unit, class T, std::size_t N>
+inline void store_quantity(const quantity<Unit, simd_pack<T, N> >& q, T* dest)
+{
+    q.value().store(dest);
+}
+
+/// the quantity in lane @c i of a packed quantity
+template<class Unit, class T, std::size_t N>
+inline quantity<Unit, T> lane(const quantity<Unit, simd_pack<T, N> >& q, std::size_t i)
+{
+    return quantity<Unit, T>::from_value(q.value()[i]);
+}
+
+} // namespace units
+
+} // namespace boost
+
+#if BOOST_UNITS_HAS_BOOST_TYPEOF
+
+#include BOOST_TYPEOF_INCREMENT_REGISTRATION_GROUP()
+
+BOOST_TYPEOF_REGISTER_TEMPLATE(boost::units::simd_pack, (class)(std::size_t))
+BOOST_TYPEOF_REGISTER_TEMPLATE(boost::units::simd_mask, (class)(std::size_t))
+
+#endif
+
+#endif // BOOST_UNITS_SIMD_PACK_HPP
@@ -16,5 +16,6 @@
 #include <boost/units/systems/information/hartley.hpp>
 #include <boost/units/systems/information/shannon.hpp>
 #include <boost/units/systems/information/prefixes.hpp>
+#include <boost/units/systems/information/rate.hpp>
 
 #endif
@@ -11,10 +11,12 @@
 #define BOOST_UNITS_SYSTEMS_INFORMATION_BYTE_HPP_INCLUDED
 
 #include <boost/units/make_system.hpp>
+#include <boost/units/quantity.hpp>
 #include <boost/units/unit.hpp>
 #include <boost/units/static_constant.hpp>
 
 #include <boost/units/base_units/information/byte.hpp>
+#include <boost/units/physical_dimensions/data_rate.hpp>
 
 namespace boost {
 namespace units { 
@@ -39,6 +41,7 @@ BOOST_UNITS_STATIC_CONSTANT(bytes, hu::byte::info);
 typedef hu::byte::info info;
 
 } // namespace information
+
 } // namespace units
 } // namespace boost
 
@@ -0,0 +1,84 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_SYSTEMS_INFORMATION_RATE_HPP_INCLUDED
+#define BOOST_UNITS_SYSTEMS_INFORMATION_RATE_HPP_INCLUDED
+
+#include <string>
+
+#include <boost/units/operators.hpp>
+#include <boost/units/reduce_unit.hpp>
+#include <boost/units/static_constant.hpp>
+#include <boost/units/unit.hpp>
+
+#include <boost/units/base_units/information/clock_cycle.hpp>
+#include <boost/units/base_units/information/operation.hpp>
+#include <boost/units/systems/information/bit.hpp>
+#include <boost/units/systems/information/byte.hpp>
+#include <boost/units/systems/si/time.hpp>
+
+namespace boost {
+namespace units {
+namespace information {
+
+namespace hu {
+namespace byte {
+typedef divide_typeof_helper<info, si::time>::type data_rate;
+} // namespace byte
+namespace bit {
+typedef divide_typeof_helper<info, si::time>::type data_rate;
+} // namespace bit
+} // namespace hu
+
+// As for info, the default data rate is in bytes.
+typedef hu::byte::data_rate data_rate;
+
+BOOST_UNITS_STATIC_CONSTANT(byte_per_second, hu::byte::data_rate);
+BOOST_UNITS_STATIC_CONSTANT(bytes_per_second, hu::byte::data_rate);
+BOOST_UNITS_STATIC_CONSTANT(bit_per_second, hu::bit::data_rate);
+BOOST_UNITS_STATIC_CONSTANT(bits_per_second, hu::bit::data_rate);
+
+// Operations and clock cycles have dimensions of their own, so that
+// they can be neither added to each other nor confused with frequency.
+typedef operation_base_unit::unit_type operation_count;
+typedef clock_cycle_base_unit::unit_type cycle_count;
+
+BOOST_UNITS_STATIC_CONSTANT(operation, operation_count);
+BOOST_UNITS_STATIC_CONSTANT(operations, operation_count);
+BOOST_UNITS_STATIC_CONSTANT(cycle, cycle_count);
+BOOST_UNITS_STATIC_CONSTANT(cycles, cycle_count);
+
+typedef divide_typeof_helper<operation_count, si::time>::type operation_rate;
+typedef divide_typeof_helper<cycle_count, si::time>::type cycle_rate;
+typedef divide_typeof_helper<info, cycle_count>::type data_per_cycle;
+
+BOOST_UNITS_STATIC_CONSTANT(operations_per_second, operation_rate);
+BOOST_UNITS_STATIC_CONSTANT(iops, operation_rate);
+BOOST_UNITS_STATIC_CONSTANT(cycles_per_second, cycle_rate);
+BOOST_UNITS_STATIC_CONSTANT(bytes_per_cycle, data_per_cycle);
+
+} // namespace information
+
+inline std::string name_string(const reduce_unit<information::hu::byte::data_rate>::type&) { return "byte per second"; }
+inline std::string symbol_string(const reduce_unit<information::hu::byte::data_rate>::type&) { return "B/s"; }
+
+inline std::string name_string(const reduce_unit<information::hu::bit::data_rate>::type&) { return "bit per second"; }
+inline std::string symbol_string(const reduce_unit<information::hu::bit::data_rate>::type&) { return "b/s"; }
+
+inline std::string name_string(const reduce_unit<information::operation_rate>::type&) { return "operation per second"; }
+inline std::string symbol_string(const reduce_unit<information::operation_rate>::type&) { return "op/s"; }
+
+inline std::string name_string(const reduce_unit<information::cycle_rate>::type&) { return "cycle per second"; }
+inline std::string symbol_string(const reduce_unit<information::cycle_rate>::type&) { return "cycle/s"; }
+
+inline std::string name_string(const reduce_unit<information::data_per_cycle>::type&) { return "byte per cycle"; }
+inline std::string symbol_string(const reduce_unit<information::data_per_cycle>::type&) { return "B/cycle"; }
+
+} // namespace units
+} // namespace boost
+
+#endif // BOOST_UNITS_SYSTEMS_INFORMATION_RATE_HPP_INCLUDED
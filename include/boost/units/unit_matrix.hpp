@@ -0,0 +1,335 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNITS_UNIT_MATRIX_HPP
+#define BOOST_UNITS_UNIT_MATRIX_HPP
+
+///
+/// \file
+/// \brief Matrices with a different unit in every element.
+/// \details A @c unit_matrix has a unit for each row and a unit for each
+///   column, given as MPL sequences, and the unit of element (i, j) is
+///   the product of the unit of row i and the unit of column j.  This is
+///   the form of every matrix that can be multiplied, such as the system
+///   matrix of a state-space model.  The values are stored as one
+///   row-major array of @c Y, which @c data() exposes, so that the
+///   matrices can also be handed to BLAS.  The units of sums and
+///   products are checked and deduced at compile time, and the products
+///   are computed by a plain loop over the values.
+///
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/mpl/transform.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/units/operators.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/units_fwd.hpp>
+
+namespace boost {
+
+namespace units {
+
+namespace detail {
+
+/// True if <tt>Op<Seq1[i], Seq2[i]>::type</tt> is @c Result for every
+/// @c i less than @c N.
+template<template<class, class> class Op, class Seq1, class Seq2, class Result, long N>
+struct unit_matrix_all_same
+{
+    BOOST_STATIC_CONSTANT(bool, value =
+        (is_same<typename Op<typename mpl::at_c<Seq1, N - 1>::type,
+                             typename mpl::at_c<Seq2, N - 1>::type>::type, Result>::value &&
+         unit_matrix_all_same<Op, Seq1, Seq2, Result, N - 1>::value));
+};
+
+template<template<class, class> class Op, class Seq1, class Seq2, class Result>
+struct unit_matrix_all_same<Op, Seq1, Seq2, Result, 0>
+{
+    BOOST_STATIC_CONSTANT(bool, value = true);
+};
+
+template<class Unit>
+struct unit_matrix_multiply_by
+{
+    template<class T>
+    struct apply { typedef typename multiply_typeof_helper<T, Unit>::type type; };
+};
+
+/// The matrices with rows @c Rows1 and columns @c Columns1 and with rows
+/// @c Rows2 and columns @c Columns2 have the same units in every element
+/// if the units of their rows differ by the same factor as the units of
+/// their columns differ by its inverse.
+template<class Rows1, class Columns1, class Rows2, class Columns2>
+struct unit_matrix_equivalent
+{
+    typedef typename divide_typeof_helper<
+        typename mpl::at_c<Rows1, 0>::type,
+        typename mpl::at_c<Rows2, 0>::type
+    >::type factor;
+    typedef typename divide_typeof_helper<
+        typename mpl::at_c<Columns2, 0>::type,
+        typename mpl::at_c<Columns1, 0>::type
+    >::type inverse_factor;
+
+    BOOST_STATIC_CONSTANT(bool, value =
+        (mpl::size<Rows1>::value == mpl::size<Rows2>::value &&
+         mpl::size<Columns1>::value == mpl::size<Columns2>::value &&
+         is_same<factor, inverse_factor>::value &&
+         unit_matrix_all_same<divide_typeof_helper, Rows1, Rows2, factor, mpl::size<Rows1>::value>::value &&
+         unit_matrix_all_same<divide_typeof_helper, Columns2, Columns1, factor, mpl::size<Columns1>::value>::value));
+};
+
+/// <tt>C = A B</tt> for row-major @c A of @c M by @c K and @c B of @c K by
+/// @c N.  The innermost loop runs along rows of @c B and @c C, so that it
+/// can be vectorized, and the compile-time bounds let small products be
+/// unrolled completely.
+template<std::size_t M, std::size_t N, std::size_t K, class Y>
+inline void unit_matrix_gemm(const Y* a, const Y* b, Y* c)
+{
+    for(std::size_t i = 0; i < M; ++i)
+    {
+        Y* const row = c + i * N;
+        for(std::size_t j = 0; j < N; ++j)
+            row[j] = Y();
+        for(std::size_t k = 0; k < K; ++k)
+        {
+            const Y aik = a[i * K + k];
+            const Y* const brow = b + k * N;
+            for(std::size_t j = 0; j < N; ++j)
+                row[j] += aik * brow[j];
+        }
+    }
+}
+
+} // namespace detail
+
+/// \brief A matrix of values of @c Y in which element (i, j) has the unit
+///   <tt>RowUnits[i] * ColumnUnits[j]</tt>.
+/// \details Elements are accessed with compile-time indices as quantities,
+///   or with run-time indices as raw values.  A column vector is a matrix
+///   with a single dimensionless column.
+template<class RowUnits, class ColumnUnits, class Y = double>
+class unit_matrix
+{
+    public:
+        typedef unit_matrix<RowUnits, ColumnUnits, Y>   this_type;
+        typedef RowUnits                                row_units;
+        typedef ColumnUnits                             column_units;
+        typedef Y                                       value_type;
+        typedef std::size_t                             size_type;
+
+        BOOST_STATIC_CONSTANT(size_type, rows = mpl::size<RowUnits>::value);
+        BOOST_STATIC_CONSTANT(size_type, columns = mpl::size<ColumnUnits>::value);
+
+        BOOST_STATIC_ASSERT_MSG(rows > 0 && columns > 0, "a unit_matrix must have at least one row and one column");
+
+        /// the unit of element (I, J)
+        template<size_type I, size_type J>
+        struct element_unit
+        {
+            typedef typename multiply_typeof_helper<
+                typename mpl::at_c<RowUnits, I>::type,
+                typename mpl::at_c<ColumnUnits, J>::type
+            >::type type;
+        };
+
+        /// all elements zero
+        unit_matrix()
+        {
+            for(size_type i = 0; i < rows * columns; ++i) values_[i] = Y();
+        }
+
+        /// copy the values of the elements, row by row, from @c values
+        explicit unit_matrix(const Y* values)
+        {
+            for(size_type i = 0; i < rows * columns; ++i) values_[i] = values[i];
+        }
+
+        /// copy a matrix with the same unit in every element
+        template<class RowUnits2, class ColumnUnits2>
+        unit_matrix(const unit_matrix<RowUnits2, ColumnUnits2, Y>& other)
+        {
+            BOOST_STATIC_ASSERT_MSG((detail::unit_matrix_equivalent<RowUnits, ColumnUnits, RowUnits2, ColumnUnits2>::value),
+                "the elements of the matrices must have the same units");
+            const Y* const values = other.data();
+            for(size_type i = 0; i < rows * columns; ++i) values_[i] = values[i];
+        }
+
+        /// the values of the elements, row by row
+        Y* data() { return values_; }
+        const Y* data() const { return values_; }
+
+        /// the raw value of element (i, j)
+        Y& value(size_type i, size_type j)
+        {
+            BOOST_ASSERT(i < rows && j < columns);
+            return values_[i * columns + j];
+        }
+        const Y& value(size_type i, size_type j) const
+        {
+            BOOST_ASSERT(i < rows && j < columns);
+            return values_[i * columns + j];
+        }
+
+        template<size_type I, size_type J>
+        quantity<typename element_unit<I, J>::type, Y> get() const
+        {
+            BOOST_STATIC_ASSERT(I < rows && J < columns);
+            return quantity<typename element_unit<I, J>::type, Y>::from_value(values_[I * columns + J]);
+        }
+
+        template<size_type I, size_type J>
+        void set(const quantity<typename element_unit<I, J>::type, Y>& q)
+        {
+            BOOST_STATIC_ASSERT(I < rows && J < columns);
+            values_[I * columns + J] = q.value();
+        }
+
+        template<class RowUnits2, class ColumnUnits2>
+        this_type& operator+=(const unit_matrix<RowUnits2, ColumnUnits2, Y>& other)
+        {
+            BOOST_STATIC_ASSERT_MSG((detail::unit_matrix_equivalent<RowUnits, ColumnUnits, RowUnits2, ColumnUnits2>::value),
+                "the elements of the matrices must have the same units");
+            const Y* const values = other.data();
+            for(size_type i = 0; i < rows * columns; ++i) values_[i] += values[i];
+            return *this;
+        }
+
+        template<class RowUnits2, class ColumnUnits2>
+        this_type& operator-=(const unit_matrix<RowUnits2, ColumnUnits2, Y>& other)
+        {
+            BOOST_STATIC_ASSERT_MSG((detail::unit_matrix_equivalent<RowUnits, ColumnUnits, RowUnits2, ColumnUnits2>::value),
+                "the elements of the matrices must have the same units");
+            const Y* const values = other.data();
+            for(size_type i = 0; i < rows * columns; ++i) values_[i] -= values[i];
+            return *this;
+        }
+
+        this_type& operator*=(const Y& factor)
+        {
+            for(size_type i = 0; i < rows * columns; ++i) values_[i] *= factor;
+            return *this;
+        }
+
+        this_type& operator/=(const Y& factor)
+        {
+            for(size_type i = 0; i < rows * columns; ++i) values_[i] /= factor;
+            return *this;
+        }
+
+    private:
+        Y values_[rows * columns];
+};
+
+/// The type of the product of unit matrices with rows @c Rows1 and
+/// columns @c Columns1 and with rows @c Rows2 and columns @c Columns2.
+/// The column units of the first times the row units of the second must
+/// be the same unit throughout, which multiplies the rows of the result.
+template<class Rows1, class Columns1, class Rows2, class Columns2, class Y>
+struct unit_matrix_product
+{
+    typedef typename multiply_typeof_helper<
+        typename mpl::at_c<Columns1, 0>::type,
+        typename mpl::at_c<Rows2, 0>::type
+    >::type inner_unit;
+
+    BOOST_STATIC_ASSERT_MSG((mpl::size<Columns1>::value == mpl::size<Rows2>::value),
+        "the number of columns of the first matrix must be the number of rows of the second");
+    BOOST_STATIC_ASSERT_MSG((detail::unit_matrix_all_same<multiply_typeof_helper, Columns1, Rows2, inner_unit,
+                                                          mpl::size<Columns1>::value>::value),
+        "the products of the column units of the first matrix and the row units of the second must all be the same");
+
+    typedef unit_matrix<
+        typename mpl::transform<Rows1, detail::unit_matrix_multiply_by<inner_unit> >::type,
+        Columns2,
+        Y
+    > type;
+};
+
+template<class Rows1, class Columns1, class Rows2, class Columns2, class Y>
+inline unit_matrix<Rows1, Columns1, Y>
+operator+(const unit_matrix<Rows1, Columns1, Y>& lhs, const unit_matrix<Rows2, Columns2, Y>& rhs)
+{
+    unit_matrix<Rows1, Columns1, Y> result(lhs);
+    result += rhs;
+    return result;
+}
+
+template<class Rows1, class Columns1, class Rows2, class Columns2, class Y>
+inline unit_matrix<Rows1, Columns1, Y>
+operator-(const unit_matrix<Rows1, Columns1, Y>& lhs, const unit_matrix<Rows2, Columns2, Y>& rhs)
+{
+    unit_matrix<Rows1, Columns1, Y> result(lhs);
+    result -= rhs;
+    return result;
+}
+
+/// matrix product, with the units of the result deduced as for
+/// @c unit_matrix_product
+template<class Rows1, class Columns1, class Rows2, class Columns2, class Y>
+inline typename unit_matrix_product<Rows1, Columns1, Rows2, Columns2, Y>::type
+operator*(const unit_matrix<Rows1, Columns1, Y>& lhs, const unit_matrix<Rows2, Columns2, Y>& rhs)
+{
+    typedef typename unit_matrix_product<Rows1, Columns1, Rows2, Columns2, Y>::type result_type;
+    result_type result;
+    detail::unit_matrix_gemm<result_type::rows, result_type::columns, unit_matrix<Rows1, Columns1, Y>::columns>(
+        lhs.data(), rhs.data(), result.data());
+    return result;
+}
+
+template<class Rows, class Columns, class Y>
+inline unit_matrix<Rows, Columns, Y>
+operator*(const unit_matrix<Rows, Columns, Y>& m, const Y& factor)
+{
+    unit_matrix<Rows, Columns, Y> result(m);
+    result *= factor;
+    return result;
+}
+
+template<class Rows, class Columns, class Y>
+inline unit_matrix<Rows, Columns, Y>
+operator*(const Y& factor, const unit_matrix<Rows, Columns, Y>& m)
+{
+    unit_matrix<Rows, Columns, Y> result(m);
+    result *= factor;
+    return result;
+}
+
+/// the product of a quantity and each element
+template<class Unit, class Rows, class Columns, class Y>
+inline unit_matrix<typename mpl::transform<Rows, detail::unit_matrix_multiply_by<Unit> >::type, Columns, Y>
+operator*(const quantity<Unit, Y>& q, const unit_matrix<Rows, Columns, Y>& m)
+{
+    unit_matrix<typename mpl::transform<Rows, detail::unit_matrix_multiply_by<Unit> >::type, Columns, Y> result(m.data());
+    result *= q.value();
+    return result;
+}
+
+/// the transpose, whose rows have the units of the columns of @c m
+template<class Rows, class Columns, class Y>
+inline unit_matrix<Columns, Rows, Y> transpose(const unit_matrix<Rows, Columns, Y>& m)
+{
+    typedef unit_matrix<Rows, Columns, Y> matrix_type;
+    unit_matrix<Columns, Rows, Y> result;
+    for(std::size_t i = 0; i < matrix_type::rows; ++i)
+        for(std::size_t j = 0; j < matrix_type::columns; ++j)
+            result.value(j, i) = m.value(i, j);
+    return result;
+}
+
+} // namespace units
+
+} // namespace boost
+
+#endif // BOOST_UNITS_UNIT_MATRIX_HPP
@@ -0,0 +1,153 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief compile_time.cpp
+
+\details
+Synthetic translation unit for measuring the compile-time cost of the
+library, driven by compile_time.py.
+
+The preprocessor generates BOOST_UNITS_CT_DIMENSIONS base dimensions, each
+with BOOST_UNITS_CT_BASE_UNITS base units and conversion factors between
+them.  An expression of BOOST_UNITS_CT_DEPTH factors alternately multiplies
+and divides quantities of these base units, which produces heterogeneous
+systems whose dimension lists have to be sorted and merged at each step,
+and the result is converted to the system made of the first base unit of
+every dimension, which runs the linear algebra in heterogeneous_system.hpp.
+**/
+
+#include <boost/preprocessor/arithmetic/inc.hpp>
+#include <boost/preprocessor/cat.hpp>
+#include <boost/preprocessor/punctuation/comma_if.hpp>
+#include <boost/preprocessor/repetition/repeat.hpp>
+
+#include <boost/units/base_dimension.hpp>
+#include <boost/units/base_unit.hpp>
+#include <boost/units/conversion.hpp>
+#include <boost/units/get_dimension.hpp>
+#include <boost/units/make_system.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/unit.hpp>
+
+#ifndef BOOST_UNITS_CT_DIMENSIONS
+#define BOOST_UNITS_CT_DIMENSIONS 4
+#endif
+
+#ifndef BOOST_UNITS_CT_BASE_UNITS
+#define BOOST_UNITS_CT_BASE_UNITS 2
+#endif
+
+#ifndef BOOST_UNITS_CT_DEPTH
+#define BOOST_UNITS_CT_DEPTH 8
+#endif
+
+#if BOOST_UNITS_CT_DIMENSIONS > 10
+#error make_system accepts at most 10 base units
+#endif
+
+namespace compile_time {
+
+template<int Dimension, int Unit> struct base_unit_at;
+
+#define BOOST_UNITS_CT_UNIT(d, u) BOOST_PP_CAT(BOOST_PP_CAT(unit_, d), BOOST_PP_CAT(_, u))
+
+#define BOOST_UNITS_CT_DIMENSION(z, d, _)                                       \
+    struct BOOST_PP_CAT(dimension_, d) :                                        \
+        boost::units::base_dimension<BOOST_PP_CAT(dimension_, d), BOOST_PP_INC(d)> { };
+
+BOOST_PP_REPEAT(BOOST_UNITS_CT_DIMENSIONS, BOOST_UNITS_CT_DIMENSION, ~)
+
+#define BOOST_UNITS_CT_BASE_UNIT(z, u, d)                                       \
+    struct BOOST_UNITS_CT_UNIT(d, u) :           \
+        boost::units::base_unit<                                                \
+            BOOST_UNITS_CT_UNIT(d, u),           \
+            BOOST_PP_CAT(dimension_, d)::dimension_type,                        \
+            BOOST_PP_INC(d) * 100 + u> { };                                     \
+    template<> struct base_unit_at<d, u>                                        \
+    { typedef BOOST_UNITS_CT_UNIT(d, u) type; };
+
+#define BOOST_UNITS_CT_BASE_UNITS_OF(z, d, _)                                   \
+    BOOST_PP_REPEAT_ ## z(BOOST_UNITS_CT_BASE_UNITS, BOOST_UNITS_CT_BASE_UNIT, d)
+
+BOOST_PP_REPEAT(BOOST_UNITS_CT_DIMENSIONS, BOOST_UNITS_CT_BASE_UNITS_OF, ~)
+
+#define BOOST_UNITS_CT_FIRST_UNIT(z, d, _)                                      \
+    BOOST_PP_COMMA_IF(d) BOOST_UNITS_CT_UNIT(d, 0)
+
+typedef boost::units::make_system<
+    BOOST_PP_REPEAT(BOOST_UNITS_CT_DIMENSIONS, BOOST_UNITS_CT_FIRST_UNIT, ~)
+>::type target_system;
+
+/// The k-th factor of the expression cycles through the dimensions first
+/// and then through the base units of each dimension.
+template<int K>
+struct factor
+{
+    typedef typename base_unit_at<
+        K % BOOST_UNITS_CT_DIMENSIONS,
+        (K / BOOST_UNITS_CT_DIMENSIONS) % BOOST_UNITS_CT_BASE_UNITS
+    >::type::unit_type unit_type;
+    typedef boost::units::quantity<unit_type> type;
+    static type value() { return(type::from_value(K + 1.0)); }
+};
+
+/// Even factors multiply and odd factors divide.
+template<int K, bool Divide = (K % 2 == 1)>
+struct expression
+{
+    typedef typename boost::units::multiply_typeof_helper<
+        typename expression<K - 1>::type,
+        typename factor<K>::type
+    >::type type;
+    static type value() { return(expression<K - 1>::value() * factor<K>::value()); }
+};
+
+template<int K>
+struct expression<K, true>
+{
+    typedef typename boost::units::divide_typeof_helper<
+        typename expression<K - 1>::type,
+        typename factor<K>::type
+    >::type type;
+    static type value() { return(expression<K - 1>::value() / factor<K>::value()); }
+};
+
+template<>
+struct expression<0, false>
+{
+    typedef factor<0>::type type;
+    static type value() { return(factor<0>::value()); }
+};
+
+} // namespace compile_time
+
+// conversions from every base unit to the first one of its dimension
+#define BOOST_UNITS_CT_CONVERSION(z, u, d)                                      \
+    BOOST_UNITS_DEFINE_CONVERSION_FACTOR(                                       \
+        compile_time::BOOST_UNITS_CT_UNIT(d, u), \
+        compile_time::BOOST_UNITS_CT_UNIT(d, 0),                                 \
+        double, u + 1.0);
+
+#define BOOST_UNITS_CT_CONVERSIONS_OF(z, d, _)                                  \
+    BOOST_PP_REPEAT_ ## z(BOOST_UNITS_CT_BASE_UNITS, BOOST_UNITS_CT_CONVERSION, d)
+
+BOOST_PP_REPEAT(BOOST_UNITS_CT_DIMENSIONS, BOOST_UNITS_CT_CONVERSIONS_OF, ~)
+
+int main()
+{
+    using namespace compile_time;
+    typedef expression<BOOST_UNITS_CT_DEPTH - 1> result;
+    typedef boost::units::unit<
+        boost::units::get_dimension<result::type>::type,
+        target_system
+    > target_unit;
+    const boost::units::quantity<target_unit> converted(result::value());
+    return(converted.value() > 0 ? 0 : 1);
+}
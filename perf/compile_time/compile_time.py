@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+#
+# Boost.Units - A C++ library for zero-overhead dimensional analysis and
+# unit/quantity manipulation and conversion
+#
+# Distributed under the Boost Software License, Version 1.0. (See
+# accompanying file LICENSE_1_0.txt or copy at
+# http://www.boost.org/LICENSE_1_0.txt)
+
+"""Measure the compile-time cost of Boost.Units.
+
+compile_time.cpp is compiled once per configuration of
+
+  D  base dimensions          (BOOST_UNITS_CT_DIMENSIONS, at most 10)
+  B  base units per dimension (BOOST_UNITS_CT_BASE_UNITS)
+  N  factors in the expression (BOOST_UNITS_CT_DEPTH)
+
+and the best wall-clock time and the peak memory of the compiler are
+reported.  By default each parameter is swept on its own around D=4 B=2
+N=8; --grid compiles every combination instead.
+
+With --time-trace DIR the traces of the last compilation of each
+configuration are collected in DIR: the -ftime-trace JSON for clang, or
+the -ftime-report text for compilers without -ftime-trace such as GCC.
+
+With --baseline FILE the results are compared against a CSV file written
+by an earlier run with --csv, and the script fails if the time or memory
+of any configuration grew by more than --max-ratio.
+"""
+
+import argparse
+import csv
+import glob
+import itertools
+import os
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SOURCE = os.path.join(HERE, 'compile_time.cpp')
+INCLUDE = os.path.normpath(os.path.join(HERE, '..', '..', 'include'))
+
+DEFAULT = (4, 2, 8)
+SWEEP = {
+    'dimensions': [1, 2, 4, 7, 10],
+    'base_units': [1, 2, 4, 8],
+    'depth': [1, 4, 16, 64, 128],
+}
+
+FIELDS = ['dimensions', 'base_units', 'depth', 'seconds', 'peak_kb']
+
+
+def int_list(text):
+    return [int(x) for x in text.split(',') if x]
+
+
+def configurations(args):
+    if args.grid:
+        return list(itertools.product(args.dimensions, args.base_units, args.depth))
+    result = []
+    for d in args.dimensions:
+        result.append((d, DEFAULT[1], DEFAULT[2]))
+    for b in args.base_units:
+        result.append((DEFAULT[0], b, DEFAULT[2]))
+    for n in args.depth:
+        result.append((DEFAULT[0], DEFAULT[1], n))
+    # keep the first occurrence of the shared default point
+    return list(dict.fromkeys(result))
+
+
+def peak_kb(usage):
+    # ru_maxrss is in kilobytes on Linux and in bytes on macOS
+    if sys.platform == 'darwin':
+        return usage.ru_maxrss // 1024
+    return usage.ru_maxrss
+
+
+def is_clang(cxx):
+    try:
+        version = subprocess.check_output([cxx, '--version'], stderr=subprocess.STDOUT)
+    except (OSError, subprocess.CalledProcessError):
+        return False
+    return b'clang' in version
+
+
+def compile_once(command):
+    """Runs the compiler and returns (seconds, peak kilobytes, stderr).
+
+    os.wait4 reports the peak resident set of the driver and of the
+    compiler processes it waited for, so this works for drivers such as
+    g++ that run the actual compiler as a child process.
+    """
+    start = time.monotonic()
+    process = subprocess.Popen(command, stderr=subprocess.PIPE)
+    stderr = process.stderr.read()
+    _, status, usage = os.wait4(process.pid, 0)
+    elapsed = time.monotonic() - start
+    # the process has been reaped, keep Popen from waiting for it again
+    process.returncode = status
+    if not os.WIFEXITED(status) or os.WEXITSTATUS(status) != 0:
+        sys.stderr.write(stderr.decode(errors='replace'))
+        raise RuntimeError('compilation failed: ' + ' '.join(command))
+    return elapsed, peak_kb(usage), stderr
+
+
+def measure(args, config, workdir):
+    d, b, n = config
+    name = 'compile_time_d%d_b%d_n%d' % config
+    obj = os.path.join(workdir, name + '.o')
+    command = [args.cxx] + shlex.split(args.cxxflags)
+    command += ['-I' + i for i in [INCLUDE] + args.include]
+    command += [
+        '-DBOOST_UNITS_CT_DIMENSIONS=%d' % d,
+        '-DBOOST_UNITS_CT_BASE_UNITS=%d' % b,
+        '-DBOOST_UNITS_CT_DEPTH=%d' % n,
+    ]
+    if args.time_trace:
+        command.append('-ftime-trace' if args.clang else '-ftime-report')
+    command += ['-c', SOURCE, '-o', obj]
+
+    best_time, best_memory = None, None
+    for _ in range(args.repeat):
+        seconds, memory, report = compile_once(command)
+        best_time = seconds if best_time is None else min(best_time, seconds)
+        best_memory = memory if best_memory is None else min(best_memory, memory)
+
+    if args.time_trace and args.clang:
+        # clang writes the trace next to the object file
+        traces = glob.glob(os.path.join(workdir, name + '*.json'))
+        if not traces:
+            sys.stderr.write('warning: %s did not write a time trace\n' % args.cxx)
+        for trace in traces:
+            shutil.copy(trace, os.path.join(args.time_trace, name + '.json'))
+    elif args.time_trace:
+        with open(os.path.join(args.time_trace, name + '.txt'), 'wb') as f:
+            f.write(report)
+
+    return {
+        'dimensions': d,
+        'base_units': b,
+        'depth': n,
+        'seconds': '%.3f' % best_time,
+        'peak_kb': best_memory,
+    }
+
+
+def compare(results, baseline_file, max_ratio):
+    """Returns the configurations that regressed against the baseline."""
+    with open(baseline_file) as f:
+        baseline = dict(((int(r['dimensions']), int(r['base_units']), int(r['depth'])), r)
+                        for r in csv.DictReader(f))
+    regressions = []
+    for r in results:
+        old = baseline.get((r['dimensions'], r['base_units'], r['depth']))
+        if old is None:
+            continue
+        for field in ('seconds', 'peak_kb'):
+            ratio = float(r[field]) / max(float(old[field]), 1e-9)
+            if ratio > max_ratio:
+                regressions.append('D=%d B=%d N=%d: %s %s -> %s (%.2fx)' % (
+                    r['dimensions'], r['base_units'], r['depth'],
+                    field, old[field], r[field], ratio))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--cxx', default=os.environ.get('CXX', 'c++'),
+                        help='compiler to measure (default: $CXX or c++)')
+    parser.add_argument('--cxxflags', default='-std=c++11',
+                        help='compiler flags (default: %(default)s)')
+    parser.add_argument('-I', '--include', action='append', default=[],
+                        help='additional include directory, e.g. the Boost root')
+    parser.add_argument('--dimensions', type=int_list, default=SWEEP['dimensions'])
+    parser.add_argument('--base-units', type=int_list, default=SWEEP['base_units'])
+    parser.add_argument('--depth', type=int_list, default=SWEEP['depth'])
+    parser.add_argument('--grid', action='store_true',
+                        help='compile every combination instead of one sweep per parameter')
+    parser.add_argument('--repeat', type=int, default=3,
+                        help='compilations per configuration, the best is kept')
+    parser.add_argument('--time-trace', metavar='DIR',
+                        help='collect -ftime-trace output in DIR')
+    parser.add_argument('--csv', metavar='FILE', help='write the results to FILE')
+    parser.add_argument('--baseline', metavar='FILE',
+                        help='fail if the results regressed against FILE')
+    parser.add_argument('--max-ratio', type=float, default=1.25,
+                        help='allowed growth against the baseline (default: %(default)s)')
+    args = parser.parse_args()
+
+    args.clang = is_clang(args.cxx)
+    if args.time_trace:
+        os.makedirs(args.time_trace, exist_ok=True)
+
+    results = []
+    workdir = tempfile.mkdtemp(prefix='boost_units_compile_time')
+    try:
+        print('%4s %4s %5s %10s %12s' % ('D', 'B', 'N', 'seconds', 'peak KB'))
+        for config in configurations(args):
+            r = measure(args, config, workdir)
+            results.append(r)
+            print('%4d %4d %5d %10s %12d' % (r['dimensions'], r['base_units'],
+                                              r['depth'], r['seconds'], r['peak_kb']))
+            sys.stdout.flush()
+    finally:
+        shutil.rmtree(workdir)
+
+    if args.csv:
+        with open(args.csv, 'w', newline='') as f:
+            writer = csv.DictWriter(f, fieldnames=FIELDS)
+            writer.writeheader()
+            writer.writerows(results)
+
+    if args.baseline:
+        regressions = compare(results, args.baseline, args.max_ratio)
+        for r in regressions:
+            print('regression: ' + r)
+        if regressions:
+            return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,820 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Copyright (C) 2003-2008 Matthias Christian Schabel
+// Copyright (C) 2008 Steven Watanabe
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief performance.cpp
+
+\details
+Runtime benchmark comparing @c double against @c quantity.
+
+Every case runs the same kernel twice, once on raw @c double values and
+once on the equivalent quantities, and reports the median time per
+item, the quantity throughput and the median quantity/double ratio (the
+abstraction penalty) over 21 pairs of batches.  The results of both kernels are checked against each other.
+The program fails if a result differs or if a ratio exceeds its limit.
+
+Options:
+@verbatim
+--max-ratio=R   limit for the zero-overhead cases (default 1.5)
+--min-time=S    minimum seconds spent timing each kernel (default 0.5)
+--csv=FILE      also write the results to FILE
+--no-check      report only, never fail on a ratio
+@endverbatim
+
+Output:
+@verbatim
+
+case                       items  double ns  quantity ns   quantity Mitem/s  ratio  limit
+arithmetic                  4096      0.653        0.658           1519.696   1.01   1.50
+conversion_factor           4096      0.384        0.435           2300.029   1.13   1.50
+scaled conversion           4096      0.386        0.369           2713.141   0.95   1.50
+absolute temperature        4096      0.492        0.416           2404.421   0.84   1.50
+cmath sqrt                  4096      2.804        2.079            480.972   0.74   1.50
+cmath atan2                 4096     25.256       26.166             38.217   1.04   1.50
+tiled multiply           1728000      0.686        0.666           1500.581   0.97   1.50
+ode solve                   1000     28.008       28.081             35.612   1.00   1.50
+operator<<                   256    339.847      408.626              2.447   1.20   3.00
+
+@endverbatim
+**/
+
+#define _SCL_SECURE_NO_WARNINGS
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+#include <chrono>
+#endif
+
+#include <boost/units/absolute.hpp>
+#include <boost/units/cmath.hpp>
+#include <boost/units/io.hpp>
+#include <boost/units/make_scaled_unit.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/systems/si.hpp>
+#include <boost/units/systems/temperature/fahrenheit.hpp>
+#include <boost/units/base_units/us/foot.hpp>
+
+// Without optimization the quantity wrappers are not inlined and the
+// ratios say nothing about the library, so they are reported but not
+// enforced.
+#if (defined(__GNUC__) && !defined(__OPTIMIZE__)) || (defined(BOOST_MSVC) && defined(_DEBUG))
+#define BOOST_UNITS_PERF_UNOPTIMIZED
+#endif
+
+enum {
+    tile_block_size = 24
+};
+
+template<class T0, class T1, class Out>
+void tiled_multiply_carray_inner(T0* first,
+                                 T1* second,
+                                 Out* out,
+                                 int totalwidth,
+                                 int width2,
+                                 int height1,
+                                 int common) {
+    for(int j = 0; j < height1; ++j) {
+        for(int i = 0; i < width2; ++i) {
+            Out value = out[j * totalwidth + i];
+            for(int k = 0; k < common; ++k) {
+                value += first[k + totalwidth * j] * second[k * totalwidth + i];
+            }
+            out[j * totalwidth + i] = value;
+        }
+    }
+}
+
+template<class T0, class T1, class Out>
+void tiled_multiply_carray_outer(T0* first,
+                                 T1* second,
+                                 Out* out,
+                                 int width2,
+                                 int height1,
+                                 int common) {
+    std::fill_n(out, width2 * height1, Out());
+    int j = 0;
+    for(; j < height1 - tile_block_size; j += tile_block_size) {
+        int i = 0;
+        for(; i < width2 - tile_block_size; i += tile_block_size) {
+            int k = 0;
+            for(; k < common - tile_block_size; k += tile_block_size) {
+                tiled_multiply_carray_inner(
+                    &first[k + width2 * j],
+                    &second[k * width2 + i],
+                    &out[j * width2 + i],
+                    width2,
+                    tile_block_size,
+                    tile_block_size,
+                    tile_block_size);
+            }
+            tiled_multiply_carray_inner(
+                &first[k + width2 * j],
+                &second[k * width2 + i],
+                &out[j * width2 + i],
+                width2,
+                tile_block_size,
+                tile_block_size,
+                common - k);
+        }
+        int k = 0;
+        for(; k < common - tile_block_size; k += tile_block_size) {
+            tiled_multiply_carray_inner(
+                &first[k + width2 * j],
+                &second[k * width2 + i],
+                &out[j * width2 + i],
+                width2, width2 - i,
+                tile_block_size,
+                tile_block_size);
+        }
+        tiled_multiply_carray_inner(
+            &first[k + width2 * j],
+            &second[k * width2 + i],
+            &out[j * width2 + i],
+            width2, width2 - i,
+            tile_block_size,
+            common - k);
+    }
+    int i = 0;
+    for(; i < width2 - tile_block_size; i += tile_block_size) {
+        int k = 0;
+        for(; k < common - tile_block_size; k += tile_block_size) {
+            tiled_multiply_carray_inner(
+                &first[k + width2 * j],
+                &second[k * width2 + i],
+                &out[j * width2 + i],
+                width2,
+                tile_block_size,
+                height1 - j,
+                tile_block_size);
+        }
+        tiled_multiply_carray_inner(
+            &first[k + width2 * j],
+            &second[k * width2 + i],
+            &out[j * width2 + i],
+            width2,
+            tile_block_size,
+            height1 - j,
+            common - k);
+    }
+    int k = 0;
+    for(; k < common - tile_block_size; k += tile_block_size) {
+        tiled_multiply_carray_inner(
+            &first[k + width2 * j],
+            &second[k * width2 + i],
+            &out[j * width2 + i],
+            width2,
+            width2 - i,
+            height1 - j,
+            tile_block_size);
+    }
+    tiled_multiply_carray_inner(
+        &first[k + width2 * j],
+        &second[k * width2 + i],
+        &out[j * width2 + i],
+        width2,
+        width2 - i,
+        height1 - j,
+        common - k);
+}
+
+template<class F, class T, class N, class R>
+BOOST_CXX14_CONSTEXPR
+R solve_differential_equation(F f, T lower, T upper, N steps, R start) {
+    typedef typename F::template result<T, R>::type f_result;
+    T h = (upper - lower) / (1.0*steps);
+    for(N i = N(); i < steps; ++i) {
+        R y = start;
+        T x = lower + h * (1.0*i);
+        f_result k1 = f(x, y);
+        f_result k2 = f(x + h / 2.0, y + h * k1 / 2.0);
+        f_result k3 = f(x + h / 2.0, y + h * k2 / 2.0);
+        f_result k4 = f(x + h, y + h * k3);
+        start = y + h * (k1 + 2.0 * k2 + 2.0 * k3 + k4) / 6.0;
+    }
+    return(start);
+}
+
+using namespace boost::units;
+
+//y' = 1 - x + 4 * y
+struct f {
+    template<class Arg1, class Arg2> struct result;
+
+    BOOST_CONSTEXPR double operator()(const double& x, const double& y) const {
+        return(1.0 - x + 4.0 * y);
+    }
+
+    boost::units::quantity<boost::units::si::velocity>
+    BOOST_CONSTEXPR operator()(const quantity<si::time>& x,
+                               const quantity<si::length>& y) const {
+        using namespace boost::units;
+        using namespace si;
+        return(1.0 * meters / second -
+                x * meters / pow<2>(seconds) +
+                4.0 * y / seconds );
+    }
+};
+
+template<>
+struct f::result<double,double> {
+    typedef double type;
+};
+
+template<>
+struct f::result<quantity<si::time>, quantity<si::length> > {
+    typedef quantity<si::velocity> type;
+};
+
+//y' = 1 - x + 4 * y
+//y(0) = 1
+//y(x) = 1/4 * x - 3/16 + 19/16 * e ^ (4 * x)
+
+typedef us::foot_base_unit::unit_type                                   foot_unit;
+typedef make_scaled_unit<si::length, scale<10, static_rational<3> > >::type kilometer_unit;
+typedef absolute<fahrenheit::temperature>                               fahrenheit_absolute;
+typedef absolute<si::temperature>                                       kelvin_absolute;
+
+namespace {
+
+enum {
+    vector_size = 4096,
+    print_size = 256,
+    matrix_size = 120,
+    ode_steps = 1000
+};
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+
+double now() {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#else
+
+double now() {
+    return double(std::clock()) / CLOCKS_PER_SEC;
+}
+
+#endif
+
+// keeps the optimizer from merging or discarding the stores of
+// consecutive kernel invocations
+inline void clobber() {
+#if defined(__GNUC__)
+    __asm__ __volatile__("" : : : "memory");
+#endif
+}
+
+template<class Unit>
+std::vector<quantity<Unit> > make_quantities(const std::vector<double>& raw, const Unit&) {
+    std::vector<quantity<Unit> > result;
+    result.reserve(raw.size());
+    for(std::size_t i = 0; i < raw.size(); ++i)
+        result.push_back(quantity<Unit>::from_value(raw[i]));
+    return(result);
+}
+
+template<class Q>
+double raw_sum(const std::vector<Q>& values) {
+    double result = 0;
+    for(std::size_t i = 0; i < values.size(); ++i)
+        result += values[i].value();
+    return(result);
+}
+
+double raw_sum(const std::vector<double>& values) {
+    double result = 0;
+    for(std::size_t i = 0; i < values.size(); ++i)
+        result += values[i];
+    return(result);
+}
+
+// input shared by all the element-wise kernels, in [1, 2)
+struct data_set {
+    data_set() : x(vector_size), y(vector_size), z(vector_size) {
+        std::srand(1492);
+        for(std::size_t i = 0; i < vector_size; ++i) {
+            x[i] = 1.0 + std::rand() / (RAND_MAX + 1.0);
+            y[i] = 1.0 + std::rand() / (RAND_MAX + 1.0);
+            z[i] = 1.0 + std::rand() / (RAND_MAX + 1.0);
+        }
+    }
+    std::vector<double> x, y, z;
+};
+
+//
+// Each kernel provides operator() (the timed work), items() (the number
+// of elements processed per call) and checksum() (compared between the
+// double and quantity variants after timing).
+//
+
+struct arithmetic_double {
+    explicit arithmetic_double(const data_set& d) : f(d.x), l(d.y), e(d.z), out(vector_size) { }
+    void operator()() {
+        for(std::size_t i = 0; i < out.size(); ++i)
+            out[i] = f[i] * l[i] + e[i];
+    }
+    std::size_t items() const { return(out.size()); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<double> f, l, e, out;
+};
+
+struct arithmetic_quantity {
+    explicit arithmetic_quantity(const data_set& d) :
+        f(make_quantities(d.x, si::force())),
+        l(make_quantities(d.y, si::length())),
+        e(make_quantities(d.z, si::energy())),
+        out(vector_size) { }
+    void operator()() {
+        for(std::size_t i = 0; i < out.size(); ++i)
+            out[i] = f[i] * l[i] + e[i];
+    }
+    std::size_t items() const { return(out.size()); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<quantity<si::force> > f;
+    std::vector<quantity<si::length> > l;
+    std::vector<quantity<si::energy> > e;
+    std::vector<quantity<si::energy> > out;
+};
+
+struct conversion_factor_double {
+    explicit conversion_factor_double(const data_set& d) : in(d.x), out(vector_size) { }
+    void operator()() {
+        for(std::size_t i = 0; i < out.size(); ++i)
+            out[i] = in[i] * 0.3048;
+    }
+    std::size_t items() const { return(out.size()); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<double> in, out;
+};
+
+struct conversion_factor_quantity {
+    explicit conversion_factor_quantity(const data_set& d) : in(d.x), out(vector_size) { }
+    void operator()() {
+        for(std::size_t i = 0; i < out.size(); ++i)
+            out[i] = in[i] * conversion_factor(foot_unit(), si::length());
+    }
+    std::size_t items() const { return(out.size()); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<double> in, out;
+};
+
+struct scaled_conversion_double {
+    explicit scaled_conversion_double(const data_set& d) : in(d.x), out(vector_size) { }
+    void operator()() {
+        for(std::size_t i = 0; i < out.size(); ++i)
+            out[i] = in[i] * 1000.0;
+    }
+    std::size_t items() const { return(out.size()); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<double> in, out;
+};
+
+struct scaled_conversion_quantity {
+    explicit scaled_conversion_quantity(const data_set& d) :
+        in(make_quantities(d.x, kilometer_unit())), out(vector_size) { }
+    void operator()() {
+        for(std::size_t i = 0; i < out.size(); ++i)
+            out[i] = quantity<si::length>(in[i]);
+    }
+    std::size_t items() const { return(out.size()); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<quantity<kilometer_unit> > in;
+    std::vector<quantity<si::length> > out;
+};
+
+struct absolute_temperature_double {
+    explicit absolute_temperature_double(const data_set& d) : in(d.x), out(vector_size) { }
+    void operator()() {
+        for(std::size_t i = 0; i < out.size(); ++i)
+            out[i] = (in[i] - 32.0) * (5.0 / 9.0) + 273.15;
+    }
+    std::size_t items() const { return(out.size()); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<double> in, out;
+};
+
+struct absolute_temperature_quantity {
+    explicit absolute_temperature_quantity(const data_set& d) :
+        in(make_quantities(d.x, fahrenheit_absolute())), out(vector_size) { }
+    void operator()() {
+        for(std::size_t i = 0; i < out.size(); ++i)
+            out[i] = quantity<kelvin_absolute>(in[i]);
+    }
+    std::size_t items() const { return(out.size()); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<quantity<fahrenheit_absolute> > in;
+    std::vector<quantity<kelvin_absolute> > out;
+};
+
+struct sqrt_double {
+    explicit sqrt_double(const data_set& d) : x(d.x), y(d.y), out(vector_size) { }
+    void operator()() {
+        using std::sqrt;
+        for(std::size_t i = 0; i < out.size(); ++i)
+            out[i] = sqrt(x[i] * x[i] + y[i] * y[i]);
+    }
+    std::size_t items() const { return(out.size()); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<double> x, y, out;
+};
+
+struct sqrt_quantity {
+    explicit sqrt_quantity(const data_set& d) :
+        x(make_quantities(d.x, si::length())),
+        y(make_quantities(d.y, si::length())),
+        out(vector_size) { }
+    void operator()() {
+        for(std::size_t i = 0; i < out.size(); ++i)
+            out[i] = sqrt(x[i] * x[i] + y[i] * y[i]);
+    }
+    std::size_t items() const { return(out.size()); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<quantity<si::length> > x, y, out;
+};
+
+struct atan2_double {
+    explicit atan2_double(const data_set& d) : x(d.x), y(d.y), out(vector_size) { }
+    void operator()() {
+        using std::atan2;
+        for(std::size_t i = 0; i < out.size(); ++i)
+            out[i] = atan2(y[i], x[i]);
+    }
+    std::size_t items() const { return(out.size()); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<double> x, y, out;
+};
+
+struct atan2_quantity {
+    explicit atan2_quantity(const data_set& d) :
+        x(make_quantities(d.x, si::length())),
+        y(make_quantities(d.y, si::length())),
+        out(vector_size) { }
+    void operator()() {
+        for(std::size_t i = 0; i < out.size(); ++i)
+            out[i] = atan2(y[i], x[i]);
+    }
+    std::size_t items() const { return(out.size()); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<quantity<si::length> > x, y;
+    std::vector<quantity<si::plane_angle> > out;
+};
+
+// two matrix_size x matrix_size matrices of small integers, so that
+// the products are exact and do not depend on the summation order
+void random_matrices(std::vector<double>& m0, std::vector<double>& m1) {
+    m0.resize(matrix_size * matrix_size);
+    m1.resize(matrix_size * matrix_size);
+    std::srand(1492);
+    for(std::size_t i = 0; i < m0.size(); ++i) {
+        m0[i] = std::rand() % 1000;
+        m1[i] = std::rand() % 1000;
+    }
+}
+
+struct tiled_multiply_double {
+    tiled_multiply_double() : out(matrix_size * matrix_size) {
+        random_matrices(m0, m1);
+    }
+    void operator()() {
+        tiled_multiply_carray_outer(&m0[0], &m1[0], &out[0],
+            matrix_size, matrix_size, matrix_size);
+    }
+    std::size_t items() const { return(std::size_t(matrix_size) * matrix_size * matrix_size); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<double> m0, m1, out;
+};
+
+struct tiled_multiply_quantity {
+    tiled_multiply_quantity() : out(matrix_size * matrix_size) {
+        std::vector<double> raw0, raw1;
+        random_matrices(raw0, raw1);
+        m0 = make_quantities(raw0, si::force());
+        m1 = make_quantities(raw1, si::length());
+    }
+    void operator()() {
+        tiled_multiply_carray_outer(&m0[0], &m1[0], &out[0],
+            matrix_size, matrix_size, matrix_size);
+    }
+    std::size_t items() const { return(std::size_t(matrix_size) * matrix_size * matrix_size); }
+    double checksum() const { return(raw_sum(out)); }
+    std::vector<quantity<si::force> > m0;
+    std::vector<quantity<si::length> > m1;
+    std::vector<quantity<si::energy> > out;
+};
+
+// the bounds are members so that the solve cannot be folded at compile time
+struct ode_double {
+    ode_double() : lower(0.0), upper(1.0), start(1.0), result(0) { }
+    void operator()() {
+        result = solve_differential_equation(f(), lower, upper, int(ode_steps), start);
+    }
+    std::size_t items() const { return(ode_steps); }
+    double checksum() const { return(result); }
+    double lower, upper, start, result;
+};
+
+struct ode_quantity {
+    ode_quantity() : lower(0.0 * si::seconds), upper(1.0 * si::seconds), start(1.0 * si::meters) { }
+    void operator()() {
+        result = solve_differential_equation(f(), lower, upper, int(ode_steps), start);
+    }
+    std::size_t items() const { return(ode_steps); }
+    double checksum() const { return(result.value()); }
+    quantity<si::time> lower, upper;
+    quantity<si::length> start, result;
+};
+
+// 32 bit FNV-1a, which is exactly representable as a double
+double string_checksum(const std::string& s) {
+    boost::uint32_t result = 2166136261u;
+    for(std::size_t i = 0; i < s.size(); ++i)
+        result = (result ^ static_cast<unsigned char>(s[i])) * 16777619u;
+    return(result);
+}
+
+struct print_double {
+    explicit print_double(const data_set& d) : in(d.x.begin(), d.x.begin() + print_size) { }
+    void operator()() {
+        std::ostringstream os;
+        for(std::size_t i = 0; i < in.size(); ++i)
+            os << in[i] << " m\n";
+        text = os.str();
+    }
+    std::size_t items() const { return(in.size()); }
+    double checksum() const { return(string_checksum(text)); }
+    std::vector<double> in;
+    std::string text;
+};
+
+struct print_quantity {
+    explicit print_quantity(const data_set& d) :
+        in(make_quantities(std::vector<double>(d.x.begin(), d.x.begin() + print_size), si::length())) { }
+    void operator()() {
+        std::ostringstream os;
+        for(std::size_t i = 0; i < in.size(); ++i)
+            os << in[i] << '\n';
+        text = os.str();
+    }
+    std::size_t items() const { return(in.size()); }
+    double checksum() const { return(string_checksum(text)); }
+    std::vector<quantity<si::length> > in;
+    std::string text;
+};
+
+struct options {
+    options() : max_ratio(1.5), min_time(0.5), csv(0), check(true) { }
+    double max_ratio;
+    double min_time;
+    const char* csv;
+    bool check;
+};
+
+struct case_result {
+    std::string name;
+    std::size_t items;
+    double double_ns;
+    double quantity_ns;
+    double ratio;
+    double limit;
+    bool same_result;
+};
+
+/// Runs a single batch of @c iterations calls and returns its duration.
+template<class Kernel>
+double time_batch(Kernel& kernel, std::size_t iterations) {
+    const double start = now();
+    for(std::size_t i = 0; i < iterations; ++i) {
+        kernel();
+        clobber();
+    }
+    return(now() - start);
+}
+
+/// Returns the number of calls that takes roughly @c target seconds.
+template<class Kernel>
+std::size_t calibrate(Kernel& kernel, double target) {
+    std::size_t iterations = 1;
+    while(time_batch(kernel, iterations) < target)
+        iterations *= 2;
+    return(iterations);
+}
+
+/// Returns the median of @c values, which it reorders.
+double median(std::vector<double>& values) {
+    const std::vector<double>::iterator middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    return(*middle);
+}
+
+/// Times both variants in pairs of batches, alternating which one runs
+/// first so that frequency scaling and other machine noise affect them
+/// alike.  The times and the ratio are the medians over the pairs, so
+/// a few disturbed batches cannot move them, which the best batch of a
+/// sub-nanosecond kernel often did.
+template<class DoubleKernel, class QuantityKernel>
+case_result run_case(const char* name,
+                     DoubleKernel& dk,
+                     QuantityKernel& qk,
+                     double limit,
+                     const options& opt) {
+    enum { repetitions = 21 };
+    const double target = opt.min_time / repetitions;
+    const std::size_t dn = calibrate(dk, target);
+    const std::size_t qn = calibrate(qk, target);
+    std::vector<double> dtimes, qtimes, ratios;
+    for(int r = 0; r < repetitions; ++r) {
+        double dt, qt;
+        if(r % 2 == 0) {
+            dt = time_batch(dk, dn) / dn;
+            qt = time_batch(qk, qn) / qn;
+        } else {
+            qt = time_batch(qk, qn) / qn;
+            dt = time_batch(dk, dn) / dn;
+        }
+        dtimes.push_back(dt);
+        qtimes.push_back(qt);
+        ratios.push_back((qt / qk.items()) / (dt / dk.items()));
+    }
+    case_result result;
+    result.name = name;
+    result.items = dk.items();
+    result.double_ns = median(dtimes) / dk.items() * 1e9;
+    result.quantity_ns = median(qtimes) / qk.items() * 1e9;
+    result.ratio = median(ratios);
+    result.limit = limit;
+    const double dsum = dk.checksum();
+    const double qsum = qk.checksum();
+    using std::abs;
+    result.same_result = abs(dsum - qsum) <= abs(dsum) * 1e-12;
+    return(result);
+}
+
+bool parse_option(const char* arg, const char* name, const char*& value) {
+    const std::size_t len = std::strlen(name);
+    if(std::strncmp(arg, name, len) != 0 || arg[len] != '=')
+        return(false);
+    value = arg + len + 1;
+    return(true);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    options opt;
+    for(int i = 1; i < argc; ++i) {
+        const char* value;
+        if(parse_option(argv[i], "--max-ratio", value)) {
+            opt.max_ratio = std::atof(value);
+        } else if(parse_option(argv[i], "--min-time", value)) {
+            opt.min_time = std::atof(value);
+        } else if(parse_option(argv[i], "--csv", value)) {
+            opt.csv = value;
+        } else if(std::strcmp(argv[i], "--no-check") == 0) {
+            opt.check = false;
+        } else {
+            std::cerr << "usage: " << argv[0]
+                      << " [--max-ratio=R] [--min-time=S] [--csv=FILE] [--no-check]"
+                      << std::endl;
+            return(EXIT_FAILURE);
+        }
+    }
+
+#ifdef BOOST_UNITS_PERF_UNOPTIMIZED
+    std::cout << "built without optimization: ratios are not enforced\n" << std::endl;
+    opt.check = false;
+#endif
+
+    const data_set data;
+    std::vector<case_result> results;
+
+    {
+        arithmetic_double dk(data);
+        arithmetic_quantity qk(data);
+        results.push_back(run_case("arithmetic", dk, qk, opt.max_ratio, opt));
+    }
+    {
+        conversion_factor_double dk(data);
+        conversion_factor_quantity qk(data);
+        results.push_back(run_case("conversion_factor", dk, qk, opt.max_ratio, opt));
+    }
+    {
+        scaled_conversion_double dk(data);
+        scaled_conversion_quantity qk(data);
+        results.push_back(run_case("scaled conversion", dk, qk, opt.max_ratio, opt));
+    }
+    {
+        absolute_temperature_double dk(data);
+        absolute_temperature_quantity qk(data);
+        results.push_back(run_case("absolute temperature", dk, qk, opt.max_ratio, opt));
+    }
+    {
+        sqrt_double dk(data);
+        sqrt_quantity qk(data);
+        results.push_back(run_case("cmath sqrt", dk, qk, opt.max_ratio, opt));
+    }
+    {
+        atan2_double dk(data);
+        atan2_quantity qk(data);
+        results.push_back(run_case("cmath atan2", dk, qk, opt.max_ratio, opt));
+    }
+    {
+        tiled_multiply_double dk;
+        tiled_multiply_quantity qk;
+        results.push_back(run_case("tiled multiply", dk, qk, opt.max_ratio, opt));
+    }
+    {
+        ode_double dk;
+        ode_quantity qk;
+        results.push_back(run_case("ode solve", dk, qk, opt.max_ratio, opt));
+        const double expected = 1.0/4.0 - 3.0/16.0 + 19.0/16.0 * std::exp(4.0);
+        if(std::abs(dk.result - expected) > expected / 1e9) {
+            std::cout << std::setprecision(15) << "ode solve: expected " << expected
+                      << ", got " << dk.result << std::endl;
+            return(EXIT_FAILURE);
+        }
+    }
+    {
+        // Formatting a quantity also writes its unit symbol, so this
+        // case is not expected to be free.
+        print_double dk(data);
+        print_quantity qk(data);
+        results.push_back(run_case("operator<<", dk, qk, 2 * opt.max_ratio, opt));
+    }
+
+    bool ok = true;
+
+    std::cout << std::left << std::setw(20) << "case" << std::right
+              << std::setw(12) << "items"
+              << std::setw(11) << "double ns"
+              << std::setw(13) << "quantity ns"
+              << std::setw(19) << "quantity Mitem/s"
+              << std::setw(7) << "ratio"
+              << std::setw(7) << "limit" << '\n';
+    for(std::size_t i = 0; i < results.size(); ++i) {
+        const case_result& r = results[i];
+        std::cout << std::left << std::setw(20) << r.name << std::right
+                  << std::setw(12) << r.items
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(11) << r.double_ns
+                  << std::setw(13) << r.quantity_ns
+                  << std::setw(19) << 1e3 / r.quantity_ns
+                  << std::setprecision(2)
+                  << std::setw(7) << r.ratio
+                  << std::setw(7) << r.limit;
+        if(!r.same_result) {
+            std::cout << "  results differ";
+            ok = false;
+        } else if(r.ratio > r.limit) {
+            std::cout << "  over limit";
+            if(opt.check)
+                ok = false;
+        }
+        std::cout << '\n';
+    }
+    std::cout.flush();
+
+    if(opt.csv) {
+        std::ofstream out(opt.csv);
+        out << "case,items,double_ns_per_item,quantity_ns_per_item,"
+               "quantity_mitems_per_s,ratio,limit\n";
+        for(std::size_t i = 0; i < results.size(); ++i) {
+            const case_result& r = results[i];
+            out << r.name << ',' << r.items << ','
+                << r.double_ns << ',' << r.quantity_ns << ','
+                << 1e3 / r.quantity_ns << ','
+                << r.ratio << ',' << r.limit << '\n';
+        }
+        if(!out) {
+            std::cerr << "cannot write " << opt.csv << std::endl;
+            return(EXIT_FAILURE);
+        }
+    }
+
+    return(ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,34 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief fail_measurement_array_add.cpp
+
+\details
+Test addition of measurement arrays with different units.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <boost/units/measurement.hpp>
+#include <boost/units/systems/si.hpp>
+
+namespace bu = boost::units;
+
+int main(int,char *[])
+{
+    bu::measurement_array<bu::si::length> a, out;
+    bu::measurement_array<bu::si::time> b;
+
+    bu::add(a, b, out);
+
+    return 0;
+}
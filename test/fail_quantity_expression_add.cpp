@@ -0,0 +1,35 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief fail_quantity_expression_add.cpp
+
+\details
+Test addition of arrays of quantities with different dimensions.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <boost/units/quantity_array.hpp>
+#include <boost/units/quantity_expression.hpp>
+#include <boost/units/systems/si.hpp>
+
+namespace bu = boost::units;
+
+int main(int,char *[])
+{
+    bu::quantity_array<bu::si::time> t(3);
+    bu::quantity_array<bu::si::length> x(3);
+
+    bu::quantity_array<bu::si::length> sum = t + x;
+
+    return 0;
+}
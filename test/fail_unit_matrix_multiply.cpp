@@ -0,0 +1,37 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief fail_unit_matrix_multiply.cpp
+
+\details
+Test multiplication of unit matrices whose inner units do not match.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <boost/mpl/vector.hpp>
+
+#include <boost/units/systems/si.hpp>
+#include <boost/units/unit_matrix.hpp>
+
+namespace bu = boost::units;
+namespace mpl = boost::mpl;
+
+int main(int,char *[])
+{
+    bu::unit_matrix<mpl::vector<bu::si::length>, mpl::vector<bu::si::length, bu::si::time> > a;
+    bu::unit_matrix<mpl::vector<bu::si::length, bu::si::length>, mpl::vector<bu::si::dimensionless> > b;
+
+    a * b;
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_atomic_quantity.cpp
+
+\details
+Test atomic and sharded quantities, alone and updated from several
+threads, with floating point and integral values.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <boost/config.hpp>
+
+#include <boost/units/atomic_quantity.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/systems/information.hpp>
+#include <boost/units/systems/si.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_ATOMIC) && !defined(BOOST_NO_CXX11_HDR_THREAD)
+
+#include <thread>
+#include <vector>
+
+namespace bu = boost::units;
+
+typedef bu::quantity<bu::si::energy> energy;
+typedef bu::quantity<bu::information::info, long long> bytes;
+
+const int threads = 4;
+const int iterations = 10000;
+
+void test_atomic_quantity()
+{
+    bu::atomic_quantity<bu::si::energy> total;
+    BOOST_TEST_EQ(total.load().value(), 0.0);
+    total.store(2.0 * bu::si::joules);
+    BOOST_TEST_EQ(total.fetch_add(0.5 * bu::si::joules).value(), 2.0);
+    BOOST_TEST_EQ(total.fetch_sub(1.0 * bu::si::joules).value(), 2.5);
+    BOOST_TEST_EQ((total += 0.25 * bu::si::joules).value(), 1.75);
+    BOOST_TEST_EQ((total -= 0.75 * bu::si::joules).value(), 1.0);
+    BOOST_TEST_EQ(total.exchange(3.0 * bu::si::joules).value(), 1.0);
+    energy expected = 1.0 * bu::si::joules;
+    BOOST_TEST(!total.compare_exchange_strong(expected, 4.0 * bu::si::joules));
+    BOOST_TEST_EQ(expected.value(), 3.0);
+    BOOST_TEST(total.compare_exchange_strong(expected, 4.0 * bu::si::joules));
+    total = 5.0 * bu::si::joules;
+    energy e = total;
+    BOOST_TEST_EQ(e.value(), 5.0);
+
+    // floating point values from several threads
+    total.store(energy());
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; ++t)
+        workers.push_back(std::thread([&total] {
+            for(int i = 0; i < iterations; ++i)
+                total += 0.5 * bu::si::joules;
+        }));
+    for(std::size_t t = 0; t < workers.size(); ++t)
+        workers[t].join();
+    BOOST_TEST_EQ(total.load().value(), 0.5 * threads * iterations);
+
+    // integral values
+    bu::atomic_quantity<bu::information::info, long long> counter;
+    BOOST_TEST(counter.is_lock_free());
+    workers.clear();
+    for(int t = 0; t < threads; ++t)
+        workers.push_back(std::thread([&counter] {
+            for(int i = 0; i < iterations; ++i)
+            {
+                counter.fetch_add(bytes::from_value(3));
+                counter.fetch_sub(bytes::from_value(1));
+            }
+        }));
+    for(std::size_t t = 0; t < workers.size(); ++t)
+        workers[t].join();
+    BOOST_TEST_EQ(counter.load().value(), 2LL * threads * iterations);
+}
+
+void test_sharded_atomic_quantity()
+{
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+    bu::sharded_atomic_quantity<bu::si::energy> total;
+    BOOST_TEST_EQ(total.load().value(), 0.0);
+    total += 2.0 * bu::si::joules;
+    total -= 0.5 * bu::si::joules;
+    BOOST_TEST_EQ(total.load().value(), 1.5);
+
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; ++t)
+        workers.push_back(std::thread([&total] {
+            for(int i = 0; i < iterations; ++i)
+                total.add(0.25 * bu::si::joules);
+        }));
+    for(std::size_t t = 0; t < workers.size(); ++t)
+        workers[t].join();
+    const energy sum = total;
+    BOOST_TEST_EQ(sum.value(), 1.5 + 0.25 * threads * iterations);
+    BOOST_TEST_EQ(total.reset().value(), sum.value());
+    BOOST_TEST_EQ(total.load().value(), 0.0);
+
+    bu::sharded_atomic_quantity<bu::information::info, long long, 4> counter;
+    counter.add(bytes::from_value(7));
+    counter.subtract(bytes::from_value(2));
+    BOOST_TEST_EQ(counter.load().value(), 5);
+#endif
+}
+
+int main()
+{
+    test_atomic_quantity();
+    test_sharded_atomic_quantity();
+    return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+    return boost::report_errors();
+}
+
+#endif
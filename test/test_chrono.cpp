@@ -0,0 +1,161 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_chrono.cpp
+
+\details
+Test conversions between quantities of time and std::chrono durations.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <boost/config.hpp>
+
+#include <boost/units/chrono.hpp>
+#include <boost/units/make_scaled_unit.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/scale.hpp>
+#include <boost/units/scaled_base_unit.hpp>
+#include <boost/units/systems/si.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include "test_close.hpp"
+
+#if !defined(BOOST_NO_CXX11_HDR_CHRONO) && !defined(BOOST_NO_CXX11_HDR_RATIO)
+
+#include <chrono>
+#include <cmath>
+#include <ratio>
+#include <stdexcept>
+#include <type_traits>
+
+namespace bu = boost::units;
+
+typedef bu::make_scaled_unit<bu::si::time, bu::scale<10, bu::static_rational<-3> > >::type millisecond_unit;
+typedef bu::make_scaled_unit<bu::si::time, bu::scale<10, bu::static_rational<-6> > >::type microsecond_unit;
+typedef bu::scaled_base_unit<bu::si::second_base_unit, bu::scale<10, bu::static_rational<-9> > >::unit_type nanosecond_unit;
+
+void test_periods()
+{
+    BOOST_TEST((std::ratio_equal<bu::chrono_period<bu::si::time>::type, std::ratio<1> >::value));
+    BOOST_TEST((std::ratio_equal<bu::chrono_period<millisecond_unit>::type, std::milli>::value));
+    BOOST_TEST((std::ratio_equal<bu::chrono_period<nanosecond_unit>::type, std::nano>::value));
+
+    // decimal periods map to the prefixed units
+    BOOST_TEST((std::is_same<bu::chrono_unit<std::ratio<1> >::type, bu::si::time>::value));
+    BOOST_TEST((std::is_same<bu::chrono_unit<std::milli>::type, millisecond_unit>::value));
+    BOOST_TEST((std::is_same<bu::chrono_unit<std::ratio<10, 10000> >::type, millisecond_unit>::value));
+
+    // and every period maps back to itself
+    BOOST_TEST((std::ratio_equal<bu::chrono_period<bu::chrono_unit<std::chrono::minutes::period>::type>::type,
+                                 std::ratio<60> >::value));
+    BOOST_TEST((std::ratio_equal<bu::chrono_period<bu::chrono_unit<std::chrono::hours::period>::type>::type,
+                                 std::ratio<3600> >::value));
+    BOOST_TEST((std::ratio_equal<bu::chrono_period<bu::chrono_unit<std::ratio<1, 60> >::type>::type,
+                                 std::ratio<1, 60> >::value));
+    BOOST_TEST((std::ratio_equal<bu::chrono_period<bu::chrono_unit<std::ratio<3, 40> >::type>::type,
+                                 std::ratio<3, 40> >::value));
+}
+
+void test_to_duration()
+{
+    const bu::quantity<millisecond_unit, long long> ms = bu::quantity<millisecond_unit, long long>::from_value(1500);
+
+    // same period: the count is unchanged
+    const std::chrono::milliseconds d = bu::to_duration(ms);
+    BOOST_TEST_EQ(d.count(), 1500);
+    BOOST_TEST_EQ(bu::to_duration<std::chrono::milliseconds>(ms).count(), 1500);
+
+    // to finer and coarser periods
+    BOOST_TEST_EQ(bu::to_duration<std::chrono::microseconds>(ms).count(), 1500000);
+    BOOST_TEST_EQ(bu::to_duration<std::chrono::seconds>(ms).count(), 1);
+    BOOST_TEST_EQ((bu::to_duration<std::chrono::seconds, bu::round_to_nearest>(ms).count()), 2);
+    BOOST_TEST_THROWS((bu::to_duration<std::chrono::seconds, bu::round_exact>(ms)), std::domain_error);
+    BOOST_TEST_EQ(bu::to_duration<std::chrono::seconds>(-ms).count(), -1);
+
+    // to periods that are not powers of ten
+    const bu::quantity<bu::si::time, long long> s = bu::quantity<bu::si::time, long long>::from_value(5400);
+    BOOST_TEST_EQ(bu::to_duration<std::chrono::minutes>(s).count(), 90);
+    BOOST_TEST_EQ(bu::to_duration<std::chrono::hours>(s).count(), 1);
+    BOOST_TEST_EQ((bu::to_duration<std::chrono::hours, bu::round_upward>(s).count()), 2);
+
+    // large counts are exact
+    const bu::quantity<nanosecond_unit, long long> ns =
+        bu::quantity<nanosecond_unit, long long>::from_value(1234567890123456789LL);
+    BOOST_TEST_EQ(bu::to_duration<std::chrono::nanoseconds>(ns).count(), 1234567890123456789LL);
+    BOOST_TEST_EQ(bu::to_duration<std::chrono::microseconds>(ns).count(), 1234567890123456LL);
+
+    // overflow
+    const bu::quantity<bu::si::time, long long> large = bu::quantity<bu::si::time, long long>::from_value(10000000000LL);
+    BOOST_TEST_THROWS((bu::to_duration<std::chrono::nanoseconds, bu::round_toward_zero, bu::checked_overflow>(large)),
+                      std::overflow_error);
+
+    // floating point
+    const bu::quantity<bu::si::time> seconds = 2.5 * bu::si::seconds;
+    BOOST_TEST_EQ((bu::to_duration<std::chrono::duration<double, std::milli> >(seconds).count()), 2500.0);
+    BOOST_TEST_EQ((bu::to_duration<std::chrono::duration<double, std::ratio<60> > >(seconds * 24.0).count()), 1.0);
+    BOOST_TEST_EQ(bu::to_duration(seconds).count(), 2.5);
+
+    // floating point values are scaled before they are truncated
+    BOOST_TEST_EQ(bu::to_duration<std::chrono::milliseconds>(1.5 * bu::si::seconds).count(), 1500);
+    BOOST_TEST_EQ(bu::to_duration<std::chrono::seconds>(bu::quantity<millisecond_unit>::from_value(2999.0)).count(), 2);
+    BOOST_TEST_EQ(bu::to_duration<std::chrono::milliseconds>(-0.0015 * bu::si::seconds).count(), -1);
+}
+
+void test_to_quantity()
+{
+    const std::chrono::milliseconds d(2750);
+
+    // the unit of the period
+    const bu::quantity<millisecond_unit, std::chrono::milliseconds::rep> q = bu::to_quantity(d);
+    BOOST_TEST_EQ(q.value(), 2750);
+
+    // a given unit
+    BOOST_TEST_EQ((bu::to_quantity<microsecond_unit>(d).value()), 2750000);
+    BOOST_TEST_EQ((bu::to_quantity<nanosecond_unit>(d).value()), 2750000000LL);
+    BOOST_TEST_EQ((bu::to_quantity<bu::si::time>(d).value()), 2);
+    BOOST_TEST_EQ((bu::to_quantity<bu::si::time, bu::round_to_nearest>(d).value()), 3);
+    BOOST_TEST_EQ((bu::to_quantity<bu::si::time>(std::chrono::hours(2)).value()), 7200);
+    BOOST_TEST_THROWS((bu::to_quantity<nanosecond_unit, bu::round_toward_zero, bu::checked_overflow>(
+        std::chrono::duration<int>(10))), std::overflow_error);
+
+    // round trips
+    const std::chrono::nanoseconds ns(987654321);
+    BOOST_TEST(bu::to_duration(bu::to_quantity(ns)) == ns);
+    BOOST_TEST(bu::to_duration<std::chrono::nanoseconds>(bu::to_quantity<nanosecond_unit>(ns)) == ns);
+    const std::chrono::minutes minutes(7);
+    BOOST_TEST(bu::to_duration(bu::to_quantity(minutes)) == minutes);
+
+    // floating point, and conversion to the coherent unit
+    const std::chrono::duration<double, std::milli> fd(1250.0);
+    const bu::quantity<bu::si::time> seconds(bu::to_quantity(fd));
+    BOOST_UNITS_TEST_CLOSE(seconds.value(), 1.25, 1e-15);
+    BOOST_TEST_EQ((bu::to_quantity<bu::si::time>(fd).value()), 1.25);
+}
+
+int main()
+{
+    test_periods();
+    test_to_duration();
+    test_to_quantity();
+    return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+    return boost::report_errors();
+}
+
+#endif
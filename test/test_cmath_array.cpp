@@ -0,0 +1,173 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_cmath_array.cpp
+
+\details
+Test the array overloads of cmath functions against the scalar
+overloads, including the special values and array lengths that are not
+a multiple of the SIMD width.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/units/cmath.hpp>
+#include <boost/units/cmath_array.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/quantity_array.hpp>
+#include <boost/units/systems/angle/degrees.hpp>
+#include <boost/units/systems/si.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include "test_close.hpp"
+
+namespace bu = boost::units;
+
+typedef bu::quantity<bu::si::length> length;
+typedef bu::quantity<bu::si::area> area;
+typedef bu::quantity<bu::si::plane_angle> angle;
+
+int main()
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<length> x, y;
+    for(int i = 0; i < 37; ++i)
+    {
+        x.push_back((1.5 * i - 20.0) * bu::si::meters);
+        y.push_back((0.75 * i * i + 1e-3) * bu::si::meters);
+    }
+    x.push_back(1e300 * bu::si::meters);    y.push_back(1e300 * bu::si::meters);
+    x.push_back(1e-300 * bu::si::meters);   y.push_back(3e-300 * bu::si::meters);
+    x.push_back(0.0 * bu::si::meters);      y.push_back(-0.0 * bu::si::meters);
+    x.push_back(-3.0 * bu::si::meters);     y.push_back(4.0 * bu::si::meters);
+    const std::size_t n = x.size();
+
+    // hypot
+    std::vector<length> h(n);
+    BOOST_TEST(bu::hypot(&x[0], &x[0] + n, &y[0], &h[0]) == &h[0] + n);
+    for(std::size_t i = 0; i < n; ++i)
+        BOOST_UNITS_TEST_CLOSE(h[i].value(), bu::hypot(x[i], y[i]).value(), 1e-15);
+    BOOST_TEST_EQ(h[n - 2].value(), 0.0);
+    BOOST_TEST_EQ(h[n - 1].value(), 5.0);
+
+    // infinities are reported as by the scalar function
+    std::vector<length> special(x);
+    special[n - 1] = inf * bu::si::meters;
+    BOOST_TEST_THROWS(bu::hypot(special[n - 1], y[n - 1]), std::overflow_error);
+    BOOST_TEST_THROWS(bu::hypot(&special[0], &special[0] + n, &y[0], &h[0]), std::overflow_error);
+
+    // on spans, using the raw values
+    bu::quantity_array<bu::si::length> xs(x.begin(), x.end()), ys(y.begin(), y.end()), hs(n);
+    bu::hypot(xs.span(), ys.span(), hs.span());
+    for(std::size_t i = 0; i < n; ++i)
+        BOOST_UNITS_TEST_CLOSE(hs[i].value(), h[i].value(), 1e-15);
+    bu::quantity_array<bu::si::length> specials(special.begin(), special.end());
+    BOOST_TEST_THROWS(bu::hypot(specials.span(), ys.span(), hs.span()), std::overflow_error);
+
+    // in place, with a NaN in the first pair of lanes
+    bu::quantity_array<bu::si::length> a(2), b(2);
+    a[0] = length::from_value(nan);     a[1] = 3.0 * bu::si::meters;
+    b[0] = 1.0 * bu::si::meters;        b[1] = 4.0 * bu::si::meters;
+    bu::hypot(a.span(), b.span(), a.span());
+    BOOST_TEST(a[0].value() != a[0].value());
+    BOOST_TEST_EQ(a[1].value(), 5.0);
+    std::vector<length> c(2), d(2);
+    c[0] = length::from_value(nan);     c[1] = 3.0 * bu::si::meters;
+    d[0] = 1.0 * bu::si::meters;        d[1] = 4.0 * bu::si::meters;
+    bu::hypot(&c[0], &c[0] + 2, &d[0], &c[0]);
+    BOOST_TEST(c[0].value() != c[0].value());
+    BOOST_TEST_EQ(c[1].value(), 5.0);
+
+    // sqrt of areas are lengths, for double and float
+    std::vector<area> areas(n);
+    for(std::size_t i = 0; i < n; ++i)
+        areas[i] = y[i] * y[i];
+    std::vector<length> roots(n);
+    BOOST_TEST(bu::sqrt(&areas[0], &areas[0] + n, &roots[0]) == &roots[0] + n);
+    for(std::size_t i = 0; i < n; ++i)
+        BOOST_TEST_EQ(roots[i].value(), bu::sqrt(areas[i]).value());
+    bu::quantity_array<bu::si::area> area_array(areas.begin(), areas.end());
+    bu::quantity_array<bu::si::length> root_array(n);
+    bu::sqrt(bu::make_quantity_span(static_cast<const bu::quantity_array<bu::si::area>&>(area_array)), root_array.span());
+    for(std::size_t i = 0; i < n; ++i)
+        BOOST_TEST_EQ(root_array[i].value(), roots[i].value());
+    areas[0] = area::from_value(-1.0);
+    areas[1] = area::from_value(nan);
+    bu::sqrt(&areas[0], &areas[0] + 2, &roots[0]);
+    BOOST_TEST(roots[0].value() != roots[0].value());
+    BOOST_TEST(roots[1].value() != roots[1].value());
+    std::vector<bu::quantity<bu::si::area, float> > float_areas;
+    for(int i = 0; i < 19; ++i)
+        float_areas.push_back(bu::quantity<bu::si::area, float>::from_value(static_cast<float>(i) * 0.5f));
+    // as for a single quantity, the square root of a float is a double
+    std::vector<bu::quantity<bu::si::length, double> > float_roots(float_areas.size());
+    bu::sqrt(&float_areas[0], &float_areas[0] + float_areas.size(), &float_roots[0]);
+    for(std::size_t i = 0; i < float_areas.size(); ++i)
+        BOOST_TEST_EQ(float_roots[i].value(), bu::sqrt(float_areas[i]).value());
+    bu::quantity_array<bu::si::area, float> float_area_array(float_areas.begin(), float_areas.end());
+    bu::quantity_array<bu::si::length, double> float_root_array(float_areas.size());
+    bu::sqrt(float_area_array.span(), float_root_array.span());
+    for(std::size_t i = 0; i < float_areas.size(); ++i)
+        BOOST_TEST_EQ(float_root_array[i].value(), float_roots[i].value());
+
+    // atan2, in radians and in degrees
+    std::vector<angle> angles(37);
+    bu::atan2(&y[0], &y[0] + 37, &x[0], &angles[0]);
+    for(std::size_t i = 0; i < angles.size(); ++i)
+        BOOST_TEST_EQ(angles[i].value(), std::atan2(y[i].value(), x[i].value()));
+    std::vector<bu::quantity<bu::degree::plane_angle> > dy(3), dx(3);
+    std::vector<bu::quantity<bu::degree::plane_angle> > degrees(3);
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        dy[i] = bu::quantity<bu::degree::plane_angle>::from_value(static_cast<double>(i));
+        dx[i] = bu::quantity<bu::degree::plane_angle>::from_value(1.0);
+    }
+    bu::atan2(&dy[0], &dy[0] + 3, &dx[0], &degrees[0]);
+    BOOST_TEST_EQ(degrees[0].value(), 0.0);
+    BOOST_TEST_EQ(degrees[1].value(), bu::atan2(dy[1], dx[1]).value());
+    BOOST_UNITS_TEST_CLOSE(degrees[2].value(), bu::atan2(dy[2], dx[2]).value(), 1e-15);
+
+    // elementwise functions with the unit of their argument
+    std::vector<length> out(n);
+    bu::abs(&x[0], &x[0] + 37, &out[0]);
+    BOOST_TEST_EQ(out[0].value(), 20.0);
+    bu::fabs(&x[0], &x[0] + 37, &out[0]);
+    BOOST_TEST_EQ(out[1].value(), 18.5);
+    bu::floor(&x[0], &x[0] + 37, &out[0]);
+    BOOST_TEST_EQ(out[1].value(), -19.0);
+    bu::ceil(&x[0], &x[0] + 37, &out[0]);
+    BOOST_TEST_EQ(out[1].value(), -18.0);
+
+    // fma and pow with their result units
+    std::vector<bu::quantity<bu::si::force> > forces(3, 2.0 * bu::si::newtons);
+    std::vector<bu::quantity<bu::si::energy> > offsets(3, 1.0 * bu::si::joules), energies(3);
+    bu::fma(&forces[0], &forces[0] + 3, &x[0], &offsets[0], &energies[0]);
+    BOOST_TEST_EQ(energies[2].value(), 2.0 * x[2].value() + 1.0);
+    std::vector<bu::quantity<bu::si::volume> > volumes(3);
+    bu::pow<bu::static_rational<3> >(&x[0], &x[0] + 3, &volumes[0]);
+    BOOST_TEST_EQ(volumes[2].value(), x[2].value() * x[2].value() * x[2].value());
+
+    // empty ranges
+    BOOST_TEST(bu::sqrt(&areas[0], &areas[0], &roots[0]) == &roots[0]);
+    BOOST_TEST(bu::hypot(&x[0], &x[0], &y[0], &h[0]) == &h[0]);
+    bu::sqrt(bu::quantity_span<bu::si::area, const double>(), bu::quantity_span<bu::si::length, double>());
+
+    return boost::report_errors();
+}
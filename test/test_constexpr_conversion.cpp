@@ -0,0 +1,227 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_constexpr_conversion.cpp
+
+\details
+Test that conversion factors between the built-in imperial, US, metric
+and astronomical base units and SI are constant expressions, in both
+directions and through chains of several converters.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <boost/config.hpp>
+
+#ifndef BOOST_NO_CXX11_CONSTEXPR
+
+#include <boost/static_assert.hpp>
+
+#include <boost/units/conversion.hpp>
+#include <boost/units/make_scaled_unit.hpp>
+#include <boost/units/systems/si.hpp>
+
+#include <boost/units/base_units/astronomical/astronomical_unit.hpp>
+#include <boost/units/base_units/astronomical/light_day.hpp>
+#include <boost/units/base_units/astronomical/light_hour.hpp>
+#include <boost/units/base_units/astronomical/light_minute.hpp>
+#include <boost/units/base_units/astronomical/light_second.hpp>
+#include <boost/units/base_units/astronomical/light_year.hpp>
+#include <boost/units/base_units/astronomical/parsec.hpp>
+
+#include <boost/units/base_units/imperial/drachm.hpp>
+#include <boost/units/base_units/imperial/fluid_ounce.hpp>
+#include <boost/units/base_units/imperial/foot.hpp>
+#include <boost/units/base_units/imperial/furlong.hpp>
+#include <boost/units/base_units/imperial/gallon.hpp>
+#include <boost/units/base_units/imperial/gill.hpp>
+#include <boost/units/base_units/imperial/grain.hpp>
+#include <boost/units/base_units/imperial/hundredweight.hpp>
+#include <boost/units/base_units/imperial/inch.hpp>
+#include <boost/units/base_units/imperial/league.hpp>
+#include <boost/units/base_units/imperial/mile.hpp>
+#include <boost/units/base_units/imperial/ounce.hpp>
+#include <boost/units/base_units/imperial/pint.hpp>
+#include <boost/units/base_units/imperial/pound.hpp>
+#include <boost/units/base_units/imperial/quart.hpp>
+#include <boost/units/base_units/imperial/quarter.hpp>
+#include <boost/units/base_units/imperial/stone.hpp>
+#include <boost/units/base_units/imperial/thou.hpp>
+#include <boost/units/base_units/imperial/ton.hpp>
+#include <boost/units/base_units/imperial/yard.hpp>
+
+#include <boost/units/base_units/metric/angstrom.hpp>
+#include <boost/units/base_units/metric/are.hpp>
+#include <boost/units/base_units/metric/atmosphere.hpp>
+#include <boost/units/base_units/metric/bar.hpp>
+#include <boost/units/base_units/metric/barn.hpp>
+#include <boost/units/base_units/metric/day.hpp>
+#include <boost/units/base_units/metric/fermi.hpp>
+#include <boost/units/base_units/metric/hectare.hpp>
+#include <boost/units/base_units/metric/hour.hpp>
+#include <boost/units/base_units/metric/knot.hpp>
+#include <boost/units/base_units/metric/liter.hpp>
+#include <boost/units/base_units/metric/micron.hpp>
+#include <boost/units/base_units/metric/minute.hpp>
+#include <boost/units/base_units/metric/mmHg.hpp>
+#include <boost/units/base_units/metric/nautical_mile.hpp>
+#include <boost/units/base_units/metric/ton.hpp>
+#include <boost/units/base_units/metric/torr.hpp>
+#include <boost/units/base_units/metric/year.hpp>
+
+#include <boost/units/base_units/us/cup.hpp>
+#include <boost/units/base_units/us/dram.hpp>
+#include <boost/units/base_units/us/fluid_dram.hpp>
+#include <boost/units/base_units/us/fluid_ounce.hpp>
+#include <boost/units/base_units/us/foot.hpp>
+#include <boost/units/base_units/us/gallon.hpp>
+#include <boost/units/base_units/us/gill.hpp>
+#include <boost/units/base_units/us/grain.hpp>
+#include <boost/units/base_units/us/hundredweight.hpp>
+#include <boost/units/base_units/us/inch.hpp>
+#include <boost/units/base_units/us/mil.hpp>
+#include <boost/units/base_units/us/mile.hpp>
+#include <boost/units/base_units/us/minim.hpp>
+#include <boost/units/base_units/us/ounce.hpp>
+#include <boost/units/base_units/us/pint.hpp>
+#include <boost/units/base_units/us/pound.hpp>
+#include <boost/units/base_units/us/pound_force.hpp>
+#include <boost/units/base_units/us/quart.hpp>
+#include <boost/units/base_units/us/tablespoon.hpp>
+#include <boost/units/base_units/us/teaspoon.hpp>
+#include <boost/units/base_units/us/ton.hpp>
+#include <boost/units/base_units/us/yard.hpp>
+
+namespace bu = boost::units;
+
+namespace {
+
+constexpr bool close(double a, double b)
+{
+    return (a - b <= 1e-12 * (a < 0 ? -a : a)) && (b - a <= 1e-12 * (a < 0 ? -a : a));
+}
+
+template<class BaseUnit>
+struct si_unit_of
+{
+    typedef bu::unit<typename BaseUnit::dimension_type, bu::si::system> type;
+};
+
+}
+
+// Both directions must be constant expressions and must be each other's inverse.
+#define BOOST_UNITS_CHECK_CONSTANT_FACTOR(namespace_, name_)                                 \
+constexpr double name_ ## _to_si_ ## namespace_ =                                           \
+    bu::conversion_factor(bu::namespace_::name_ ## _base_unit::unit_type(),                 \
+                          si_unit_of<bu::namespace_::name_ ## _base_unit>::type());         \
+constexpr double si_to_ ## name_ ## _ ## namespace_ =                                       \
+    bu::conversion_factor(si_unit_of<bu::namespace_::name_ ## _base_unit>::type(),          \
+                          bu::namespace_::name_ ## _base_unit::unit_type());                \
+BOOST_STATIC_ASSERT(close(name_ ## _to_si_ ## namespace_ * si_to_ ## name_ ## _ ## namespace_, 1.0))
+
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(astronomical, astronomical_unit);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(astronomical, light_day);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(astronomical, light_hour);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(astronomical, light_minute);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(astronomical, light_second);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(astronomical, light_year);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(astronomical, parsec);
+
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, drachm);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, fluid_ounce);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, foot);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, furlong);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, gallon);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, gill);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, grain);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, hundredweight);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, inch);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, league);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, mile);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, ounce);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, pint);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, pound);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, quart);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, quarter);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, stone);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, thou);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, ton);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(imperial, yard);
+
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, angstrom);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, are);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, atmosphere);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, bar);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, barn);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, day);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, fermi);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, hectare);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, hour);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, knot);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, liter);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, micron);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, minute);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, mmHg);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, nautical_mile);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, ton);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, torr);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(metric, year);
+
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, cup);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, dram);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, fluid_dram);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, fluid_ounce);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, foot);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, gallon);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, gill);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, grain);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, hundredweight);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, inch);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, mil);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, mile);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, minim);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, ounce);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, pint);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, pound);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, pound_force);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, quart);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, tablespoon);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, teaspoon);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, ton);
+BOOST_UNITS_CHECK_CONSTANT_FACTOR(us, yard);
+
+// Chains through several converters: furlong -> yard -> meter,
+// mile -> furlong, and mixed units with a scale.
+typedef bu::imperial::furlong_base_unit::unit_type furlong_unit;
+typedef bu::imperial::mile_base_unit::unit_type mile_unit;
+typedef bu::metric::nautical_mile_base_unit::unit_type nautical_mile_unit;
+typedef bu::metric::hour_base_unit::unit_type hour_unit;
+typedef bu::make_scaled_unit<bu::si::length, bu::scale<10, bu::static_rational<3> > >::type kilometer_unit;
+
+BOOST_STATIC_ASSERT(close(bu::conversion_factor(furlong_unit(), mile_unit()), 0.125));
+BOOST_STATIC_ASSERT(close(bu::conversion_factor(mile_unit(), furlong_unit()), 8.0));
+BOOST_STATIC_ASSERT(close(bu::conversion_factor(furlong_unit(), bu::si::meter), 201.168));
+BOOST_STATIC_ASSERT(close(bu::conversion_factor(kilometer_unit(), mile_unit()), 1.0 / 1.609344));
+BOOST_STATIC_ASSERT(close(bu::conversion_factor(furlong_unit() * furlong_unit(), bu::si::square_meter), 201.168 * 201.168));
+BOOST_STATIC_ASSERT(close(bu::conversion_factor(nautical_mile_unit() / hour_unit(), bu::si::meter_per_second), 1852.0 / 3600.0));
+BOOST_STATIC_ASSERT(close(bu::conversion_factor(mile_unit() / hour_unit(), kilometer_unit() / hour_unit()), 1.609344));
+
+// the factor is folded into a single constant
+BOOST_STATIC_ASSERT((bu::detail::is_constant_conversion_factor<
+    bu::detail::conversion_factor_helper<furlong_unit, bu::si::length> >::value));
+
+#endif
+
+int main()
+{
+    return 0;
+}
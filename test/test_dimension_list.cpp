@@ -0,0 +1,112 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_dimension_list.cpp
+
+\details
+Test sorting and combining of dimension and system lists.  The
+Jamfile also builds this with BOOST_UNITS_HAS_VARIADIC_LIST=0 so that
+the variadic and cons-list algorithms are checked against each other.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <boost/mpl/assert.hpp>
+#include <boost/mpl/list.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/units/base_dimension.hpp>
+#include <boost/units/base_unit.hpp>
+#include <boost/units/dimension.hpp>
+#include <boost/units/make_system.hpp>
+#include <boost/units/static_rational.hpp>
+
+namespace bu = boost::units;
+
+struct d1 : bu::base_dimension<d1, 1> { };
+struct d2 : bu::base_dimension<d2, 2> { };
+struct d3 : bu::base_dimension<d3, 3> { };
+struct d4 : bu::base_dimension<d4, 4> { };
+struct d5 : bu::base_dimension<d5, 5> { };
+struct d6 : bu::base_dimension<d6, 6> { };
+
+struct u1 : bu::base_unit<u1, d1::dimension_type, 1> { };
+struct u2 : bu::base_unit<u2, d2::dimension_type, 2> { };
+struct u3 : bu::base_unit<u3, d3::dimension_type, 3> { };
+struct u4 : bu::base_unit<u4, d4::dimension_type, 4> { };
+struct u5 : bu::base_unit<u5, d5::dimension_type, 5> { };
+struct u6 : bu::base_unit<u6, d6::dimension_type, 6> { };
+
+typedef bu::static_rational<1> one;
+typedef bu::static_rational<2> two;
+typedef bu::static_rational<-1> minus_one;
+
+typedef bu::dimensionless_type nil;
+
+// unordered input is sorted by ordinal
+typedef bu::make_dimension_list<boost::mpl::list<
+    bu::dim<d5, one>, bu::dim<d2, one>, bu::dim<d6, one>,
+    bu::dim<d1, one>, bu::dim<d4, one>, bu::dim<d3, one>
+> >::type sorted;
+
+typedef bu::list<bu::dim<d1, one>, bu::list<bu::dim<d2, one>, bu::list<bu::dim<d3, one>,
+    bu::list<bu::dim<d4, one>, bu::list<bu::dim<d5, one>, bu::list<bu::dim<d6, one>, nil> > > > > > expected;
+
+BOOST_MPL_ASSERT((boost::is_same<sorted, expected>));
+
+// repeated base dimensions are added, and dropped if they cancel
+typedef bu::make_dimension_list<boost::mpl::list<
+    bu::dim<d3, one>, bu::dim<d1, one>, bu::dim<d3, one>, bu::dim<d2, one>, bu::dim<d2, minus_one>
+> >::type combined;
+
+BOOST_MPL_ASSERT((boost::is_same<
+    combined,
+    bu::list<bu::dim<d1, one>, bu::list<bu::dim<d3, two>, nil> >
+>));
+
+typedef bu::make_dimension_list<boost::mpl::list<
+    bu::dim<d4, one>, bu::dim<d4, minus_one>
+> >::type cancelled;
+
+BOOST_MPL_ASSERT((boost::is_same<cancelled, nil>));
+
+// powers and roots apply to every exponent
+BOOST_MPL_ASSERT((boost::is_same<
+    bu::static_power<combined, two>::type,
+    bu::list<bu::dim<d1, two>, bu::list<bu::dim<d3, bu::static_rational<4> >, nil> >
+>));
+
+BOOST_MPL_ASSERT((boost::is_same<
+    bu::static_root<bu::static_power<sorted, two>::type, two>::type,
+    sorted
+>));
+
+BOOST_MPL_ASSERT((boost::is_same<
+    boost::mpl::divides<combined, combined>::type,
+    nil
+>));
+
+// systems are sorted by base unit ordinal
+BOOST_MPL_ASSERT((boost::is_same<
+    bu::make_system<u6, u3, u5, u1, u4, u2>::type,
+    bu::make_system<u1, u2, u3, u4, u5, u6>::type
+>));
+
+BOOST_MPL_ASSERT((boost::is_same<
+    bu::make_system<u2, u1>::type,
+    bu::homogeneous_system<bu::list<u1, bu::list<u2, nil> > >
+>));
+
+int main()
+{
+    return 0;
+}
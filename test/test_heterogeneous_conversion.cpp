@@ -0,0 +1,92 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_heterogeneous_conversion.cpp
+
+\details
+Test that conversions between heterogeneous units go through a
+canonical homogeneous system, independent of the order and
+repetition of the base units involved.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <cmath>
+
+#include <boost/mpl/assert.hpp>
+#include <boost/mpl/comparison.hpp>
+#include <boost/mpl/long.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/units/conversion.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/unit.hpp>
+#include <boost/units/systems/si.hpp>
+#include <boost/units/base_units/metric/hour.hpp>
+#include <boost/units/base_units/us/foot.hpp>
+#include <boost/units/base_units/us/pound.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#define BOOST_UNITS_CHECK_CLOSE(a, b) BOOST_TEST(std::abs((a) - (b)) < .0000001)
+
+namespace bu = boost::units;
+
+typedef bu::si::meter_base_unit meter;
+typedef bu::si::second_base_unit second;
+typedef bu::us::foot_base_unit foot;
+
+typedef bu::dimensionless_type nil;
+
+typedef bu::detail::make_canonical_homogeneous_system<
+    bu::list<second, bu::list<meter, bu::list<second, nil> > >
+>::type canonical1;
+
+typedef bu::detail::make_canonical_homogeneous_system<
+    bu::list<meter, bu::list<second, nil> >
+>::type canonical2;
+
+BOOST_MPL_ASSERT((boost::is_same<canonical1, canonical2>));
+
+// with a redundant base unit, the one that enters the system does not
+// depend on the order in which they appear
+typedef bu::detail::make_canonical_homogeneous_system<
+    bu::list<foot, bu::list<second, bu::list<meter, nil> > >
+>::type canonical3;
+
+typedef bu::detail::make_canonical_homogeneous_system<
+    bu::list<meter, bu::list<second, bu::list<foot, nil> > >
+>::type canonical4;
+
+BOOST_MPL_ASSERT((boost::is_same<canonical3, canonical4>));
+BOOST_MPL_ASSERT((boost::mpl::equal_to<canonical3::type::size, boost::mpl::long_<2> >));
+
+typedef bu::us::foot_base_unit::unit_type       foot_unit;
+typedef bu::us::pound_base_unit::unit_type      pound_unit;
+typedef bu::metric::hour_base_unit::unit_type   hour_unit;
+
+int main()
+{
+    const double f1 = bu::conversion_factor(foot_unit() / hour_unit(), bu::si::meter / bu::si::second);
+    const double f2 = bu::conversion_factor(bu::si::meter / bu::si::second, foot_unit() / hour_unit());
+    BOOST_UNITS_CHECK_CLOSE(f1, 0.3048 / 3600.0);
+    BOOST_UNITS_CHECK_CLOSE(f1 * f2, 1.0);
+
+    // the same base units in a different combination
+    const double f3 = bu::conversion_factor(foot_unit() * hour_unit(), bu::si::meter * bu::si::second);
+    BOOST_UNITS_CHECK_CLOSE(f3, 0.3048 * 3600.0);
+
+    const double f4 = bu::conversion_factor(pound_unit() * foot_unit() / hour_unit() / hour_unit(), bu::si::newton);
+    BOOST_UNITS_CHECK_CLOSE(f4 * 1e8, 0.45359237 * 0.3048 / (3600.0 * 3600.0) * 1e8);
+
+    return boost::report_errors();
+}
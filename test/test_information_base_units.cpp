@@ -0,0 +1,53 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_information_base_units.cpp
+
+\details
+Test that integral amounts of information convert exactly in systems
+made directly from the information base units, without including
+systems/information.hpp.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <stdexcept>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/units/make_system.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/unit.hpp>
+#include <boost/units/base_units/information/byte.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+namespace bu = boost::units;
+
+typedef bu::make_system<bu::information::bit_base_unit>::type bit_system;
+typedef bu::make_system<bu::information::byte_base_unit>::type byte_system;
+
+typedef bu::quantity<bu::unit<bu::information_dimension, bit_system>, boost::uint64_t> bits;
+typedef bu::quantity<bu::unit<bu::information_dimension, byte_system>, boost::uint64_t> bytes;
+
+int main()
+{
+    // too large to survive a round trip through double
+    const boost::uint64_t large = (static_cast<boost::uint64_t>(1) << 60) + 1;
+    BOOST_TEST_EQ(bits(bytes::from_value(large)).value(), large * 8);
+    BOOST_TEST_EQ(bytes(bits::from_value(large * 8 + 7)).value(), large);
+
+    const boost::uint64_t limit = ~static_cast<boost::uint64_t>(0) / 8;
+    BOOST_TEST_THROWS(bits(bytes::from_value(limit + 1)), std::overflow_error);
+
+    return boost::report_errors();
+}
@@ -0,0 +1,142 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_information_rate.cpp
+
+\details
+Test data rate, operation rate and cycle units, their output with
+automatic prefixes, and exact conversion of integral amounts of
+information.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/units/io.hpp>
+#include <boost/units/make_scaled_unit.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/systems/information.hpp>
+#include <boost/units/systems/si/time.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+namespace bu = boost::units;
+namespace info = boost::units::information;
+namespace si = boost::units::si;
+
+template<class Q>
+std::string format_quantity(const Q& q, bu::autoprefix_mode prefix = bu::autoprefix_none, bu::format_mode mode = bu::symbol_fmt)
+{
+    std::ostringstream ss;
+    bu::set_format(ss, mode);
+    bu::set_autoprefix(ss, prefix);
+    ss << q;
+    return ss.str();
+}
+
+void test_units()
+{
+    // rates are amounts divided by time
+    const bu::quantity<info::data_rate> rate = (3.0e9 * info::bytes) / (2.0 * si::seconds);
+    BOOST_TEST_EQ(rate.value(), 1.5e9);
+    const bu::quantity<info::operation_rate> ops = 12000.0 * info::operations / (4.0 * si::seconds);
+    BOOST_TEST_EQ(ops.value(), 3000.0);
+    const bu::quantity<info::operation_rate> iops = 3000.0 * info::iops;
+    BOOST_TEST_EQ((ops - iops).value(), 0.0);
+
+    // bytes per cycle times cycles per second is bytes per second
+    const bu::quantity<info::data_per_cycle> width = 32.0 * info::bytes_per_cycle;
+    const bu::quantity<info::cycle_rate> clock = 3.0e9 * info::cycles_per_second;
+    const bu::quantity<info::data_rate> peak = width * clock;
+    BOOST_TEST_EQ(peak.value(), 96.0e9);
+
+    // bits and bytes per second convert explicitly
+    const bu::quantity<info::hu::bit::data_rate> bits(rate);
+    BOOST_TEST_EQ(bits.value(), 12.0e9);
+    const bu::quantity<info::data_rate> bytes(1000.0 * info::bits_per_second);
+    BOOST_TEST_EQ(bytes.value(), 125.0);
+}
+
+void test_output()
+{
+    const bu::quantity<info::data_rate> rate = 1.5e6 * info::bytes_per_second;
+    BOOST_TEST_EQ(format_quantity(rate), "1.5e+06 B/s");
+    BOOST_TEST_EQ(format_quantity(rate, bu::autoprefix_engineering), "1.5 MB/s");
+    BOOST_TEST_EQ(format_quantity(rate, bu::autoprefix_engineering, bu::name_fmt), "1.5 megabyte per second");
+    BOOST_TEST_EQ(format_quantity(3.0 * 1048576.0 * info::bytes_per_second, bu::autoprefix_binary), "3 MiB/s");
+    BOOST_TEST_EQ(format_quantity(2.5e9 * info::bits_per_second, bu::autoprefix_engineering), "2.5 Gb/s");
+    BOOST_TEST_EQ(format_quantity(250000.0 * info::iops, bu::autoprefix_engineering), "250 kop/s");
+    BOOST_TEST_EQ(format_quantity(32.0 * info::bytes_per_cycle), "32 B/cycle");
+    BOOST_TEST_EQ(format_quantity(3.0e9 * info::cycles_per_second, bu::autoprefix_engineering), "3 Gcycle/s");
+    BOOST_TEST_EQ(format_quantity(7.0 * info::operations), "7 op");
+
+    // amounts in bytes keep their unit under binary prefixes
+    BOOST_TEST_EQ(format_quantity(3.0 * 1048576.0 * info::bytes, bu::autoprefix_binary), "3 MiB");
+    BOOST_TEST_EQ(format_quantity(2048.0 * info::bits, bu::autoprefix_binary), "2 Kib");
+
+    // unsigned integral amounts
+    typedef bu::quantity<info::hu::byte::info, boost::uint64_t> bytes;
+    BOOST_TEST_EQ(format_quantity(bytes::from_value(1536)), "1536 B");
+    BOOST_TEST_EQ(format_quantity(bytes::from_value(1536), bu::autoprefix_binary), "1.5 KiB");
+    BOOST_TEST_EQ(format_quantity(bytes::from_value(1536), bu::autoprefix_engineering), "1.536 kB");
+    BOOST_TEST_EQ(format_quantity(bytes::from_value(0), bu::autoprefix_binary), "0 B");
+    BOOST_TEST_EQ(format_quantity(bu::quantity<info::hu::byte::info, unsigned short>::from_value(200), bu::autoprefix_engineering), "200 B");
+}
+
+void test_integral_conversion()
+{
+    typedef bu::quantity<info::hu::byte::info, boost::uint64_t> bytes;
+    typedef bu::quantity<info::hu::bit::info, boost::uint64_t> bits;
+
+    // beyond the precision of double
+    const boost::uint64_t large = (static_cast<boost::uint64_t>(1) << 60) + 1;
+    const bits b(bytes::from_value(large));
+    BOOST_TEST_EQ(b.value(), large * 8);
+    const bytes back(b);
+    BOOST_TEST_EQ(back.value(), large);
+
+    // to and from binary multiples
+    typedef bu::make_scaled_unit<info::hu::byte::info, bu::scale<2, bu::static_rational<20> > >::type mebibyte_unit;
+    const bu::quantity<mebibyte_unit, boost::uint64_t> mebibytes(bytes::from_value(large));
+    BOOST_TEST_EQ(mebibytes.value(), large >> 20);
+    BOOST_TEST_EQ(bytes(mebibytes).value(), (large >> 20) << 20);
+
+    // rates too
+    typedef bu::quantity<info::hu::byte::data_rate, boost::uint64_t> byte_rate;
+    typedef bu::quantity<info::hu::bit::data_rate, boost::uint64_t> bit_rate;
+    BOOST_TEST_EQ(bit_rate(byte_rate::from_value(large)).value(), large * 8);
+    BOOST_TEST_EQ(byte_rate(bit_rate::from_value(large * 8 + 7)).value(), large);
+
+    // multiplying past the value type throws rather than wrapping
+    const boost::uint64_t limit = ~static_cast<boost::uint64_t>(0) / 8;
+    BOOST_TEST_EQ(bits(bytes::from_value(limit)).value(), limit * 8);
+    BOOST_TEST_THROWS(bits(bytes::from_value(limit + 1)), std::overflow_error);
+    BOOST_TEST_THROWS(bit_rate(byte_rate::from_value(limit + 1)), std::overflow_error);
+    typedef bu::quantity<info::hu::byte::info, boost::int8_t> small_bytes;
+    typedef bu::quantity<info::hu::bit::info, boost::int8_t> small_bits;
+    BOOST_TEST_EQ(small_bits(small_bytes::from_value(-16)).value(), -128);
+    BOOST_TEST_THROWS(small_bits(small_bytes::from_value(16)), std::overflow_error);
+    BOOST_TEST_THROWS(small_bits(small_bytes::from_value(-17)), std::overflow_error);
+}
+
+int main()
+{
+    test_units();
+    test_output();
+    test_integral_conversion();
+    return boost::report_errors();
+}
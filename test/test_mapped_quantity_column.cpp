@@ -0,0 +1,129 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_mapped_quantity_column.cpp
+
+\details
+Test viewing quantity columns in memory and in mapped files, in place
+and with conversion of the unit and the value type.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/units/mapped_quantity_column.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/quantity_column.hpp>
+#include <boost/units/systems/cgs.hpp>
+#include <boost/units/systems/si.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include "test_close.hpp"
+
+namespace bu = boost::units;
+
+typedef bu::quantity<bu::si::length> length;
+typedef bu::quantity<bu::cgs::length> cgs_length;
+
+int main()
+{
+    std::vector<length> lengths;
+    for(int i = 0; i < 1000; ++i)
+        lengths.push_back((0.5 * i - 7.0) * bu::si::meters);
+
+    std::ostringstream os;
+    bu::write_quantity_column(os, lengths);
+    const std::string bytes = os.str();
+    // aligned storage for the column
+    std::vector<double> storage(bytes.size() / sizeof(double));
+    std::memcpy(&storage[0], bytes.data(), bytes.size());
+
+    {
+        // in place
+        bu::mapped_quantity_column<bu::si::length, double> column(&storage[0], bytes.size());
+        BOOST_TEST(column.in_place());
+        BOOST_TEST_EQ(column.size(), lengths.size());
+        BOOST_TEST(column.data() == &storage[bu::quantity_column_header::size / sizeof(double)]);
+        BOOST_TEST(column.span().data() == column.data());
+        BOOST_TEST_EQ(column.span().size(), lengths.size());
+        BOOST_TEST(std::equal(column.span().begin(), column.span().end(), lengths.begin()));
+        BOOST_TEST(std::equal(column.begin(), column.end(), lengths.begin()));
+        BOOST_TEST(column[17] == lengths[17]);
+        BOOST_TEST(column.at(999) == lengths[999]);
+        BOOST_TEST_THROWS(column.at(1000), std::out_of_range);
+        BOOST_TEST_EQ(column.end() - column.begin(), 1000);
+        BOOST_TEST(*(column.begin() + 10) == lengths[10]);
+        BOOST_TEST(*(column.end() - 1) == lengths.back());
+    }
+    {
+        // converting the unit
+        bu::mapped_quantity_column<bu::cgs::length, double> column(&storage[0], bytes.size());
+        BOOST_TEST(!column.in_place());
+        BOOST_TEST_THROWS(column.data(), std::logic_error);
+        BOOST_TEST_THROWS(column.span(), std::logic_error);
+        BOOST_TEST_EQ(column.size(), lengths.size());
+        std::size_t i = 0;
+        for(bu::mapped_quantity_column<bu::cgs::length, double>::const_iterator it = column.begin(); it != column.end(); ++it, ++i)
+            BOOST_UNITS_TEST_CLOSE(it->value(), 100.0 * lengths[i].value(), 1e-12);
+        BOOST_TEST_EQ(i, lengths.size());
+    }
+    {
+        // converting the value type
+        bu::mapped_quantity_column<bu::si::length, float> column(&storage[0], bytes.size());
+        BOOST_TEST(!column.in_place());
+        BOOST_TEST_EQ(column[3].value(), -5.5f);
+    }
+    {
+        // unaligned storage is read with a copy
+        std::vector<char> unaligned(bytes.size() + 1);
+        std::memcpy(&unaligned[1], bytes.data(), bytes.size());
+        bu::mapped_quantity_column<bu::si::length, double> column(&unaligned[1], bytes.size());
+        BOOST_TEST(!column.in_place());
+        BOOST_TEST(std::equal(column.begin(), column.end(), lengths.begin()));
+    }
+
+    // errors
+    BOOST_TEST_THROWS((bu::mapped_quantity_column<bu::si::time, double>(&storage[0], bytes.size())), std::domain_error);
+    BOOST_TEST_THROWS((bu::mapped_quantity_column<bu::si::length, double>(&storage[0], bytes.size() - 1)), std::runtime_error);
+    BOOST_TEST_THROWS((bu::mapped_quantity_column<bu::si::length, double>(&storage[0], 10)), std::runtime_error);
+
+#ifdef BOOST_UNITS_HAS_MAPPED_FILE
+    {
+        const char* path = "test_mapped_quantity_column.col";
+        {
+            std::ofstream file(path, std::ios::binary);
+            bu::write_quantity_column(file, lengths);
+        }
+        {
+            bu::mapped_quantity_column<bu::si::length, double> column(path);
+            BOOST_TEST(column.in_place());
+            BOOST_TEST(std::equal(column.begin(), column.end(), lengths.begin()));
+            // copies share the mapping
+            bu::mapped_quantity_column<bu::si::length, double> copy(column);
+            BOOST_TEST(copy.data() == column.data());
+        }
+        std::remove(path);
+        BOOST_TEST_THROWS((bu::mapped_quantity_column<bu::si::length, double>(std::string(path))), std::runtime_error);
+    }
+#endif
+
+    return boost::report_errors();
+}
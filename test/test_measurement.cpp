@@ -0,0 +1,199 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_measurement.cpp
+
+\details
+Test propagation of uncertainties by measurement, alone, as the value
+type of quantities, and in arrays.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include <boost/units/cmath.hpp>
+#include <boost/units/io.hpp>
+#include <boost/units/measurement.hpp>
+#include <boost/units/pow.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/systems/si.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include "test_close.hpp"
+
+namespace bu = boost::units;
+namespace si = boost::units::si;
+
+typedef bu::measurement<double> measurement;
+
+void test_arithmetic()
+{
+    const measurement x(2.0, -0.3);
+    BOOST_TEST_EQ(x.uncertainty(), 0.3);
+    BOOST_TEST_EQ(x.lower_bound(), 1.7);
+
+    const measurement y(4.0, 0.4);
+    const measurement sum = x + y;
+    BOOST_TEST_EQ(sum.value(), 6.0);
+    BOOST_UNITS_TEST_CLOSE(sum.uncertainty(), 0.5, 1e-15);
+    BOOST_UNITS_TEST_CLOSE((x - y).uncertainty(), 0.5, 1e-15);
+    BOOST_UNITS_TEST_CLOSE((x * y).uncertainty(), std::sqrt(16.0 * 0.09 + 4.0 * 0.16), 1e-15);
+    BOOST_UNITS_TEST_CLOSE((x / y).uncertainty(), std::sqrt(0.09 / 16.0 + 4.0 * 0.16 / 256.0), 1e-15);
+
+    // values of zero and of either sign
+    const measurement zero(0.0, 1.0);
+    BOOST_TEST_EQ((zero * y).uncertainty(), 4.0);
+    BOOST_UNITS_TEST_CLOSE((-x * y).uncertainty(), (x * y).uncertainty(), 1e-15);
+    BOOST_UNITS_TEST_CLOSE((x * -3.0).uncertainty(), 0.9, 1e-15);
+    BOOST_TEST_EQ((1.0 + x).uncertainty(), 0.3);
+    BOOST_TEST_EQ((-x).value(), -2.0);
+
+    BOOST_TEST(x < y);
+    BOOST_TEST(x == measurement(2.0, 0.3));
+    BOOST_TEST(x != measurement(2.0, 0.2));
+}
+
+void test_correlation()
+{
+    const measurement x(2.0, 0.3);
+    const measurement y(4.0, 0.4);
+
+    // a measurement is perfectly correlated with itself
+    BOOST_TEST_EQ(bu::correlated_difference(x, x, 1.0).uncertainty(), 0.0);
+    BOOST_TEST_EQ(bu::correlated_quotient(x, x, 1.0).uncertainty(), 0.0);
+    BOOST_UNITS_TEST_CLOSE(bu::correlated_sum(x, x, 1.0).uncertainty(), 0.6, 1e-15);
+    BOOST_UNITS_TEST_CLOSE(bu::correlated_product(x, x, 1.0).uncertainty(), 1.2, 1e-15);
+
+    // no correlation is the same as the operators
+    BOOST_TEST_EQ(bu::correlated_sum(x, y, 0.0).uncertainty(), (x + y).uncertainty());
+    BOOST_TEST_EQ(bu::correlated_product(x, y, 0.0).uncertainty(), (x * y).uncertainty());
+    BOOST_UNITS_TEST_CLOSE(bu::correlated_sum(x, y, -1.0).uncertainty(), 0.1, 1e-15);
+}
+
+void test_quantities()
+{
+    typedef bu::quantity<si::length, measurement> length;
+    const length a(measurement(3.0, 0.3) * si::meters);
+    const length b(measurement(4.0, 0.4) * si::meters);
+
+    const bu::quantity<si::area, measurement> area = a * b;
+    BOOST_TEST_EQ(area.value().value(), 12.0);
+
+    std::ostringstream ss;
+    ss << a;
+    BOOST_TEST_EQ(ss.str(), "3(+/-0.3) m");
+
+    // cmath.hpp and pow.hpp
+    const length side = sqrt(a * a);
+    BOOST_UNITS_TEST_CLOSE(side.value().value(), 3.0, 1e-15);
+    BOOST_UNITS_TEST_CLOSE(side.value().uncertainty(), 0.3 / std::sqrt(2.0), 1e-15);
+    BOOST_UNITS_TEST_CLOSE(bu::pow<2>(a).value().uncertainty(), 1.8, 1e-15);
+    BOOST_UNITS_TEST_CLOSE(bu::root<2>(area).value().uncertainty(), std::sqrt(12.0) * 0.5 * std::sqrt(0.02), 1e-15);
+    const length h = hypot(a, b);
+    BOOST_UNITS_TEST_CLOSE(h.value().value(), 5.0, 1e-15);
+    BOOST_UNITS_TEST_CLOSE(h.value().uncertainty(), std::sqrt(0.6 * 0.6 * 0.09 + 0.8 * 0.8 * 0.16), 1e-15);
+    const bu::quantity<si::plane_angle, measurement> theta = atan2(b, a);
+    BOOST_UNITS_TEST_CLOSE(theta.value().value(), std::atan2(4.0, 3.0), 1e-15);
+    BOOST_UNITS_TEST_CLOSE(sin(theta).value().value(), 0.8, 1e-15);
+    BOOST_UNITS_TEST_CLOSE(sin(theta).value().uncertainty(), 0.6 * theta.value().uncertainty(), 1e-15);
+
+    const bu::quantity<si::dimensionless, measurement> ratio = b / a;
+    BOOST_UNITS_TEST_CLOSE(exp(ratio).value().uncertainty(), std::exp(4.0 / 3.0) * ratio.value().uncertainty(), 1e-15);
+    BOOST_UNITS_TEST_CLOSE(log(ratio).value().uncertainty(), ratio.value().uncertainty() * 0.75, 1e-15);
+
+    // correlated quantities
+    const length zero = bu::correlated_difference(a, a, 1.0);
+    BOOST_TEST_EQ(zero.value().uncertainty(), 0.0);
+    const bu::quantity<si::area, measurement> square = bu::correlated_product(a, a, 1.0);
+    BOOST_UNITS_TEST_CLOSE(square.value().uncertainty(), 1.8, 1e-15);
+}
+
+void test_array()
+{
+    typedef bu::quantity<si::length, measurement> length;
+
+    // enough for the vector loops and a remainder
+    const std::size_t n = 11;
+    bu::measurement_array<si::length> x, y, sum;
+    bu::measurement_array<si::time> t;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        x.push_back(length::from_value(measurement(1.0 + static_cast<double>(i), 0.1 * static_cast<double>(i))));
+        y.push_back(measurement(2.25 - 0.5 * static_cast<double>(i), 0.2) * si::meters);
+        t.push_back(measurement(0.5 + static_cast<double>(i), 0.05) * si::seconds);
+    }
+    BOOST_TEST_EQ(x.size(), n);
+    BOOST_TEST_EQ(x.values()[3], 4.0);
+    BOOST_TEST_EQ(x.uncertainties()[3], 0.1 * 3.0);
+
+    // sums and differences need the same unit
+    bu::add(x, y, sum);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        BOOST_TEST_EQ(sum[i].value().value(), (x[i] + y[i]).value().value());
+        BOOST_UNITS_TEST_CLOSE(sum[i].value().uncertainty(), (x[i] + y[i]).value().uncertainty(), 1e-15);
+    }
+    bu::subtract(x, y, sum, 0.5);
+    for(std::size_t i = 0; i < n; ++i)
+        BOOST_UNITS_TEST_CLOSE(sum[i].value().uncertainty(), bu::correlated_difference(x[i], y[i], 0.5).value().uncertainty(), 1e-15);
+
+    // products and quotients have the units of the scalar operators
+    bu::measurement_array<si::area> area;
+    bu::multiply(x, y, area);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        const bu::quantity<si::area, measurement> expected = x[i] * y[i];
+        BOOST_TEST_EQ(area[i].value().value(), expected.value().value());
+        BOOST_UNITS_TEST_CLOSE(area[i].value().uncertainty(), expected.value().uncertainty(), 1e-15);
+    }
+    bu::measurement_array<si::velocity> speed;
+    bu::divide(x, t, speed);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        const bu::quantity<si::velocity, measurement> expected = x[i] / t[i];
+        BOOST_TEST_EQ(speed[i].value().value(), expected.value().value());
+        BOOST_UNITS_TEST_CLOSE(speed[i].value().uncertainty(), expected.value().uncertainty(), 1e-15);
+    }
+
+    // into one of the operands
+    const bu::measurement_array<si::length> original(x);
+    bu::measurement_array<si::dimensionless> ratio;
+    bu::divide(x, y, ratio);
+    bu::multiply(ratio, ratio, ratio);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        const bu::quantity<si::dimensionless, measurement> r = original[i] / y[i];
+        BOOST_TEST_EQ(ratio[i].value().value(), (r * r).value().value());
+        BOOST_UNITS_TEST_CLOSE(ratio[i].value().uncertainty(), (r * r).value().uncertainty(), 1e-15);
+    }
+    bu::add(x, y, x);
+    for(std::size_t i = 0; i < n; ++i)
+        BOOST_TEST_EQ(x[i].value().value(), (original[i] + y[i]).value().value());
+
+    // perfectly correlated arrays
+    bu::subtract(original, original, sum, 1.0);
+    for(std::size_t i = 0; i < n; ++i)
+        BOOST_TEST_EQ(sum[i].value().uncertainty(), 0.0);
+}
+
+int main()
+{
+    test_arithmetic();
+    test_correlation();
+    test_quantities();
+    test_array();
+    return boost::report_errors();
+}
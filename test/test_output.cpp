@@ -372,6 +372,12 @@ void test_output_autoprefixed_quantity_symbol()
     BOOST_UNITS_TEST_OUTPUT(1.5e-9*meter_base_unit::unit_type(), "1.5 nm");
     BOOST_UNITS_TEST_OUTPUT(1.5e-8*meter_base_unit::unit_type(), "15 nm");
     BOOST_UNITS_TEST_OUTPUT(1.5e-10*meter_base_unit::unit_type(), "150 pm");
+  // Exactly at and just below a multiple, and negative values.
+    BOOST_UNITS_TEST_OUTPUT(1000.0*meter_base_unit::unit_type(), "1 km");
+    BOOST_UNITS_TEST_OUTPUT(999.0*meter_base_unit::unit_type(), "999 m");
+    BOOST_UNITS_TEST_OUTPUT(1e-24*meter_base_unit::unit_type(), "1 ym");
+    BOOST_UNITS_TEST_OUTPUT(-1500.0*meter_base_unit::unit_type(), "-1.5 km");
+    BOOST_UNITS_TEST_OUTPUT(0.0*meter_base_unit::unit_type(), "0 m");
   // Too small or large for a multiple name.
     BOOST_UNITS_TEST_OUTPUT_REGEX(9.99999e-25 * meter_base_unit::unit_type(), "9\\.99999e-0?25 m"); // Just too small for multiple.
     BOOST_UNITS_TEST_OUTPUT_REGEX(1e+28 * meter_base_unit::unit_type(), "1e\\+0?28 m"); // Just too large for multiple.
@@ -414,6 +420,8 @@ void test_output_auto_binary_prefixed_quantity_symbol()
     BOOST_UNITS_TEST_OUTPUT(std::pow(2., 60) * byte_base_unit::unit_type(), "1 Eib");
     BOOST_UNITS_TEST_OUTPUT(std::pow(2., 70) * byte_base_unit::unit_type(), "1 Zib");
     BOOST_UNITS_TEST_OUTPUT(std::pow(2., 80) * byte_base_unit::unit_type(), "1 Yib");
+    BOOST_UNITS_TEST_OUTPUT(1023 * byte_base_unit::unit_type(), "1023 b"); // Too small for a multiple.
+    BOOST_UNITS_TEST_OUTPUT(-1536 * byte_base_unit::unit_type(), "-1.5 Kib");
     BOOST_UNITS_TEST_OUTPUT(42, "42"); // integer scalar.
     BOOST_UNITS_TEST_OUTPUT(-42, "-42"); // integer scalar.
     BOOST_UNITS_TEST_OUTPUT(1567, "1567"); // scalars are *not* autoprefixed.
@@ -0,0 +1,160 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_parse_quantity.cpp
+
+\details
+Test parsing quantities with prefixed and compound units, conversion
+to the unit of the target, and the errors reported.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <cmath>
+#include <cstring>
+#include <string>
+
+#include <boost/units/parse_quantity.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/systems/cgs.hpp>
+#include <boost/units/systems/information.hpp>
+#include <boost/units/systems/si.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include "test_close.hpp"
+
+namespace bu = boost::units;
+
+namespace {
+
+template<class Quantity>
+bu::parse_quantity_result parse(const char* str, Quantity& q)
+{
+    return bu::parse_quantity(str, str + std::strlen(str), q);
+}
+
+template<class Quantity>
+double parse_value(const char* str)
+{
+    Quantity q;
+    const bu::parse_quantity_result r = parse(str, q);
+    BOOST_TEST_EQ(r.error, bu::parse_ok);
+    BOOST_TEST(r.ptr == str + std::strlen(str));
+    return q.value();
+}
+
+}
+
+int main()
+{
+    typedef bu::quantity<bu::si::velocity> velocity;
+    typedef bu::quantity<bu::si::acceleration> acceleration;
+    typedef bu::quantity<bu::si::length> length;
+    typedef bu::quantity<bu::si::time> time;
+    typedef bu::quantity<BOOST_TYPEOF(bu::si::joules / bu::si::moles)> molar_energy;
+
+    BOOST_UNITS_TEST_CLOSE(parse_value<velocity>("12.5 km/h"), 12.5 / 3.6, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<molar_energy>("3 kJ mol^-1"), 3000.0, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<molar_energy>("3 kJ/mol"), 3000.0, 1e-12);
+
+    // the same unit written in different ways
+    BOOST_UNITS_TEST_CLOSE(parse_value<acceleration>("9.81 m s^-2"), 9.81, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<acceleration>("9.81 m*s^-2"), 9.81, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<acceleration>("9.81 m/s^2"), 9.81, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<acceleration>("9.81m / s / s"), 9.81, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<acceleration>("9.81 s^-2 m^+1"), 9.81, 1e-12);
+
+    // prefixes, by symbol and by name, and prefixed powers
+    BOOST_UNITS_TEST_CLOSE(parse_value<time>("5 us"), 5e-6, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<time>("5 \xC2\xB5s"), 5e-6, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<time>("2 ms"), 2e-3, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<time>("2 min"), 120.0, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<length>("3 dam"), 30.0, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<length>("2 kilometer"), 2000.0, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<bu::quantity<bu::si::area> >("1.5 km^2"), 1.5e6, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<bu::quantity<bu::si::pressure> >("1013.25 hPa"), 101325.0, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<bu::quantity<bu::information::info> >("2 KiB"), 2048.0, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<bu::quantity<bu::si::mass> >("250 mg"), 2.5e-4, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<length>("1 yottameter"), 1e24, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<bu::quantity<bu::information::info> >("1 EiB"), 1152921504606846976.0, 1e-12);
+
+    // numbers too long for a small buffer
+    BOOST_UNITS_TEST_CLOSE(parse_value<length>("0.00000000000000000000000000000000000000000000000000000000000000000125 km"), 1.25e-63, 1e-12);
+
+    // converted to the unit of the target
+    BOOST_UNITS_TEST_CLOSE(parse_value<bu::quantity<bu::cgs::velocity> >("36 km/h"), 1000.0, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<length>("10 ft"), 3.048, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<bu::quantity<bu::si::dimensionless> >("-0.5"), -0.5, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(parse_value<bu::quantity<bu::si::frequency> >("50 /s"), 50.0, 1e-12);
+
+    bu::quantity<bu::si::length, int> meters;
+    BOOST_TEST_EQ(bu::parse_quantity(std::string("3 km"), meters), bu::parse_ok);
+    BOOST_TEST_EQ(meters.value(), 3000);
+
+    // parsing stops after the quantity
+    const char* field = "12.5 km/h, 3 m";
+    velocity v;
+    bu::parse_quantity_result r = parse(field, v);
+    BOOST_TEST_EQ(r.error, bu::parse_ok);
+    BOOST_TEST(r.ptr == field + 9);
+    const char* json = "\"4 m/s\"";
+    r = bu::parse_quantity(json + 1, json + std::strlen(json), v);
+    BOOST_TEST_EQ(r.error, bu::parse_ok);
+    BOOST_TEST(*r.ptr == '"');
+    BOOST_UNITS_TEST_CLOSE(v.value(), 4.0, 1e-12);
+    r = parse("7 m 8", meters);
+    BOOST_TEST_EQ(r.error, bu::parse_ok);
+    BOOST_TEST_EQ(meters.value(), 7);
+
+    // errors leave the quantity unchanged
+    length l = 1.0 * bu::si::meters;
+    const char* str = "3 kg";
+    r = parse(str, l);
+    BOOST_TEST_EQ(r.error, bu::parse_dimension_mismatch);
+    BOOST_TEST(r.ptr == str + 4);
+    str = "3 furlongs";
+    r = parse(str, l);
+    BOOST_TEST_EQ(r.error, bu::parse_unknown_unit);
+    BOOST_TEST(r.ptr == str + 2);
+    str = "m 3";
+    r = parse(str, l);
+    BOOST_TEST_EQ(r.error, bu::parse_invalid_number);
+    BOOST_TEST(r.ptr == str);
+    BOOST_TEST_EQ(parse("+3 m", l).error, bu::parse_invalid_number);
+    BOOST_TEST_EQ(parse("inf m", l).error, bu::parse_invalid_number);
+    BOOST_TEST_EQ(parse("3 m^", l).error, bu::parse_invalid_unit);
+    BOOST_TEST_EQ(parse("3 m^123", l).error, bu::parse_invalid_unit);
+    BOOST_TEST_EQ(parse("3 m/", l).error, bu::parse_invalid_unit);
+    BOOST_TEST_EQ(parse("1e999 m", l).error, bu::parse_out_of_range);
+    BOOST_TEST_EQ(bu::parse_quantity(std::string("3 m m"), l), bu::parse_dimension_mismatch);
+    BOOST_TEST_EQ(bu::parse_quantity(std::string("3 m 4"), l), bu::parse_invalid_unit);
+    BOOST_TEST_EQ(l.value(), 1.0);
+
+#ifndef BOOST_NO_CXX11_HDR_SYSTEM_ERROR
+    str = "2.5 km";
+    bu::from_chars_result fc = bu::from_chars(str, str + 6, l);
+    BOOST_TEST(fc.ec == std::errc());
+    BOOST_TEST(fc.ptr == str + 6);
+    BOOST_UNITS_TEST_CLOSE(l.value(), 2500.0, 1e-12);
+    str = "2.5 s";
+    fc = bu::from_chars(str, str + 5, l);
+    BOOST_TEST(fc.ec == std::errc::invalid_argument);
+    BOOST_TEST(fc.ptr == str);
+    str = "1e999 m";
+    fc = bu::from_chars(str, str + 7, l);
+    BOOST_TEST(fc.ec == std::errc::result_out_of_range);
+    BOOST_UNITS_TEST_CLOSE(l.value(), 2500.0, 1e-12);
+#endif
+
+    return boost::report_errors();
+}
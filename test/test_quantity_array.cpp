@@ -0,0 +1,107 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_quantity_array.cpp
+
+\details
+Test quantity_array and quantity_span.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include "test_header.hpp"
+
+#include <numeric>
+
+#include <boost/units/quantity_array.hpp>
+
+namespace bu = boost::units;
+
+// stands in for a numeric kernel that only knows about raw values
+double raw_sum(const double* data, std::size_t n)
+{
+    return std::accumulate(data, data + n, 0.0);
+}
+
+int main()
+{
+    bu::quantity_array<bu::length> a;
+    BOOST_TEST(a.empty());
+    BOOST_TEST(a.data() == 0);
+
+    a.push_back(1.0 * bu::meters);
+    a.push_back(2.0 * bu::meters);
+    a.push_back(3.0 * bu::meters);
+    BOOST_TEST(a.size() == 3u);
+
+    // unit-typed element access
+    bu::quantity<bu::length> q = a[1];
+    BOOST_TEST(q.value() == 2.0);
+    BOOST_TEST(a.front().get().value() == 1.0);
+    BOOST_TEST(a.back().get().value() == 3.0);
+
+    // element mutation writes through to the raw storage
+    a[0] = 4.0 * bu::meters;
+    a[1] += 1.0 * bu::meters;
+    a[2] *= 2.0;
+    BOOST_TEST(a.data()[0] == 4.0);
+    BOOST_TEST(a.data()[1] == 3.0);
+    BOOST_TEST(a.data()[2] == 6.0);
+
+    // zero-copy hand-off of the raw values
+    BOOST_TEST(raw_sum(a.data(), a.size()) == 13.0);
+
+    const bu::quantity_array<bu::length>& ca = a;
+    BOOST_TEST(ca[2] == 6.0 * bu::meters);
+
+    bool threw = false;
+    try { a.at(3); } catch(std::out_of_range&) { threw = true; }
+    BOOST_TEST(threw);
+
+    // iteration
+    bu::quantity<bu::length> total;
+    for(bu::quantity_array<bu::length>::const_iterator it = ca.begin(); it != ca.end(); ++it)
+        total += *it;
+    BOOST_TEST(total == 13.0 * bu::meters);
+    BOOST_TEST(ca.end() - ca.begin() == 3);
+
+    // sized construction and resize
+    bu::quantity_array<bu::energy> e(4, 2.0 * bu::joules);
+    BOOST_TEST(e.size() == 4u);
+    BOOST_TEST(e[3] == 2.0 * bu::joules);
+    e.resize(6);
+    BOOST_TEST(e[5] == 0.0 * bu::joules);
+
+    // construction from a range of quantities
+    bu::quantity<bu::time> times[] = { 1.0 * bu::seconds, 2.0 * bu::seconds };
+    bu::quantity_array<bu::time> t(times, times + 2);
+    BOOST_TEST(t[1] == 2.0 * bu::seconds);
+
+    // non-owning views over existing buffers
+    double raw[] = { 1.0, 2.0, 3.0, 4.0 };
+    bu::quantity_span<bu::length, double> s = bu::make_quantity_span(bu::meters, raw, 4);
+    BOOST_TEST(s.size() == 4u);
+    BOOST_TEST(s.data() == raw);
+    s[3] = 5.0 * bu::meters;
+    BOOST_TEST(raw[3] == 5.0);
+
+    bu::quantity_span<bu::length, const double> cs = s;
+    BOOST_TEST(cs[3] == 5.0 * bu::meters);
+    BOOST_TEST(cs.subspan(1, 2).size() == 2u);
+    BOOST_TEST(cs.subspan(1, 2).front() == 2.0 * bu::meters);
+
+    bu::quantity_span<bu::length, const double> as = ca;
+    BOOST_TEST(as.data() == ca.data());
+    BOOST_TEST(as.size() == ca.size());
+
+    return boost::report_errors();
+}
@@ -0,0 +1,131 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_quantity_column.cpp
+
+\details
+Test writing quantity columns, their header layout, and reading them
+back with and without conversion of the unit and the value type.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/units/quantity.hpp>
+#include <boost/units/quantity_column.hpp>
+#include <boost/units/systems/cgs.hpp>
+#include <boost/units/systems/si.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include "test_close.hpp"
+
+namespace bu = boost::units;
+
+typedef bu::quantity<bu::si::length> length;
+typedef bu::quantity<bu::cgs::length> cgs_length;
+
+int main()
+{
+    std::vector<length> lengths;
+    for(int i = 0; i < 1500; ++i)
+        lengths.push_back((0.25 * i - 3.0) * bu::si::meters);
+
+    std::stringstream column;
+    bu::write_quantity_column(column, lengths);
+    const std::string bytes = column.str();
+    BOOST_TEST_EQ(bytes.size(), bu::quantity_column_header::size + lengths.size() * sizeof(double));
+
+    // the header, little-endian at fixed offsets
+    BOOST_TEST_EQ(bytes.substr(0, 6), "BUQCOL");
+    BOOST_TEST_EQ(bytes[6], 1);
+    BOOST_TEST_EQ(bytes[7], 0);
+    BOOST_TEST_EQ(bytes[8], 1);     // length^1
+    BOOST_TEST_EQ(bytes[24], bu::column_float);
+    BOOST_TEST_EQ(bytes[25], 8);
+    BOOST_TEST_EQ(static_cast<unsigned char>(bytes[32]), 1500 % 256);
+    BOOST_TEST_EQ(bytes[33], 1500 / 256);
+
+    const bu::quantity_column_header header = bu::quantity_column_header::decode(bytes.data());
+    BOOST_TEST(header.dimension() == bu::make_runtime_dimension<bu::length_dimension>());
+    BOOST_TEST_EQ(header.scale(), 1.0);
+    BOOST_TEST_EQ(header.value_kind(), bu::column_float);
+    BOOST_TEST_EQ(header.value_size(), sizeof(double));
+    BOOST_TEST_EQ(header.count(), 1500u);
+
+    // the same type
+    std::vector<length> same;
+    bu::read_quantity_column(column, same);
+    BOOST_TEST_EQ(same.size(), lengths.size());
+    for(std::size_t i = 0; i < same.size(); ++i)
+        BOOST_TEST_EQ(same[i].value(), lengths[i].value());
+
+    // another unit of the same dimension
+    column.clear();
+    column.seekg(0);
+    std::vector<cgs_length> centimeters;
+    bu::read_quantity_column(column, centimeters);
+    BOOST_TEST_EQ(centimeters.size(), lengths.size());
+    for(std::size_t i = 0; i < centimeters.size(); ++i)
+        BOOST_UNITS_TEST_CLOSE(centimeters[i].value(), 100.0 * lengths[i].value(), 1e-12);
+
+    // other value types
+    std::vector<bu::quantity<bu::cgs::length, boost::int32_t> > integers;
+    for(int i = 0; i < 10; ++i)
+        integers.push_back(bu::quantity<bu::cgs::length, boost::int32_t>::from_value(-100 * i));
+    std::stringstream integer_column;
+    bu::write_quantity_column(integer_column, integers);
+    BOOST_TEST_EQ(integer_column.str()[24], bu::column_signed);
+    BOOST_TEST_EQ(integer_column.str()[25], 4);
+    std::vector<bu::quantity<bu::si::length, float> > floats;
+    bu::read_quantity_column(integer_column, floats);
+    BOOST_TEST_EQ(floats.size(), 10u);
+    for(std::size_t i = 0; i < floats.size(); ++i)
+        BOOST_UNITS_TEST_CLOSE(floats[i].value(), -1.0f * static_cast<float>(i), 1e-12);
+
+    // an empty column
+    std::stringstream empty_column;
+    bu::write_quantity_column(empty_column, std::vector<length>());
+    same.push_back(length());
+    bu::read_quantity_column(empty_column, same);
+    BOOST_TEST(same.empty());
+
+    // errors
+    std::vector<bu::quantity<bu::si::time> > times;
+    column.clear();
+    column.seekg(0);
+    BOOST_TEST_THROWS(bu::read_quantity_column(column, times), std::domain_error);
+
+    std::istringstream truncated(bytes.substr(0, bytes.size() - 1));
+    BOOST_TEST_THROWS(bu::read_quantity_column(truncated, same), std::runtime_error);
+    std::istringstream short_header(bytes.substr(0, 10));
+    BOOST_TEST_THROWS(bu::read_quantity_column(short_header, same), std::runtime_error);
+
+    std::string corrupt = bytes;
+    corrupt[0] = 'X';
+    BOOST_TEST_THROWS(bu::quantity_column_header::decode(corrupt.data()), std::runtime_error);
+    corrupt = bytes;
+    corrupt[25] = 3;
+    BOOST_TEST_THROWS(bu::quantity_column_header::decode(corrupt.data()), std::runtime_error);
+    corrupt = bytes;
+    corrupt[15] = 0x40;
+    BOOST_TEST_THROWS(bu::quantity_column_header::decode(corrupt.data()), std::runtime_error);
+
+    return boost::report_errors();
+}
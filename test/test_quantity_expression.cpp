@@ -0,0 +1,126 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_quantity_expression.cpp
+
+\details
+Test lazy elementwise expressions over quantity_array and quantity_span.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/units/quantity.hpp>
+#include <boost/units/quantity_array.hpp>
+#include <boost/units/quantity_expression.hpp>
+#include <boost/units/systems/si.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+namespace bu = boost::units;
+namespace si = boost::units::si;
+
+typedef bu::quantity_array<si::length>          length_array;
+typedef bu::quantity_array<si::time>            time_array;
+typedef bu::quantity_array<si::velocity>        velocity_array;
+
+template<class Unit, class Expr>
+bool has_unit(const bu::quantity_expression<Expr>&)
+{
+    return boost::is_same<typename bu::quantity_expression<Expr>::unit_type, Unit>::value;
+}
+
+void test_units()
+{
+    time_array t(3);
+    velocity_array v(3);
+    const bu::quantity<si::acceleration> a = 2.0 * si::meters_per_second_squared;
+
+    // the unit of each node is deduced from the operators on quantities
+    BOOST_TEST(has_unit<si::velocity>(a * t));
+    BOOST_TEST(has_unit<si::length>(v * t));
+    BOOST_TEST(has_unit<si::velocity>(v + a * t));
+    BOOST_TEST(has_unit<si::frequency>(2.0 / t));
+    BOOST_TEST(has_unit<si::time>(-t));
+}
+
+void test_kinematics()
+{
+    const double times[] = { 0.0, 0.5, 1.0, 2.0, 4.0 };
+    time_array t;
+    velocity_array v0;
+    for(std::size_t i = 0; i < 5; ++i)
+    {
+        t.push_back(times[i] * si::seconds);
+        v0.push_back(static_cast<double>(i) * si::meters_per_second);
+    }
+    const bu::quantity<si::acceleration> a = 2.0 * si::meters_per_second_squared;
+    const bu::quantity<si::length> x0 = 1.0 * si::meters;
+
+    // evaluated into a new array
+    velocity_array v = v0 + a * t;
+    BOOST_TEST_EQ(v.size(), 5u);
+    for(std::size_t i = 0; i < 5; ++i)
+        BOOST_TEST_EQ(v.data()[i], static_cast<double>(i) + 2.0 * times[i]);
+
+    const length_array x = x0 + v0 * t + 0.5 * a * t * t;
+    for(std::size_t i = 0; i < 5; ++i)
+        BOOST_TEST_EQ(x.data()[i], 1.0 + static_cast<double>(i) * times[i] + times[i] * times[i]);
+
+    // into an array that is also an operand
+    v = v - a * t;
+    for(std::size_t i = 0; i < 5; ++i)
+        BOOST_TEST_EQ(v.data()[i], static_cast<double>(i));
+
+    // into an array of another size
+    velocity_array empty;
+    empty = x / t * 2.0;
+    BOOST_TEST_EQ(empty.size(), 5u);
+    BOOST_TEST_EQ(empty.data()[4], (1.0 + 16.0 + 16.0) / 4.0 * 2.0);
+
+    // elements are computed on access without evaluating the rest
+    BOOST_TEST((-(v0 * 3.0))[2] == -6.0 * si::meters_per_second);
+    BOOST_TEST_EQ((v0 + a * t).size(), 5u);
+}
+
+void test_spans()
+{
+    double out[3] = { 0.0, 0.0, 0.0 };
+    const double lengths[3] = { 3.0, 6.0, 9.0 };
+    const float durations[3] = { 1.0f, 2.0f, 3.0f };
+
+    bu::quantity_span<si::velocity, double> v = bu::make_quantity_span(si::meters_per_second, out, 3);
+    const bu::quantity_span<si::length, const double> x = bu::make_quantity_span(si::meters, lengths, 3);
+    const bu::quantity_span<si::time, const float> t = bu::make_quantity_span(si::seconds, durations, 3);
+
+    // value types combine as for single quantities
+    v = x / t;
+    BOOST_TEST_EQ(out[0], 3.0);
+    BOOST_TEST_EQ(out[1], 3.0);
+    BOOST_TEST_EQ(out[2], 3.0);
+
+    // spans and arrays mix
+    time_array offsets(3, 1.0 * si::seconds);
+    v = x / (t + offsets) - 1.0 * si::meters_per_second;
+    BOOST_TEST_EQ(out[0], 0.5);
+    BOOST_TEST_EQ(out[1], 1.0);
+    BOOST_TEST_EQ(out[2], 1.25);
+}
+
+int main()
+{
+    test_units();
+    test_kinematics();
+    test_spans();
+    return boost::report_errors();
+}
@@ -0,0 +1,132 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_reduce.cpp
+
+\details
+Test the sums and statistics of ranges of quantities, their units, their
+accuracy and their independence of the number of threads.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/units/quantity.hpp>
+#include <boost/units/reduce.hpp>
+#include <boost/units/systems/si.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include "test_close.hpp"
+
+namespace bu = boost::units;
+
+typedef bu::quantity<bu::si::energy> energy;
+typedef bu::quantity<bu::si::length> length;
+typedef bu::quantity<bu::si::force> force;
+
+namespace {
+
+// throws from the chunk holding *bad
+struct throwing_reducer
+{
+    typedef bu::detail::compensated_sum<double> result_type;
+
+    template<class Iterator>
+    result_type operator()(Iterator first, Iterator last) const
+    {
+        for(; first != last; ++first)
+            if(&*first == bad)
+                throw std::runtime_error("throwing_reducer");
+        return result_type();
+    }
+
+    const energy* bad;
+};
+
+}
+
+int main()
+{
+    // values whose naive sum loses the small terms
+    std::vector<energy> energies;
+    for(int i = 0; i < 200000; ++i)
+    {
+        energies.push_back(1e16 * bu::si::joules);
+        energies.push_back(1.0 * bu::si::joules);
+        energies.push_back(-1e16 * bu::si::joules);
+    }
+    for(unsigned threads = 1; threads <= 4; ++threads)
+    {
+        const energy sum = bu::reduce_sum(energies.begin(), energies.end(), threads);
+        BOOST_TEST_EQ(sum.value(), 200000.0);
+    }
+    BOOST_TEST_EQ(bu::reduce_sum(energies.begin(), energies.end()).value(), 200000.0);
+    BOOST_TEST_EQ(bu::reduce_sum(energies.begin(), energies.begin()).value(), 0.0);
+
+    // statistics of 1e9 + 0, 1, ..., n - 1
+    std::vector<length> lengths;
+    const std::size_t n = 100001;
+    for(std::size_t i = 0; i < n; ++i)
+        lengths.push_back((1e9 + static_cast<double>(i)) * bu::si::meters);
+    const double expected_variance = (static_cast<double>(n) * n - 1) / 12;
+    for(unsigned threads = 1; threads <= 4; ++threads)
+    {
+        const length m = bu::mean(lengths.begin(), lengths.end(), threads);
+        BOOST_UNITS_TEST_CLOSE(m.value(), 1e9 + (n - 1) / 2.0, 1e-12);
+        const bu::quantity<bu::si::area> v = bu::variance(lengths.begin(), lengths.end(), threads);
+        BOOST_UNITS_TEST_CLOSE(v.value(), expected_variance, 1e-12);
+        const std::pair<length, length> extrema = bu::min_max(lengths.begin(), lengths.end(), threads);
+        BOOST_TEST_EQ(extrema.first.value(), 1e9);
+        BOOST_TEST_EQ(extrema.second.value(), 1e9 + static_cast<double>(n - 1));
+    }
+
+    // min_max of a single element and in a reversed range
+    BOOST_TEST(bu::min_max(lengths.begin(), lengths.begin() + 1).second == lengths[0]);
+    std::vector<length> reversed(lengths.rbegin(), lengths.rend());
+    BOOST_TEST(bu::min_max(reversed.begin(), reversed.end(), 3).first == lengths.front());
+    BOOST_TEST_EQ(bu::variance(lengths.begin(), lengths.begin() + 1).value(), 0.0);
+
+    // dot product of forces and displacements is work
+    std::vector<force> forces;
+    std::vector<length> displacements;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        forces.push_back(2.0 * bu::si::newtons);
+        displacements.push_back(static_cast<double>(i % 10) * bu::si::meters);
+    }
+    for(unsigned threads = 1; threads <= 4; ++threads)
+    {
+        const energy work = bu::dot(forces.begin(), forces.end(), displacements.begin(), threads);
+        BOOST_TEST_EQ(work.value(), 2.0 * 4.5 * 100000);
+    }
+
+    // errors
+    BOOST_TEST_THROWS(bu::mean(lengths.begin(), lengths.begin()), std::invalid_argument);
+    BOOST_TEST_THROWS(bu::variance(lengths.begin(), lengths.begin()), std::invalid_argument);
+    BOOST_TEST_THROWS(bu::min_max(lengths.begin(), lengths.begin()), std::invalid_argument);
+
+    // an exception from any chunk reaches the caller once the threads are joined
+    throwing_reducer on_caller = { &energies.front() };
+    throwing_reducer on_worker = { &energies.back() };
+    for(unsigned threads = 1; threads <= 4; ++threads)
+    {
+        BOOST_TEST_THROWS(bu::detail::reduce_range(energies.begin(), energies.end(), threads, on_caller), std::runtime_error);
+        BOOST_TEST_THROWS(bu::detail::reduce_range(energies.begin(), energies.end(), threads, on_worker), std::runtime_error);
+    }
+
+    return boost::report_errors();
+}
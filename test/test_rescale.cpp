@@ -0,0 +1,120 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_rescale.cpp
+
+\details
+Test exact conversion of integral quantities between units that differ
+by powers of ten and two, with each rounding and overflow policy.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <stdexcept>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/units/make_scaled_unit.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/rescale.hpp>
+#include <boost/units/scale.hpp>
+#include <boost/units/systems/cgs.hpp>
+#include <boost/units/systems/information.hpp>
+#include <boost/units/systems/si.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+namespace bu = boost::units;
+
+typedef bu::make_scaled_unit<bu::si::length, bu::scale<10, bu::static_rational<-9> > >::type nanometer_unit;
+typedef bu::make_scaled_unit<bu::si::length, bu::scale<10, bu::static_rational<-6> > >::type micrometer_unit;
+typedef bu::make_scaled_unit<bu::si::length, bu::scale<10, bu::static_rational<-3> > >::type millimeter_unit;
+typedef bu::make_scaled_unit<bu::si::length, bu::scale<10, bu::static_rational<3> > >::type kilometer_unit;
+typedef bu::make_scaled_unit<bu::information::info, bu::scale<2, bu::static_rational<10> > >::type kibibyte_unit;
+typedef bu::make_scaled_unit<bu::information::info, bu::scale<10, bu::static_rational<3> > >::type kilobyte_unit;
+
+typedef boost::int64_t integer;
+
+int main()
+{
+    const bu::quantity<bu::si::length, integer> meters = bu::quantity<bu::si::length, integer>::from_value(1234567);
+
+    // multiplying is exact
+    BOOST_TEST_EQ((bu::rescale<millimeter_unit>(meters).value()), 1234567000);
+    BOOST_TEST_EQ((bu::rescale<micrometer_unit>(meters).value()), meters.value() * 1000000);
+
+    // dividing rounds
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit>(meters).value()), 1234);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_to_nearest>(meters).value()), 1235);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_downward>(meters).value()), 1234);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_upward>(meters).value()), 1235);
+    BOOST_TEST_THROWS((bu::rescale<kilometer_unit, bu::round_exact>(meters)), std::domain_error);
+
+    const bu::quantity<bu::si::length, integer> negative = bu::quantity<bu::si::length, integer>::from_value(-1500);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit>(negative).value()), -1);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_to_nearest>(negative).value()), -2);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_downward>(negative).value()), -2);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_upward>(negative).value()), -1);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_to_nearest>(
+        bu::quantity<bu::si::length, integer>::from_value(-1499)).value()), -1);
+
+    // between two scaled units
+    const bu::quantity<micrometer_unit, integer> micrometers = bu::quantity<micrometer_unit, integer>::from_value(2500000);
+    BOOST_TEST_EQ((bu::rescale<millimeter_unit, bu::round_exact>(micrometers).value()), 2500);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_to_nearest>(micrometers).value()), 0);
+
+    // scaled base units: kilograms and grams
+    const bu::quantity<bu::si::mass, integer> kilograms = bu::quantity<bu::si::mass, integer>::from_value(3);
+    BOOST_TEST_EQ((bu::rescale<bu::cgs::mass>(kilograms).value()), 3000);
+    BOOST_TEST_EQ((bu::rescale<bu::si::mass>(bu::quantity<bu::cgs::mass, integer>::from_value(4000)).value()), 4);
+
+    // powers of two and ten together: 1 KiB = 1.024 kB
+    const bu::quantity<kibibyte_unit, integer> kibibytes = bu::quantity<kibibyte_unit, integer>::from_value(125);
+    BOOST_TEST_EQ((bu::rescale<kilobyte_unit, bu::round_exact>(kibibytes).value()), 128);
+    BOOST_TEST_EQ((bu::rescale<kibibyte_unit, bu::round_exact>(bu::quantity<kilobyte_unit, integer>::from_value(128)).value()), 125);
+    BOOST_TEST_EQ((bu::rescale<bu::information::info>(kibibytes).value()), 128000);
+
+    // unsigned values
+    const bu::quantity<bu::si::length, unsigned> unsigned_meters = bu::quantity<bu::si::length, unsigned>::from_value(1500);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_to_nearest>(unsigned_meters).value()), 2u);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_downward>(unsigned_meters).value()), 1u);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_upward>(unsigned_meters).value()), 2u);
+
+    // denominators that do not fit in the value type
+    const bu::quantity<nanometer_unit, boost::int32_t> nanometers = bu::quantity<nanometer_unit, boost::int32_t>::from_value(1000000000);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit>(nanometers).value()), 0);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_to_nearest>(nanometers).value()), 0);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_downward>(nanometers).value()), 0);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_upward>(nanometers).value()), 1);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_upward>(-nanometers).value()), 0);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_downward>(-nanometers).value()), -1);
+    BOOST_TEST_THROWS((bu::rescale<kilometer_unit, bu::round_exact>(nanometers)), std::domain_error);
+    BOOST_TEST_EQ((bu::rescale<kilometer_unit, bu::round_exact>(nanometers * 0).value()), 0);
+    const bu::quantity<nanometer_unit, boost::uint16_t> short_nanometers = bu::quantity<nanometer_unit, boost::uint16_t>::from_value(60000);
+    BOOST_TEST_EQ((bu::rescale<millimeter_unit, bu::round_to_nearest>(short_nanometers).value()), 0);
+    BOOST_TEST_EQ((bu::rescale<millimeter_unit, bu::round_upward>(short_nanometers).value()), 1);
+    const bu::quantity<bu::information::info, boost::int8_t> few_bytes = bu::quantity<bu::information::info, boost::int8_t>::from_value(100);
+    BOOST_TEST_EQ((bu::quantity<kilobyte_unit, boost::int8_t>(few_bytes).value()), 0);
+    BOOST_TEST_EQ((bu::quantity<kilobyte_unit, boost::int8_t>(-few_bytes).value()), 0);
+
+    // overflow
+    const bu::quantity<bu::si::length, boost::int32_t> large = bu::quantity<bu::si::length, boost::int32_t>::from_value(3000000);
+    BOOST_TEST_THROWS((bu::rescale<millimeter_unit, bu::round_toward_zero, bu::checked_overflow>(large)), std::overflow_error);
+    BOOST_TEST_THROWS((bu::rescale<millimeter_unit, bu::round_toward_zero, bu::checked_overflow>(-large)), std::overflow_error);
+    BOOST_TEST_EQ((bu::rescale<millimeter_unit, bu::round_toward_zero, bu::checked_overflow>(-large / 2).value()), -1500000000);
+    const bu::quantity<bu::si::length, boost::int8_t> small = bu::quantity<bu::si::length, boost::int8_t>::from_value(0);
+    BOOST_TEST_EQ((bu::rescale<millimeter_unit, bu::round_toward_zero, bu::checked_overflow>(small).value()), 0);
+    BOOST_TEST_THROWS((bu::rescale<millimeter_unit, bu::round_toward_zero, bu::checked_overflow>(
+        bu::quantity<bu::si::length, boost::int8_t>::from_value(1))), std::overflow_error);
+
+    return boost::report_errors();
+}
@@ -0,0 +1,146 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_runtime_quantity.cpp
+
+\details
+Test arithmetic on runtime_quantity, the packed runtime_dimension, and
+checked conversions to and from quantity.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/units/quantity.hpp>
+#include <boost/units/runtime_quantity.hpp>
+#include <boost/units/runtime_unit_registry.hpp>
+#include <boost/units/systems/cgs.hpp>
+#include <boost/units/systems/si.hpp>
+#include <boost/units/base_units/us/foot.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include "test_close.hpp"
+
+namespace bu = boost::units;
+
+typedef bu::runtime_quantity<double> runtime_quantity;
+
+int main()
+{
+    // exponents survive packing, including negative ones at the limits
+    bu::runtime_dimension d;
+    BOOST_TEST(d.dimensionless());
+    for(std::size_t i = 0; i < bu::runtime_dimension::size; ++i)
+        d.set_exponent(i, static_cast<int>(i % 2 == 0 ? -32 + i : 31 - i));
+    for(std::size_t i = 0; i < bu::runtime_dimension::size; ++i)
+        BOOST_TEST_EQ(d.exponent(i), static_cast<int>(i % 2 == 0 ? -32 + i : 31 - i));
+
+    // products and quotients add and subtract every exponent
+    const bu::runtime_dimension force = bu::make_runtime_dimension<bu::force_dimension>();
+    const bu::runtime_dimension length = bu::make_runtime_dimension<bu::length_dimension>();
+    const bu::runtime_dimension energy = bu::make_runtime_dimension<bu::energy_dimension>();
+    const bu::runtime_dimension velocity = bu::make_runtime_dimension<bu::velocity_dimension>();
+    BOOST_TEST(force * length == energy);
+    BOOST_TEST(energy / length == force);
+    BOOST_TEST(length / length == bu::runtime_dimension());
+    BOOST_TEST(bu::pow(velocity, 2) == bu::make_runtime_dimension<bu::area_dimension>() / bu::pow(bu::make_runtime_dimension<bu::time_dimension>(), 2));
+    BOOST_TEST(bu::root(bu::pow(velocity, 3), 3) == velocity);
+    BOOST_TEST_THROWS(bu::root(velocity, 2), std::domain_error);
+    BOOST_TEST_THROWS(bu::root(velocity, 0), std::domain_error);
+
+    // exponents that leave [-32, 31] throw rather than wrap
+    BOOST_TEST_THROWS(d.set_exponent(0, 32), std::overflow_error);
+    BOOST_TEST_THROWS(d.set_exponent(0, -33), std::overflow_error);
+    BOOST_TEST(bu::pow(length, 31).exponent(0) == 31);
+    BOOST_TEST_THROWS(bu::pow(length, 32), std::overflow_error);
+    BOOST_TEST_THROWS(bu::pow(length, 1 << 30), std::overflow_error);
+    BOOST_TEST(bu::pow(length, -32).exponent(0) == -32);
+    BOOST_TEST_THROWS(bu::pow(length, 31) * length, std::overflow_error);
+    BOOST_TEST_THROWS(bu::pow(length, -32) / length, std::overflow_error);
+    BOOST_TEST((bu::pow(length, 31) / length).exponent(0) == 30);
+    BOOST_TEST((bu::pow(length, -32) * length).exponent(0) == -31);
+
+    // the value and one word
+    BOOST_TEST(sizeof(runtime_quantity) <= 2 * sizeof(double));
+
+    // from a static quantity, in the unit of the reference system
+    const runtime_quantity distance(3.0 * bu::us::foot_base_unit::unit_type());
+    BOOST_UNITS_TEST_CLOSE(distance.value(), 3.0 * 0.3048, 1e-12);
+    BOOST_TEST(distance.dimension() == length);
+
+    const runtime_quantity time(2.0 * bu::si::seconds);
+    const runtime_quantity speed = distance / time;
+    BOOST_TEST(speed.dimension() == velocity);
+    BOOST_UNITS_TEST_CLOSE(speed.value(), 3.0 * 0.3048 / 2.0, 1e-12);
+
+    // back to a static quantity of the same dimension
+    const bu::quantity<bu::cgs::velocity> cgs_speed = speed.as(bu::cgs::centimeter_per_second);
+    BOOST_UNITS_TEST_CLOSE(cgs_speed.value(), 3.0 * 30.48 / 2.0, 1e-12);
+    BOOST_TEST_THROWS(speed.as(bu::si::meter), std::domain_error);
+
+    // with units looked up at runtime
+    const bu::runtime_unit_registry& registry = bu::runtime_unit_registry::builtin();
+    const runtime_quantity work(5.0, *registry.find("erg"));
+    BOOST_TEST(work.dimension() == energy);
+    BOOST_UNITS_TEST_CLOSE(work.value_in(*registry.find("J")), 5.0e-7, 1e-12);
+    BOOST_TEST_THROWS(work.value_in(*registry.find("N")), std::domain_error);
+
+    // addition and ordering require equal dimensions
+    BOOST_UNITS_TEST_CLOSE((distance + distance).value(), 2.0 * distance.value(), 1e-12);
+    BOOST_UNITS_TEST_CLOSE((distance - 0.5 * distance).value(), 0.5 * distance.value(), 1e-12);
+    BOOST_TEST_THROWS(distance + time, std::domain_error);
+    BOOST_TEST_THROWS(distance < time, std::domain_error);
+    BOOST_TEST(distance < 2.0 * distance);
+    BOOST_TEST(distance >= distance);
+    BOOST_TEST(distance != time);
+    BOOST_TEST(-(-distance) == distance);
+
+    // scalars
+    const runtime_quantity frequency = 1.0 / time;
+    BOOST_TEST(frequency.dimension() == bu::make_runtime_dimension<bu::frequency_dimension>());
+    BOOST_UNITS_TEST_CLOSE(frequency.value(), 0.5, 1e-12);
+    BOOST_UNITS_TEST_CLOSE((distance / 3.0).value(), 0.3048, 1e-12);
+
+    // powers and roots
+    const runtime_quantity area = bu::pow(distance, 2);
+    BOOST_TEST(area.dimension() == bu::make_runtime_dimension<bu::area_dimension>());
+    BOOST_UNITS_TEST_CLOSE(bu::root(area, 2).value(), distance.value(), 1e-12);
+    BOOST_TEST_THROWS(bu::root(distance, 2), std::domain_error);
+    BOOST_TEST_THROWS(bu::root(distance, 0), std::domain_error);
+    BOOST_TEST_THROWS(bu::pow(distance, 32), std::overflow_error);
+
+    // integral roots are not truncated to zero
+    const bu::runtime_dimension area_dimension = bu::make_runtime_dimension<bu::area_dimension>();
+    BOOST_TEST_EQ(bu::root(bu::runtime_quantity<int>(16, area_dimension), 2).value(), 4);
+    BOOST_TEST_EQ(bu::root(bu::runtime_quantity<int>(-27, bu::pow(area_dimension, 3)), 3).value(), -3);
+    BOOST_TEST_THROWS(bu::root(bu::runtime_quantity<int>(-16, area_dimension), 2), std::domain_error);
+
+    // a failed multiplication leaves the quantity unchanged
+    runtime_quantity big = bu::pow(distance, 31);
+    BOOST_TEST_THROWS(big *= distance, std::overflow_error);
+    BOOST_TEST(big.dimension() == bu::pow(distance.dimension(), 31));
+    BOOST_UNITS_TEST_CLOSE(big.value(), bu::pow(distance, 31).value(), 1e-12);
+    runtime_quantity small = bu::pow(distance, -32);
+    BOOST_TEST_THROWS(small /= distance, std::overflow_error);
+    BOOST_TEST(small.dimension() == bu::pow(distance.dimension(), -32));
+    BOOST_UNITS_TEST_CLOSE(small.value(), bu::pow(distance, -32).value(), 1e-12);
+
+    std::ostringstream out;
+    out << runtime_quantity(9.5, bu::make_runtime_dimension<bu::acceleration_dimension>());
+    BOOST_TEST_EQ(out.str(), "9.5 m s^-2");
+
+    return boost::report_errors();
+}
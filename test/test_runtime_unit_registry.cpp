@@ -0,0 +1,144 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_runtime_unit_registry.cpp
+
+\details
+Test lookup of runtime units by symbol and name, and that the
+descriptions agree with the compile-time units.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <cmath>
+#include <string>
+
+#include <boost/units/conversion.hpp>
+#include <boost/units/runtime_unit_registry.hpp>
+#include <boost/units/systems/si.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include "test_close.hpp"
+
+#if BOOST_UNITS_HAS_THREADS
+#include <thread>
+#include <vector>
+#endif
+
+
+namespace bu = boost::units;
+
+namespace {
+
+#if BOOST_UNITS_HAS_THREADS
+void first_use(const bu::runtime_unit_registry** result)
+{
+    *result = &bu::runtime_unit_registry::builtin();
+}
+#endif
+
+}
+
+int main()
+{
+#if BOOST_UNITS_HAS_THREADS
+    // threads racing on the first use all see one registry
+    {
+        std::vector<const bu::runtime_unit_registry*> results(8);
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < results.size(); ++i)
+            threads.push_back(std::thread(&first_use, &results[i]));
+        for(std::size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+        for(std::size_t i = 0; i < results.size(); ++i)
+            BOOST_TEST(results[i] == &bu::runtime_unit_registry::builtin());
+    }
+#endif
+
+    const bu::runtime_unit_registry& registry = bu::runtime_unit_registry::builtin();
+
+    // every unit can be found again under its own symbol or name
+    for(bu::runtime_unit_registry::const_iterator it = registry.begin(); it != registry.end(); ++it)
+    {
+        const bu::runtime_unit* by_symbol = registry.find_symbol(it->symbol());
+        const bu::runtime_unit* by_name = registry.find_name(it->name());
+        BOOST_TEST(by_symbol != 0 && by_name != 0);
+        BOOST_TEST(by_symbol == &*it || by_name == &*it);
+    }
+
+    const bu::runtime_unit* meter = registry.find_symbol("m");
+    BOOST_TEST(meter != 0 && meter->name() == "meter");
+    BOOST_TEST(meter->dimension() == bu::make_runtime_dimension<bu::length_dimension>());
+    BOOST_TEST_EQ(meter->scale(), 1.0);
+
+    const bu::runtime_unit* newton = registry.find_name("newton");
+    BOOST_TEST(newton != 0 && newton->symbol() == "N");
+    BOOST_TEST(newton->dimension() == bu::make_runtime_dimension<bu::force_dimension>());
+
+    const bu::runtime_unit* foot = registry.find("ft");
+    BOOST_TEST(foot != 0 && foot == registry.find("foot"));
+    BOOST_UNITS_TEST_CLOSE(foot->scale(), 0.3048, 1e-12);
+    BOOST_TEST(foot->dimension() == meter->dimension());
+    BOOST_TEST(foot->dimension() != newton->dimension());
+
+    // the length of the string is honoured and no terminator is needed
+    const char text[] = "kgm";
+    BOOST_TEST(registry.find_symbol(text, 2) == registry.find_symbol("kg"));
+    BOOST_TEST(registry.find_symbol(text, 1) == 0);
+    BOOST_TEST(registry.find("") == 0);
+    BOOST_TEST(registry.find("parsecs") == 0);
+
+    // symbols shared between systems resolve to the first one inserted
+    BOOST_TEST(registry.find_symbol("C")->name() == "coulomb");
+    BOOST_TEST(registry.find_name("celsius")->symbol() == "C");
+    BOOST_UNITS_TEST_CLOSE(registry.find_symbol("gal")->scale(),
+        bu::conversion_factor(bu::us::gallon_base_unit::unit_type(), bu::si::cubic_meter), 1e-12);
+    BOOST_UNITS_TEST_CLOSE(registry.find_name("gallon (imp.)")->scale(),
+        bu::conversion_factor(bu::imperial::gallon_base_unit::unit_type(), bu::si::cubic_meter), 1e-12);
+
+    // absolute temperatures carry an offset to kelvin
+    const bu::runtime_unit* celsius = registry.find_name("celsius");
+    BOOST_UNITS_TEST_CLOSE(celsius->offset(), 273.15, 1e-12);
+    const bu::runtime_unit* fahrenheit = registry.find_name("fahrenheit");
+    BOOST_UNITS_TEST_CLOSE(32.0 * fahrenheit->scale() + fahrenheit->offset(), 273.15, 1e-12);
+    BOOST_TEST_EQ(registry.find_name("kelvin")->offset(), 0.0);
+
+    // information units use the bit as reference
+    const bu::runtime_unit* byte = registry.find_symbol("B");
+    BOOST_TEST(byte != 0 && byte->name() == "byte");
+    BOOST_TEST_EQ(byte->scale(), 8.0);
+
+    // a registry of its own keeps the first unit for a shared key,
+    // grows past its initial size, and keeps pointers valid
+    bu::runtime_unit_registry custom;
+    BOOST_TEST(custom.empty());
+    BOOST_TEST(custom.insert(bu::si::meter));
+    BOOST_TEST(!custom.insert(bu::si::meter));
+    const bu::runtime_unit* first = custom.find("m");
+    for(int i = 0; i < 200; ++i)
+    {
+        const std::string key = "unit" + std::string(1, static_cast<char>('a' + i % 26)) + std::string(i / 26 + 1, '_');
+        BOOST_TEST(custom.insert(bu::runtime_unit(key, key + "_symbol", bu::runtime_dimension(), i + 1.0)));
+    }
+    BOOST_TEST_EQ(custom.size(), 201u);
+    BOOST_TEST(custom.find("m") == first);
+    for(bu::runtime_unit_registry::const_iterator it = custom.begin(); it != custom.end(); ++it)
+        BOOST_TEST(custom.find_name(it->name()) == &*it);
+    BOOST_TEST(custom.find("unitz_")->dimension().dimensionless());
+
+    // the ratio of two scales is the conversion factor between the units
+    BOOST_UNITS_TEST_CLOSE(registry.find("mi")->scale() / registry.find("yd")->scale(),
+        bu::conversion_factor(bu::us::mile_base_unit::unit_type(), bu::us::yard_base_unit::unit_type()), 1e-12);
+
+    return boost::report_errors();
+}
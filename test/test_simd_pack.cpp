@@ -0,0 +1,143 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_simd_pack.cpp
+
+\details
+Test quantities with a packed simd value type.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <sstream>
+
+#include <boost/units/cmath.hpp>
+#include <boost/units/io.hpp>
+#include <boost/units/pow.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/simd_pack.hpp>
+#include <boost/units/systems/si/area.hpp>
+#include <boost/units/systems/si/length.hpp>
+#include <boost/units/systems/si/plane_angle.hpp>
+#include <boost/units/systems/si/time.hpp>
+#include <boost/units/systems/si/velocity.hpp>
+#include <boost/units/base_units/imperial/foot.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include "test_close.hpp"
+
+namespace bu = boost::units;
+namespace si = boost::units::si;
+
+typedef bu::simd_pack<double, 4> pack;
+typedef bu::simd_pack<float, 4> float_pack;
+
+int main()
+{
+    const double xs[] = { 3.0, 5.0, 8.0, 20.0 };
+    const double ys[] = { 4.0, 12.0, 15.0, 21.0 };
+
+    const bu::quantity<si::length, pack> x = bu::load_quantity<si::length, 4>(si::meters, xs);
+    const bu::quantity<si::length, pack> y = bu::load_quantity<si::length, 4>(si::meters, ys);
+
+    // arithmetic keeps the units
+    const bu::quantity<si::area, pack> a = x * y;
+    for(std::size_t i = 0; i < 4; ++i)
+        BOOST_TEST(bu::lane(a, i) == xs[i] * ys[i] * si::square_meters);
+
+    const bu::quantity<si::length, pack> s = x + y;
+    BOOST_TEST(bu::lane(s, 3) == 41.0 * si::meters);
+    const bu::quantity<si::length, pack> d = 2.0 * x;
+    BOOST_TEST(bu::lane(d, 1) == 10.0 * si::meters);
+
+    // cmath functions dispatch to the lane-wise implementations
+    const bu::quantity<si::length, pack> h = hypot(x, y);
+    const double expected_h[] = { 5.0, 13.0, 17.0, 29.0 };
+    for(std::size_t i = 0; i < 4; ++i)
+        BOOST_UNITS_TEST_CLOSE(bu::lane(h, i).value(), expected_h[i], 1e-12);
+
+    // without overflow or underflow of the squares
+    const bu::quantity<si::length, pack> large = hypot(x * 1e200, y * 1e200);
+    const bu::quantity<si::length, pack> small = hypot(x * 1e-200, y * 1e-200);
+    for(std::size_t i = 0; i < 4; ++i)
+    {
+        BOOST_UNITS_TEST_CLOSE(bu::lane(large, i).value(), expected_h[i] * 1e200, 1e-12);
+        BOOST_UNITS_TEST_CLOSE(bu::lane(small, i).value(), expected_h[i] * 1e-200, 1e-12);
+    }
+
+    const bu::quantity<si::length, pack> r = sqrt(a);
+    BOOST_UNITS_TEST_CLOSE(bu::lane(r, 0).value(), std::sqrt(12.0), 1e-12);
+
+    const bu::quantity<si::area, pack> sq = bu::pow<2>(x);
+    BOOST_TEST(bu::lane(sq, 2) == 64.0 * si::square_meters);
+    const bu::quantity<si::length, pack> rt = bu::root<2>(sq);
+    BOOST_UNITS_TEST_CLOSE(bu::lane(rt, 2).value(), 8.0, 1e-12);
+
+    const bu::quantity<si::area, pack> f = fma(x, y, a);
+    BOOST_TEST(bu::lane(f, 1) == 120.0 * si::square_meters);
+
+    // each lane is rounded as fma of a single quantity is
+    const double e = std::ldexp(1.0, -30);
+    const bu::quantity<si::length, pack> p = bu::quantity<si::length, pack>::from_value(pack(1.0 + e));
+    const bu::quantity<si::area, pack> q = bu::quantity<si::area, pack>::from_value(pack(-(1.0 + 2.0 * e)));
+    const bu::quantity<si::area, pack> fused = fma(p, p, q);
+    const bu::quantity<si::area> single = fma(bu::lane(p, 0), bu::lane(p, 0), bu::lane(q, 0));
+    for(std::size_t i = 0; i < 4; ++i)
+        BOOST_TEST(bu::lane(fused, i).value() == single.value());
+
+    const bu::quantity<si::length, pack> neg = -x;
+    BOOST_TEST(bu::lane(abs(neg), 0) == 3.0 * si::meters);
+
+    // trigonometry
+    const bu::quantity<si::plane_angle, pack> theta = atan2(y, x);
+    for(std::size_t i = 0; i < 4; ++i)
+        BOOST_UNITS_TEST_CLOSE(bu::lane(theta, i).value(), std::atan2(ys[i], xs[i]), 1e-12);
+    const bu::quantity<si::dimensionless, pack> c = cos(theta);
+    BOOST_UNITS_TEST_CLOSE(c.value()[0], 0.6, 1e-12);
+
+    // comparisons yield masks
+    const bu::simd_mask<double, 4> m = x < 6.0 * bu::quantity<si::length, pack>::from_value(pack(1.0));
+    BOOST_TEST(m[0] && m[1] && !m[2] && !m[3]);
+    BOOST_TEST(bu::any_of(m));
+    BOOST_TEST(!bu::all_of(m));
+    BOOST_TEST(bu::all_of(x < y));
+    BOOST_TEST(bu::none_of(x == y));
+
+    const bu::quantity<si::length, pack> chosen = bu::select(m, x, y);
+    BOOST_TEST(bu::lane(chosen, 0) == 3.0 * si::meters);
+    BOOST_TEST(bu::lane(chosen, 3) == 21.0 * si::meters);
+
+    // unit conversion of every lane
+    const bu::quantity<bu::imperial::foot_base_unit::unit_type, pack> feet(x);
+    BOOST_UNITS_TEST_CLOSE(bu::lane(feet, 0).value(), 3.0 / 0.3048, 1e-12);
+
+    // lane-wise value type conversion follows the scalar rules
+    const bu::quantity<si::length, float_pack> xf(x);
+    BOOST_TEST(bu::lane(xf, 2) == 8.0f * si::meters);
+    const bu::quantity<si::length, pack> xd = xf;
+    BOOST_TEST(bu::lane(xd, 2) == 8.0 * si::meters);
+    BOOST_TEST((boost::is_convertible<float_pack, pack>::value));
+    BOOST_TEST((!boost::is_convertible<pack, float_pack>::value));
+
+    double out[4];
+    bu::store_quantity(s, out);
+    BOOST_TEST(out[0] == 7.0);
+
+    std::ostringstream os;
+    os << x;
+    BOOST_TEST(os.str() == "(3 5 8 20) m");
+
+    BOOST_TEST((bu::native_simd_pack<double>::type::size >= 2));
+
+    return boost::report_errors();
+}
@@ -0,0 +1,100 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_span_conversion.cpp
+
+\details
+Test conversion of contiguous ranges of quantities.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <boost/units/convert.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/quantity_array.hpp>
+#include <boost/units/systems/si/length.hpp>
+#include <boost/units/systems/si/temperature.hpp>
+#include <boost/units/base_units/imperial/foot.hpp>
+#include <boost/units/base_units/metric/minute.hpp>
+#include <boost/units/base_units/si/second.hpp>
+#include <boost/units/base_units/temperature/celsius.hpp>
+#include <boost/units/base_units/temperature/fahrenheit.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include "test_close.hpp"
+
+namespace bu = boost::units;
+
+typedef bu::imperial::foot_base_unit::unit_type foot_type;
+typedef bu::temperature::celsius_base_unit::unit_type celsius_type;
+typedef bu::temperature::fahrenheit_base_unit::unit_type fahrenheit_type;
+
+int main()
+{
+    // linear conversion matches the element-wise conversion exactly
+    double feet[] = { 0.0, 1.0, 2.5, -3.0, 1e6 };
+    const std::size_t n = sizeof(feet) / sizeof(feet[0]);
+    double meters[n];
+    bu::convert(bu::make_quantity_span(foot_type(), feet, n),
+                bu::make_quantity_span(bu::si::meters, meters, n));
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        bu::quantity<bu::si::length> expected(bu::quantity<foot_type>::from_value(feet[i]));
+        BOOST_TEST(meters[i] == expected.value());
+    }
+
+    // mixed value types
+    float meters_f[n];
+    bu::convert(bu::make_quantity_span(foot_type(), static_cast<const double*>(feet), n),
+                bu::make_quantity_span(bu::si::meters, meters_f, n));
+    BOOST_TEST(meters_f[1] == static_cast<float>(0.3048));
+
+    // in-place conversion
+    double minutes[] = { 1.0, 2.0 };
+    bu::convert(bu::make_quantity_span(bu::metric::minute_base_unit::unit_type(), minutes, 2),
+                bu::make_quantity_span(bu::si::second_base_unit::unit_type(), minutes, 2));
+    BOOST_TEST(minutes[0] == 60.0);
+    BOOST_TEST(minutes[1] == 120.0);
+
+    // identical units
+    double same[2];
+    bu::convert(bu::make_quantity_span(bu::si::meters, static_cast<const double*>(feet), 2),
+                bu::make_quantity_span(bu::si::meters, same, 2));
+    BOOST_TEST(same[1] == feet[1]);
+
+    // affine conversion of absolute temperatures in both directions
+    bu::quantity_array<bu::absolute<celsius_type> > celsius;
+    celsius.push_back(0.0 * bu::absolute<celsius_type>());
+    celsius.push_back(100.0 * bu::absolute<celsius_type>());
+    celsius.push_back(-40.0 * bu::absolute<celsius_type>());
+    bu::quantity_array<bu::absolute<fahrenheit_type> > fahrenheit;
+    bu::convert(celsius, fahrenheit);
+    BOOST_TEST(fahrenheit.size() == 3u);
+    BOOST_UNITS_TEST_CLOSE(fahrenheit[0].get().value(), 32.0, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(fahrenheit[1].get().value(), 212.0, 1e-12);
+    BOOST_UNITS_TEST_CLOSE(fahrenheit[2].get().value(), -40.0, 1e-12);
+
+    bu::quantity_array<bu::absolute<celsius_type> > back;
+    bu::convert(fahrenheit, back);
+    for(std::size_t i = 0; i < celsius.size(); ++i)
+    {
+        bu::quantity<bu::absolute<celsius_type> > expected(static_cast<bu::quantity<bu::absolute<fahrenheit_type> > >(fahrenheit[i]));
+        BOOST_UNITS_TEST_CLOSE(back[i].get().value(), expected.value(), 1e-12);
+    }
+
+    bu::quantity_array<bu::absolute<bu::si::temperature> > kelvin;
+    bu::convert(celsius, kelvin);
+    BOOST_UNITS_TEST_CLOSE(kelvin[0].get().value(), 273.15, 1e-12);
+
+    return boost::report_errors();
+}
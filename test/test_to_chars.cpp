@@ -0,0 +1,115 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_to_chars.cpp
+
+\details
+Test that to_chars writes the same text as operator<< in every format
+and autoprefix mode, and reports output that does not fit.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <boost/config.hpp>
+
+#ifndef BOOST_NO_CXX11_HDR_SYSTEM_ERROR
+
+#include <sstream>
+#include <string>
+
+#include <boost/units/io.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/systems/si.hpp>
+#include <boost/units/systems/si/io.hpp>
+#include <boost/units/systems/si/prefixes.hpp>
+#include <boost/units/systems/information/byte.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+namespace bu = boost::units;
+
+namespace {
+
+const bu::format_mode formats[] = { bu::symbol_fmt, bu::name_fmt, bu::raw_fmt, bu::typename_fmt };
+const bu::autoprefix_mode prefixes[] = { bu::autoprefix_none, bu::autoprefix_engineering, bu::autoprefix_binary };
+
+// the values, and their prefixed forms, are exact in six digits, so
+// the stream and to_chars agree
+template<class Quantity>
+void check_same_as_stream(const Quantity& q)
+{
+    for(int f = 0; f < 4; ++f)
+    {
+        for(int p = 0; p < 3; ++p)
+        {
+            std::ostringstream expected;
+            bu::set_format(expected, formats[f]);
+            bu::set_autoprefix(expected, prefixes[p]);
+            expected << q;
+
+            char buffer[8192];
+            const bu::to_chars_result result = bu::to_chars(buffer, buffer + sizeof(buffer), q, formats[f], prefixes[p]);
+            BOOST_TEST(result.ec == std::errc());
+            BOOST_TEST_EQ(std::string(buffer, result.ptr), expected.str());
+        }
+    }
+}
+
+}
+
+int main()
+{
+    check_same_as_stream(1536.0 * bu::si::meters);
+    check_same_as_stream(2.048 * bu::si::kilograms);
+    check_same_as_stream(0.25 * bu::si::newtons);
+    check_same_as_stream(-2048.0 * bu::si::meters / bu::si::seconds);
+    check_same_as_stream(512.0 * bu::si::kilo * bu::si::meters);
+    check_same_as_stream(3 * bu::si::joules);
+    check_same_as_stream(8192.0 * bu::information::bytes);
+    check_same_as_stream(0.0 * bu::si::volts);
+
+    // the default is symbols without a prefix
+    char buffer[64];
+    bu::to_chars_result result = bu::to_chars(buffer, buffer + sizeof(buffer), 9.5 * bu::si::meters_per_second_squared);
+    BOOST_TEST(result.ec == std::errc());
+    BOOST_TEST_EQ(std::string(buffer, result.ptr), "9.5 m s^-2");
+
+    // the value round trips
+    result = bu::to_chars(buffer, buffer + sizeof(buffer), 0.1 * bu::si::seconds);
+    BOOST_TEST_EQ(std::string(buffer, result.ptr), "0.1 s");
+    result = bu::to_chars(buffer, buffer + sizeof(buffer), (1.0 / 3.0) * bu::si::seconds);
+    std::istringstream in(std::string(buffer, result.ptr));
+    double value = 0.0;
+    in >> value;
+    BOOST_TEST_EQ(value, 1.0 / 3.0);
+
+    // too small for the value, then for the unit
+    result = bu::to_chars(buffer, buffer + 4, 1234.5 * bu::si::meters);
+    BOOST_TEST(result.ec == std::errc::value_too_large);
+    result = bu::to_chars(buffer, buffer + 7, 1234.5 * bu::si::meters, bu::name_fmt);
+    BOOST_TEST(result.ec == std::errc::value_too_large);
+    BOOST_TEST(result.ptr <= buffer + 7);
+    result = bu::to_chars(buffer, buffer + 8, 1234.5 * bu::si::meters);
+    BOOST_TEST(result.ec == std::errc());
+    BOOST_TEST_EQ(std::string(buffer, result.ptr), "1234.5 m");
+
+    return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
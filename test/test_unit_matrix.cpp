@@ -0,0 +1,143 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_unit_matrix.cpp
+
+\details
+Test matrices with a unit for every row and every column.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <boost/mpl/vector.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/units/operators.hpp>
+#include <boost/units/quantity.hpp>
+#include <boost/units/systems/si.hpp>
+#include <boost/units/unit_matrix.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+namespace bu = boost::units;
+namespace si = boost::units::si;
+namespace mpl = boost::mpl;
+
+typedef bu::divide_typeof_helper<si::dimensionless, si::length>::type     inverse_length;
+typedef bu::divide_typeof_helper<si::dimensionless, si::velocity>::type   inverse_velocity;
+
+// the state of a mass on a spring and its derivative
+typedef bu::unit_matrix<mpl::vector<si::length, si::velocity>, mpl::vector<si::dimensionless> >          state;
+typedef bu::unit_matrix<mpl::vector<si::velocity, si::acceleration>, mpl::vector<si::dimensionless> >    state_derivative;
+// x' = A x
+typedef bu::unit_matrix<mpl::vector<si::velocity, si::acceleration>, mpl::vector<inverse_length, inverse_velocity> > system_matrix;
+
+void test_elements()
+{
+    system_matrix a;
+    BOOST_TEST((boost::is_same<system_matrix::element_unit<0, 0>::type, si::frequency>::value));
+    BOOST_TEST((boost::is_same<system_matrix::element_unit<0, 1>::type, si::dimensionless>::value));
+    BOOST_TEST((boost::is_same<system_matrix::element_unit<1, 1>::type, si::frequency>::value));
+    BOOST_TEST(system_matrix::rows == 2u);
+    BOOST_TEST(system_matrix::columns == 2u);
+
+    a.set<0, 1>(1.0 * si::si_dimensionless);
+    a.set<1, 0>(-4.0 * si::hertz * si::hertz);
+    a.set<1, 1>(-0.5 * si::hertz);
+    BOOST_TEST((a.get<1, 0>() == -4.0 * si::hertz * si::hertz));
+    BOOST_TEST_EQ(a.value(1, 1), -0.5);
+    BOOST_TEST_EQ(a.data()[0], 0.0);
+    BOOST_TEST_EQ(a.data()[2], -4.0);
+
+    const double values[] = { 1.0, 2.0 };
+    const state x(values);
+    BOOST_TEST((x.get<1, 0>() == 2.0 * si::meters_per_second));
+}
+
+void test_state_space()
+{
+    system_matrix a;
+    a.set<0, 1>(1.0 * si::si_dimensionless);
+    a.set<1, 0>(-4.0 * si::hertz * si::hertz);
+    a.set<1, 1>(-0.5 * si::hertz);
+
+    state x;
+    x.set<0, 0>(0.5 * si::meters);
+    x.set<1, 0>(2.0 * si::meters_per_second);
+
+    // the units of the product follow from those of the operands
+    const state_derivative dx = a * x;
+    BOOST_TEST((dx.get<0, 0>() == 2.0 * si::meters_per_second));
+    BOOST_TEST((dx.get<1, 0>() == -3.0 * si::meters_per_second_squared));
+
+    // an Euler step; the scaled derivative has the units of the state
+    const bu::quantity<si::time> dt = 0.25 * si::seconds;
+    const state next = x + dt * (a * x);
+    BOOST_TEST((next.get<0, 0>() == 1.0 * si::meters));
+    BOOST_TEST((next.get<1, 0>() == 1.25 * si::meters_per_second));
+
+    state y(x);
+    y -= x;
+    y += dt * dx;
+    y *= 2.0;
+    BOOST_TEST_EQ(y.value(0, 0), 1.0);
+    BOOST_TEST_EQ(y.value(1, 0), -1.5);
+}
+
+void test_product()
+{
+    typedef mpl::vector<si::dimensionless, si::dimensionless, si::dimensionless> three;
+    typedef mpl::vector<si::length, si::length> two_lengths;
+    typedef mpl::vector<si::time, si::time, si::time, si::time> four_times;
+    typedef mpl::vector<inverse_length, inverse_length, inverse_length, inverse_length> four_inverse_lengths;
+
+    // 3 x 4 by 4 x 2
+    typedef bu::unit_matrix<three, four_times> lhs_type;
+    typedef bu::unit_matrix<four_inverse_lengths, two_lengths> rhs_type;
+    lhs_type lhs;
+    rhs_type rhs;
+    for(std::size_t i = 0; i < 3; ++i)
+        for(std::size_t k = 0; k < 4; ++k)
+            lhs.value(i, k) = static_cast<double>(i + k);
+    for(std::size_t k = 0; k < 4; ++k)
+        for(std::size_t j = 0; j < 2; ++j)
+            rhs.value(k, j) = static_cast<double>(k * 2 + j + 1);
+
+    // the result has rows in s/m and columns in m, which is the same
+    // in every element as dimensionless rows and columns in s
+    typedef bu::unit_matrix<three, mpl::vector<si::time, si::time> > product_type;
+    const product_type product = lhs * rhs;
+    BOOST_TEST((boost::is_same<product_type::element_unit<2, 1>::type, si::time>::value));
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        for(std::size_t j = 0; j < 2; ++j)
+        {
+            double expected = 0.0;
+            for(std::size_t k = 0; k < 4; ++k)
+                expected += static_cast<double>(i + k) * static_cast<double>(k * 2 + j + 1);
+            BOOST_TEST_EQ(product.value(i, j), expected);
+        }
+    }
+
+    // the transpose swaps the units of rows and columns
+    const bu::unit_matrix<mpl::vector<si::time, si::time>, three> t = transpose(product);
+    BOOST_TEST_EQ(t.value(1, 2), product.value(2, 1));
+    BOOST_TEST((t.get<1, 2>() == product.get<2, 1>()));
+}
+
+int main()
+{
+    test_elements();
+    test_state_space();
+    test_product();
+    return boost::report_errors();
+}
@@ -0,0 +1,119 @@
+// Boost.Units - A C++ library for zero-overhead dimensional analysis and
+// unit/quantity manipulation and conversion
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/**
+\file
+
+\brief test_unit_strings.cpp
+
+\details
+Test that the strings of each unit type are built once, and agree
+with what operator<< prints.  Jamfile.v2 also runs it with
+BOOST_NO_CXX11_THREADSAFE_STATICS defined, to cover the locked cache.
+
+Output:
+@verbatim
+@endverbatim
+**/
+
+#include <sstream>
+#include <string>
+
+#include <boost/units/config.hpp>
+#include <boost/units/io.hpp>
+#include <boost/units/unit.hpp>
+#include <boost/units/systems/cgs.hpp>
+#include <boost/units/systems/si.hpp>
+#include <boost/units/systems/si/io.hpp>
+#include <boost/units/systems/si/prefixes.hpp>
+#include <boost/units/base_units/us/foot.hpp>
+
+#include <boost/units/systems/si/energy.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#if BOOST_UNITS_HAS_THREADS
+#include <thread>
+#include <vector>
+#endif
+
+namespace bu = boost::units;
+
+namespace {
+
+template<class Unit>
+void check_same_as_stream()
+{
+    const bu::format_mode formats[] = { bu::symbol_fmt, bu::name_fmt, bu::raw_fmt, bu::typename_fmt };
+    for(int f = 0; f < 4; ++f)
+    {
+        std::ostringstream expected;
+        bu::set_format(expected, formats[f]);
+        expected << Unit();
+        BOOST_TEST_EQ(bu::unit_string<Unit>(formats[f]), expected.str());
+    }
+}
+
+#if BOOST_UNITS_HAS_THREADS
+template<class Unit>
+void first_use(const std::string** result)
+{
+    *result = &bu::unit_symbol<Unit>();
+}
+#endif
+
+}
+
+int main()
+{
+    typedef bu::us::foot_base_unit::unit_type foot;
+    typedef BOOST_TYPEOF(bu::si::kilo * bu::si::meters) kilometer;
+    typedef BOOST_TYPEOF(foot() / bu::si::seconds) foot_per_second;
+
+    check_same_as_stream<bu::si::force>();
+    check_same_as_stream<bu::si::velocity>();
+    check_same_as_stream<bu::si::dimensionless>();
+    check_same_as_stream<bu::cgs::energy>();
+    check_same_as_stream<foot>();
+    check_same_as_stream<kilometer>();
+    check_same_as_stream<foot_per_second>();
+
+    BOOST_TEST_EQ(bu::unit_symbol<bu::si::force>(), "N");
+    BOOST_TEST_EQ(bu::unit_name<bu::si::force>(), "newton");
+    BOOST_TEST_EQ(bu::unit_string<bu::si::force>(bu::raw_fmt), "m kg s^-2");
+    BOOST_TEST_EQ(bu::unit_symbol<bu::si::velocity>(), "m s^-1");
+    BOOST_TEST_EQ(bu::unit_name<kilometer>(), "kilometer");
+    BOOST_TEST_EQ(bu::unit_symbol<foot_per_second>(), "ft s^-1");
+
+    // the same string each time
+    BOOST_TEST(&bu::unit_symbol<bu::si::force>() == &bu::unit_symbol<bu::si::force>());
+    BOOST_TEST(&bu::unit_name<bu::si::force>() == &bu::unit_string<bu::si::force>(bu::name_fmt));
+
+#if BOOST_UNITS_HAS_THREADS
+    // threads racing on the first use of a unit all see one string
+    {
+        typedef bu::si::energy unit_type;
+        std::vector<const std::string*> results(8);
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < results.size(); ++i)
+            threads.push_back(std::thread(&first_use<unit_type>, &results[i]));
+        for(std::size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+        for(std::size_t i = 0; i < results.size(); ++i)
+            BOOST_TEST(results[i] == &bu::unit_symbol<unit_type>());
+        BOOST_TEST_EQ(bu::unit_symbol<unit_type>(), "J");
+    }
+#endif
+
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW) && !defined(BOOST_NO_CXX17_INLINE_VARIABLES)
+    BOOST_TEST(bu::unit_symbol_v<bu::si::force> == "N");
+    BOOST_TEST(bu::unit_name_v<bu::si::velocity> == "meter second^-1");
+    BOOST_TEST(bu::unit_symbol_v<bu::si::force>.data() == bu::unit_symbol<bu::si::force>().data());
+#endif
+
+    return boost::report_errors();
+}